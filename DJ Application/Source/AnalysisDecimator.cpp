@@ -0,0 +1,87 @@
+/*
+  ==============================================================================
+
+    AnalysisDecimator.cpp
+    Created: 23 Oct 2026 10:14:52am
+    Author:  Justin  Lim
+
+  ==============================================================================
+*/
+
+#include "AnalysisDecimator.h"
+
+//==============================================================================
+AnalysisDecimator::AnalysisDecimator (double sampleRate)
+    : decimation (juce::jmax (1, juce::roundToInt (sampleRate / targetRate))),
+      analysisRate (sampleRate / decimation)
+{
+    // Q of each section of an 8th order Butterworth low-pass
+    constexpr double sectionQs[] = { 0.5098, 0.6013, 0.9000, 2.5629 };
+
+    // 80% of the new Nyquist frequency leaves room for the filter to roll off before it
+    auto cutoff = 0.4 * analysisRate;
+
+    for (size_t i = 0; i < lowPass.size(); ++i)
+        lowPass[i].setCoefficients (juce::IIRCoefficients::makeLowPass (sampleRate, cutoff, sectionQs[i]));
+}
+
+
+// Returns the rate of the decimated samples
+double AnalysisDecimator::getAnalysisRate() const
+{
+    return analysisRate;
+}
+
+
+/*
+    Mixes a block to mono, low-passes it and decimates it.
+
+    The filters and the decimation phase carry over between calls, so the
+    track can be fed in blocks of any size.
+
+    @param buffer       Block of the track, one or more channels.
+    @param numSamples   Number of samples of the block to use.
+
+    @return             The decimated samples completed by this block, valid until the next call.
+*/
+const std::vector<float>& AnalysisDecimator::process (const juce::AudioBuffer<float>& buffer, int numSamples)
+{
+    output.clear();
+
+    auto numChannels = buffer.getNumChannels();
+
+    if (numChannels == 0)
+        return output;
+
+    if (numSamples > monoSize)
+    {
+        mono.realloc ((size_t) numSamples);
+        monoSize = numSamples;
+    }
+
+    juce::FloatVectorOperations::copy (mono.get(), buffer.getReadPointer (0), numSamples);
+
+    for (int ch = 1; ch < numChannels; ++ch)
+        juce::FloatVectorOperations::add (mono.get(), buffer.getReadPointer (ch), numSamples);
+
+    if (numChannels > 1)
+        juce::FloatVectorOperations::multiply (mono.get(), 1.0f / static_cast<float> (numChannels), numSamples);
+
+    // At the target rate already there is nothing to alias
+    if (decimation > 1)
+        for (auto& filter : lowPass)
+            filter.processSamples (mono.get(), numSamples);
+
+    output.reserve ((size_t) (numSamples / decimation + 1));
+
+    for (int i = samplesToSkip; i < numSamples; i += decimation)
+        output.push_back (mono[i]);
+
+    // Carry the phase over so the spacing stays even across blocks
+    samplesToSkip = (samplesToSkip - numSamples) % decimation;
+
+    if (samplesToSkip < 0)
+        samplesToSkip += decimation;
+
+    return output;
+}
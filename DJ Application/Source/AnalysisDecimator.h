@@ -0,0 +1,57 @@
+/*
+  ==============================================================================
+
+    AnalysisDecimator.h
+    Created: 23 Oct 2026 10:14:52am
+    Author:  Justin  Lim
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/**
+    Mixes a track to mono and decimates it to about 11 kHz for the spectral analysers.
+
+    Tempo, key, timbre and fingerprint analysis all look at the same band-limited
+    mono signal, so the track is reduced once per block here and the result is
+    shared between them. The mean of the channels is low-passed by an 8th order
+    Butterworth filter just below the new Nyquist frequency, then every Nth
+    sample is kept, so content above 5 kHz does not alias into the bands the
+    analysers look at.
+
+    Feed the track in order with process() and pass the returned samples on.
+*/
+class AnalysisDecimator
+{
+public:
+    /** Rate the audio is decimated towards */
+    static constexpr double targetRate = 11025.0;
+
+    AnalysisDecimator (double sampleRate);
+
+    /** Returns the rate of the decimated samples */
+    double getAnalysisRate() const;
+
+    /** Mixes and decimates the next block, returning the samples it completed */
+    const std::vector<float>& process (const juce::AudioBuffer<float>& buffer, int numSamples);
+
+private:
+    int decimation = 1;
+    double analysisRate = 0.0;
+
+    // Cascade of biquads making up the anti-aliasing filter
+    std::array<juce::IIRFilter, 4> lowPass;
+
+    // Input samples left to skip before the next one is kept
+    int samplesToSkip = 0;
+
+    juce::HeapBlock<float> mono;
+    int monoSize = 0;
+
+    std::vector<float> output;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AnalysisDecimator)
+};
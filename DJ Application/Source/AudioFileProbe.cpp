@@ -0,0 +1,678 @@
+/*
+  ==============================================================================
+
+    AudioFileProbe.cpp
+    Created: 20 Oct 2026 10:12:36am
+    Author:  Justin  Lim
+
+  ==============================================================================
+*/
+
+#include "AudioFileProbe.h"
+
+namespace
+{
+    // Reads a four character chunk or block identifier and compares it
+    bool readId (juce::InputStream& in, const char* expected)
+    {
+        char id[4];
+        return in.read (id, 4) == 4 && std::memcmp (id, expected, 4) == 0;
+    }
+
+    // Reads a fixed-size text field, stopping at the first null byte
+    juce::String readText (juce::InputStream& in, int numBytes)
+    {
+        juce::MemoryBlock block;
+        in.readIntoMemoryBlock (block, juce::jlimit (0, 4096, numBytes));
+
+        auto* text = static_cast<const char*> (block.getData());
+        auto length = std::find (text, text + block.getSize(), '\0') - text;
+
+        return juce::String::fromUTF8 (text, static_cast<int> (length)).trim();
+    }
+
+    // Returns true if every byte of a pattern is found at a position in a block
+    bool matchesAt (const juce::MemoryBlock& block, size_t pos, const char* pattern, size_t patternSize)
+    {
+        return pos + patternSize <= block.getSize()
+            && std::memcmp (static_cast<const char*> (block.getData()) + pos, pattern, patternSize) == 0;
+    }
+
+    // Returns the offset of a pattern in a block, or -1 if it is not found
+    juce::int64 findInBlock (const juce::MemoryBlock& block, const char* pattern, size_t patternSize, bool searchBackwards = false)
+    {
+        if (block.getSize() < patternSize)
+            return -1;
+
+        auto last = block.getSize() - patternSize;
+
+        for (size_t i = 0; i <= last; ++i)
+        {
+            auto pos = searchBackwards ? last - i : i;
+
+            if (matchesAt (block, pos, pattern, patternSize))
+                return static_cast<juce::int64> (pos);
+        }
+
+        return -1;
+    }
+
+    juce::uint32 readUInt32BigEndian (const juce::uint8* p)
+    {
+        return (juce::uint32) p[0] << 24 | (juce::uint32) p[1] << 16 | (juce::uint32) p[2] << 8 | (juce::uint32) p[3];
+    }
+
+    // Converts the 80-bit extended float used for AIFF sample rates
+    double readExtendedFloat (const juce::uint8* bytes)
+    {
+        auto exponent = ((bytes[0] & 0x7f) << 8) | bytes[1];
+        auto mantissa = ((juce::uint64) readUInt32BigEndian (bytes + 2) << 32) | readUInt32BigEndian (bytes + 6);
+
+        if (exponent == 0 && mantissa == 0)
+            return 0.0;
+
+        auto value = std::ldexp (static_cast<double> (mantissa), exponent - 16383 - 63);
+        return (bytes[0] & 0x80) != 0 ? -value : value;
+    }
+
+    // Decodes an ID3v2 text frame body, whose first byte is its text encoding
+    juce::String decodeId3Text (const juce::uint8* data, size_t size)
+    {
+        if (size < 2)
+            return {};
+
+        auto encoding = data[0];
+        ++data;
+        --size;
+
+        if (encoding == 0)  // ISO-8859-1
+        {
+            juce::String text;
+
+            for (size_t i = 0; i < size && data[i] != 0; ++i)
+                text += static_cast<juce::juce_wchar> (data[i]);
+
+            return text.trim();
+        }
+
+        if (encoding == 3)  // UTF-8
+            return juce::String::fromUTF8 (reinterpret_cast<const char*> (data),
+                                           static_cast<int> (std::find (data, data + size, 0) - data)).trim();
+
+        // UTF-16, with a byte order mark (1) or big endian (2)
+        auto bigEndian = encoding == 2;
+
+        if (encoding == 1 && size >= 2)
+        {
+            bigEndian = data[0] == 0xfe && data[1] == 0xff;
+            data += 2;
+            size -= 2;
+        }
+
+        juce::String text;
+
+        for (size_t i = 0; i + 1 < size; i += 2)
+        {
+            auto unit = bigEndian ? (data[i] << 8) | data[i + 1] : data[i] | (data[i + 1] << 8);
+
+            if (unit == 0)
+                break;
+
+            text += static_cast<juce::juce_wchar> (unit);
+        }
+
+        return text.trim();
+    }
+
+    //==============================================================================
+    // MPEG audio frame header fields
+    struct Mp3FrameHeader
+    {
+        bool isMpeg1 = false;
+        int layer = 0;
+        int bitrate = 0;       // bits per second
+        int sampleRate = 0;
+        int samplesPerFrame = 0;
+        int frameLength = 0;   // bytes
+        bool isMono = false;
+    };
+
+    // Parses the 4 byte header at the start of an MPEG audio frame
+    bool parseMp3FrameHeader (const juce::uint8* bytes, Mp3FrameHeader& header)
+    {
+        static const int bitrates[2][3][15] =
+        {
+            { // MPEG 2 and 2.5, layers I, II, III
+                { 0, 32, 48, 56, 64, 80, 96, 112, 128, 144, 160, 176, 192, 224, 256 },
+                { 0, 8, 16, 24, 32, 40, 48, 56, 64, 80, 96, 112, 128, 144, 160 },
+                { 0, 8, 16, 24, 32, 40, 48, 56, 64, 80, 96, 112, 128, 144, 160 }
+            },
+            { // MPEG 1, layers I, II, III
+                { 0, 32, 64, 96, 128, 160, 192, 224, 256, 288, 320, 352, 384, 416, 448 },
+                { 0, 32, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320, 384 },
+                { 0, 32, 40, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320 }
+            }
+        };
+
+        static const int sampleRates[3] = { 44100, 48000, 32000 };
+
+        auto h = readUInt32BigEndian (bytes);
+
+        if ((h & 0xffe00000) != 0xffe00000)
+            return false;
+
+        auto versionBits  = (h >> 19) & 3;   // 0: MPEG 2.5, 1: reserved, 2: MPEG 2, 3: MPEG 1
+        auto layerBits    = (h >> 17) & 3;   // 1: layer III, 2: layer II, 3: layer I
+        auto bitrateIndex = (h >> 12) & 15;
+        auto rateIndex    = (h >> 10) & 3;
+
+        // Free format bitrates carry no length information, leave them to the full reader
+        if (versionBits == 1 || layerBits == 0 || bitrateIndex == 0 || bitrateIndex == 15 || rateIndex == 3)
+            return false;
+
+        header.isMpeg1    = versionBits == 3;
+        header.layer      = 4 - static_cast<int> (layerBits);
+        header.bitrate    = bitrates[header.isMpeg1 ? 1 : 0][header.layer - 1][bitrateIndex] * 1000;
+        header.sampleRate = sampleRates[rateIndex] >> (versionBits == 3 ? 0 : versionBits == 2 ? 1 : 2);
+        header.isMono     = ((h >> 6) & 3) == 3;
+
+        auto padding = static_cast<int> ((h >> 9) & 1);
+
+        if (header.layer == 1)
+        {
+            header.samplesPerFrame = 384;
+            header.frameLength = (12 * header.bitrate / header.sampleRate + padding) * 4;
+        }
+        else
+        {
+            header.samplesPerFrame = (header.layer == 3 && ! header.isMpeg1) ? 576 : 1152;
+            header.frameLength = header.samplesPerFrame / 8 * header.bitrate / header.sampleRate + padding;
+        }
+
+        return header.frameLength > 4;
+    }
+}
+
+//==============================================================================
+// Probes a file by its extension
+bool AudioFileProbe::probe (const juce::File& file, Result& result)
+{
+    juce::FileInputStream fileStream (file);
+
+    if (! fileStream.openedOk())
+        return false;
+
+    juce::BufferedInputStream in (fileStream, 8192);
+    auto extension = file.getFileExtension().toLowerCase();
+
+    auto probed = false;
+
+    if (extension == ".wav" || extension == ".bwf")
+        probed = probeWav (in, result);
+    else if (extension == ".aif" || extension == ".aiff")
+        probed = probeAiff (in, result);
+    else if (extension == ".flac")
+        probed = probeFlac (in, result);
+    else if (extension == ".ogg")
+        probed = probeOgg (in, result);
+    else if (extension == ".mp3")
+        probed = probeMp3 (in, result);
+
+    return probed && result.sampleRate > 0.0 && result.lengthInSamples > 0;
+}
+
+
+// RIFF chunks: "fmt " gives the sample rate and frame size, "data" the length and "LIST"/"INFO" the tags
+bool AudioFileProbe::probeWav (juce::InputStream& in, Result& result)
+{
+    if (! readId (in, "RIFF"))
+        return false;
+
+    in.readInt();
+
+    if (! readId (in, "WAVE"))
+        return false;
+
+    auto totalLength = in.getTotalLength();
+    int blockAlign = 0;
+    juce::int64 dataSize = -1;
+
+    while (in.getPosition() + 8 <= totalLength)
+    {
+        char id[4];
+        in.read (id, 4);
+
+        auto size = static_cast<juce::uint32> (in.readInt());
+        auto start = in.getPosition();
+        auto next = start + size + (size & 1);
+
+        if (std::memcmp (id, "fmt ", 4) == 0)
+        {
+            in.readShort();   // format tag
+            in.readShort();   // channels
+            result.sampleRate = static_cast<juce::uint32> (in.readInt());
+            in.readInt();     // byte rate
+            blockAlign = static_cast<juce::uint16> (in.readShort());
+        }
+        else if (std::memcmp (id, "data", 4) == 0)
+        {
+            // Streamed files leave the size empty, in which case the data runs to the end of the file
+            dataSize = (size == 0 || size == 0xffffffff || start + size > totalLength) ? totalLength - start
+                                                                                        : static_cast<juce::int64> (size);
+        }
+        else if (std::memcmp (id, "LIST", 4) == 0 && readId (in, "INFO"))
+        {
+            while (in.getPosition() + 8 <= next)
+            {
+                char field[4];
+                in.read (field, 4);
+
+                auto fieldSize = in.readInt();
+                auto fieldNext = in.getPosition() + fieldSize + (fieldSize & 1);
+
+                if (std::memcmp (field, "INAM", 4) == 0)       result.title  = readText (in, fieldSize);
+                else if (std::memcmp (field, "IART", 4) == 0)  result.artist = readText (in, fieldSize);
+                else if (std::memcmp (field, "IPRD", 4) == 0)  result.album  = readText (in, fieldSize);
+
+                if (fieldSize < 0 || ! in.setPosition (fieldNext))
+                    break;
+            }
+        }
+
+        if (! in.setPosition (next))
+            break;
+    }
+
+    if (blockAlign <= 0 || dataSize < 0)
+        return false;
+
+    result.lengthInSamples = dataSize / blockAlign;
+    return true;
+}
+
+
+// Big endian IFF chunks: "COMM" holds the frame count and an 80-bit sample rate
+bool AudioFileProbe::probeAiff (juce::InputStream& in, Result& result)
+{
+    if (! readId (in, "FORM"))
+        return false;
+
+    in.readIntBigEndian();
+
+    char formType[4];
+
+    if (in.read (formType, 4) != 4 || (std::memcmp (formType, "AIFF", 4) != 0 && std::memcmp (formType, "AIFC", 4) != 0))
+        return false;
+
+    auto totalLength = in.getTotalLength();
+    auto foundCommon = false;
+
+    while (in.getPosition() + 8 <= totalLength)
+    {
+        char id[4];
+        in.read (id, 4);
+
+        auto size = static_cast<juce::uint32> (in.readIntBigEndian());
+        auto next = in.getPosition() + size + (size & 1);
+
+        if (std::memcmp (id, "COMM", 4) == 0)
+        {
+            juce::uint8 sampleRate[10];
+
+            in.readShortBigEndian();   // channels
+            result.lengthInSamples = static_cast<juce::uint32> (in.readIntBigEndian());
+            in.readShortBigEndian();   // bits per sample
+            in.read (sampleRate, 10);
+
+            result.sampleRate = readExtendedFloat (sampleRate);
+            foundCommon = true;
+        }
+        else if (std::memcmp (id, "NAME", 4) == 0)
+        {
+            result.title = readText (in, static_cast<int> (size));
+        }
+        else if (std::memcmp (id, "AUTH", 4) == 0)
+        {
+            result.artist = readText (in, static_cast<int> (size));
+        }
+
+        if (! in.setPosition (next))
+            break;
+    }
+
+    return foundCommon;
+}
+
+
+// Metadata blocks: STREAMINFO holds the sample rate and total samples, VORBIS_COMMENT the tags
+bool AudioFileProbe::probeFlac (juce::InputStream& in, Result& result)
+{
+    if (! readId (in, "fLaC"))
+        return false;
+
+    auto foundStreamInfo = false;
+
+    for (;;)
+    {
+        juce::uint8 blockHeader[4];
+
+        if (in.read (blockHeader, 4) != 4)
+            break;
+
+        auto isLastBlock = (blockHeader[0] & 0x80) != 0;
+        auto blockType = blockHeader[0] & 0x7f;
+        auto blockSize = (blockHeader[1] << 16) | (blockHeader[2] << 8) | blockHeader[3];
+        auto next = in.getPosition() + blockSize;
+
+        if (blockType == 0 && blockSize >= 18)
+        {
+            juce::uint8 info[18];
+            in.read (info, 18);
+
+            // 20 bits sample rate, 3 bits channels, 5 bits sample size, 36 bits total samples
+            auto packed = ((juce::uint64) readUInt32BigEndian (info + 10) << 32) | readUInt32BigEndian (info + 14);
+
+            result.sampleRate      = static_cast<double> (packed >> 44);
+            result.lengthInSamples = static_cast<juce::int64> (packed & 0xfffffffffULL);
+            foundStreamInfo = true;
+        }
+        else if (blockType == 4)
+        {
+            juce::MemoryBlock comment;
+            in.readIntoMemoryBlock (comment, blockSize);
+            readVorbisComment (comment.getData(), comment.getSize(), result);
+        }
+
+        if (isLastBlock || ! in.setPosition (next))
+            break;
+    }
+
+    // A zero sample count means the encoder did not know the length
+    return foundStreamInfo && result.lengthInSamples > 0;
+}
+
+
+// The identification header gives the sample rate, the granule position of the last page the length
+bool AudioFileProbe::probeOgg (juce::InputStream& in, Result& result)
+{
+    constexpr size_t scanSize = 65536;
+
+    juce::MemoryBlock head;
+    in.readIntoMemoryBlock (head, scanSize);
+
+    if (! matchesAt (head, 0, "OggS", 4))
+        return false;
+
+    auto identification = findInBlock (head, "\x01vorbis", 7);
+
+    if (identification < 0 || static_cast<size_t> (identification) + 16 > head.getSize())
+        return false;
+
+    auto* bytes = static_cast<const juce::uint8*> (head.getData()) + identification + 7;
+    result.sampleRate = juce::ByteOrder::littleEndianInt (bytes + 5);
+
+    // The comment header normally sits in the second page, well inside the first block
+    auto comment = findInBlock (head, "\x03vorbis", 7);
+
+    if (comment >= 0)
+        readVorbisComment (static_cast<const char*> (head.getData()) + comment + 7,
+                           head.getSize() - static_cast<size_t> (comment) - 7, result);
+
+    juce::MemoryBlock tail;
+    in.setPosition (juce::jmax<juce::int64> (0, in.getTotalLength() - static_cast<juce::int64> (scanSize)));
+    in.readIntoMemoryBlock (tail, scanSize);
+
+    auto lastPage = findInBlock (tail, "OggS", 4, true);
+
+    if (lastPage < 0 || static_cast<size_t> (lastPage) + 14 > tail.getSize())
+        return false;
+
+    auto granule = static_cast<juce::int64> (juce::ByteOrder::littleEndianInt64 (static_cast<const char*> (tail.getData()) + lastPage + 6));
+
+    result.lengthInSamples = granule;
+    return granule > 0;
+}
+
+
+// Reads ID3 tags, then the first frame's Xing/Info or VBRI header, or derives the length from a constant bitrate
+bool AudioFileProbe::probeMp3 (juce::InputStream& in, Result& result)
+{
+    auto totalLength = in.getTotalLength();
+    juce::int64 audioStart = 0;
+
+    juce::uint8 id3Header[10];
+
+    if (in.read (id3Header, 10) == 10 && std::memcmp (id3Header, "ID3", 3) == 0)
+    {
+        // Synchsafe size: 7 bits per byte
+        auto tagSize = (id3Header[6] << 21) | (id3Header[7] << 14) | (id3Header[8] << 7) | id3Header[9];
+        auto hasFooter = (id3Header[5] & 0x10) != 0;
+
+        audioStart = 10 + tagSize + (hasFooter ? 10 : 0);
+        readId3v2Tags (in, id3Header[3], 10 + tagSize, result);
+    }
+
+    // Find the first frame whose successor also starts with a valid header
+    constexpr size_t scanSize = 65536;
+
+    juce::MemoryBlock block;
+    in.setPosition (audioStart);
+    in.readIntoMemoryBlock (block, scanSize);
+
+    auto* bytes = static_cast<const juce::uint8*> (block.getData());
+    Mp3FrameHeader header;
+    juce::int64 frameStart = -1;
+
+    for (size_t i = 0; i + 4 <= block.getSize(); ++i)
+    {
+        if (bytes[i] != 0xff || ! parseMp3FrameHeader (bytes + i, header))
+            continue;
+
+        Mp3FrameHeader nextHeader;
+        auto nextFrame = i + static_cast<size_t> (header.frameLength);
+
+        if (nextFrame + 4 > block.getSize() || parseMp3FrameHeader (bytes + nextFrame, nextHeader))
+        {
+            frameStart = static_cast<juce::int64> (i);
+            break;
+        }
+    }
+
+    if (frameStart < 0)
+        return false;
+
+    result.sampleRate = header.sampleRate;
+
+    auto* frame = bytes + frameStart;
+    auto frameBytesAvailable = block.getSize() - static_cast<size_t> (frameStart);
+
+    // Layer III side info sits between the header and the Xing/Info tag
+    auto xingOffset = 4 + (header.isMpeg1 ? (header.isMono ? 17 : 32) : (header.isMono ? 9 : 17));
+    juce::int64 numFrames = 0;
+
+    if (header.layer == 3 && static_cast<size_t> (xingOffset) + 12 <= frameBytesAvailable
+         && (std::memcmp (frame + xingOffset, "Xing", 4) == 0 || std::memcmp (frame + xingOffset, "Info", 4) == 0))
+    {
+        auto flags = readUInt32BigEndian (frame + xingOffset + 4);
+
+        if ((flags & 1) != 0)
+            numFrames = readUInt32BigEndian (frame + xingOffset + 8);
+    }
+    else if (36 + 18 <= frameBytesAvailable && std::memcmp (frame + 36, "VBRI", 4) == 0)
+    {
+        numFrames = readUInt32BigEndian (frame + 36 + 14);
+    }
+
+    // A trailing ID3v1 tag is the last 128 bytes of the file
+    char id3v1Header[3] = {};
+    auto hasId3v1 = totalLength >= 128 && in.setPosition (totalLength - 128)
+                     && in.read (id3v1Header, 3) == 3 && std::memcmp (id3v1Header, "TAG", 3) == 0;
+
+    if (numFrames > 0)
+    {
+        result.lengthInSamples = numFrames * header.samplesPerFrame;
+    }
+    else
+    {
+        // Constant bitrate: the audio bytes divided by the byte rate
+        auto audioBytes = totalLength - (audioStart + frameStart) - (hasId3v1 ? 128 : 0);
+        result.lengthInSamples = static_cast<juce::int64> (audioBytes * 8.0 / header.bitrate * header.sampleRate);
+    }
+
+    // Fall back to the ID3v1 tag for files without ID3v2 text frames
+    if (hasId3v1 && result.title.isEmpty())
+    {
+        in.setPosition (totalLength - 125);
+        result.title  = readText (in, 30);
+        result.artist = readText (in, 30);
+        result.album  = readText (in, 30);
+    }
+
+    return true;
+}
+
+
+/*
+    Reads the title, artist and album text frames of an ID3v2 tag.
+
+    @param in             Stream positioned just after the 10 byte tag header.
+    @param majorVersion   2, 3 or 4; version 2 uses 3 character frame ids.
+    @param tagEnd         Stream position of the end of the tag.
+    @param result         Receives the tags that were found.
+*/
+void AudioFileProbe::readId3v2Tags (juce::InputStream& in, int majorVersion, juce::int64 tagEnd, Result& result)
+{
+    auto isVersion2 = majorVersion == 2;
+    auto headerSize = isVersion2 ? 6 : 10;
+
+    while (in.getPosition() + headerSize <= tagEnd)
+    {
+        juce::uint8 frameHeader[10];
+        in.read (frameHeader, headerSize);
+
+        // Padding after the last frame
+        if (frameHeader[0] == 0)
+            break;
+
+        juce::String id (reinterpret_cast<const char*> (frameHeader), isVersion2 ? 3 : 4);
+        int frameSize = 0;
+
+        if (isVersion2)
+            frameSize = (frameHeader[3] << 16) | (frameHeader[4] << 8) | frameHeader[5];
+        else if (majorVersion == 4)
+            frameSize = (frameHeader[4] << 21) | (frameHeader[5] << 14) | (frameHeader[6] << 7) | frameHeader[7];
+        else
+            frameSize = static_cast<int> (readUInt32BigEndian (frameHeader + 4));
+
+        auto next = in.getPosition() + frameSize;
+
+        if (frameSize <= 0 || next > tagEnd)
+            break;
+
+        juce::String* field = nullptr;
+
+        if (id == "TIT2" || id == "TT2")       field = &result.title;
+        else if (id == "TPE1" || id == "TP1")  field = &result.artist;
+        else if (id == "TALB" || id == "TAL")  field = &result.album;
+
+        // Artwork and other frames are skipped without being read
+        if (field != nullptr && frameSize <= 4096)
+        {
+            juce::MemoryBlock text;
+            in.readIntoMemoryBlock (text, frameSize);
+            *field = decodeId3Text (static_cast<const juce::uint8*> (text.getData()), text.getSize());
+        }
+
+        if (! in.setPosition (next))
+            break;
+    }
+}
+
+
+// Reads the fields of a Vorbis comment block: a vendor string then KEY=value pairs, all with 32-bit little endian lengths
+void AudioFileProbe::readVorbisComment (const void* data, size_t size, Result& result)
+{
+    juce::MemoryInputStream in (data, size, false);
+
+    auto vendorLength = static_cast<juce::uint32> (in.readInt());
+
+    if (vendorLength > size || ! in.setPosition (in.getPosition() + vendorLength))
+        return;
+
+    auto numComments = static_cast<juce::uint32> (in.readInt());
+
+    for (juce::uint32 i = 0; i < numComments && ! in.isExhausted(); ++i)
+    {
+        auto length = static_cast<juce::uint32> (in.readInt());
+
+        if (length > static_cast<juce::uint32> (in.getNumBytesRemaining()))
+            break;
+
+        juce::MemoryBlock block;
+        in.readIntoMemoryBlock (block, static_cast<juce::ssize_t> (length));
+
+        auto comment = juce::String::fromUTF8 (static_cast<const char*> (block.getData()), static_cast<int> (block.getSize()));
+        auto key = comment.upToFirstOccurrenceOf ("=", false, false).toUpperCase();
+        auto value = comment.fromFirstOccurrenceOf ("=", false, false).trim();
+
+        if (key == "TITLE")        result.title  = value;
+        else if (key == "ARTIST")  result.artist = value;
+        else if (key == "ALBUM")   result.album  = value;
+    }
+}
+
+
+/*
+    Prints, per file extension, the time taken to probe headers and to open a full reader.
+    Run it twice to compare with a warm file cache.
+
+    @param formatManager   The format manager used to open the full readers.
+    @param folder          The folder whose audio files are timed, searched recursively.
+*/
+void AudioFileProbe::runBenchmark (juce::AudioFormatManager& formatManager, const juce::File& folder)
+{
+    struct Timing
+    {
+        int numFiles = 0;
+        int numProbed = 0;
+        double probeMs = 0.0;
+        double readerMs = 0.0;
+    };
+
+    std::map<juce::String, Timing> timings;
+
+    for (const auto& entry : juce::RangedDirectoryIterator (folder, true, formatManager.getWildcardForAllFormats(), juce::File::findFiles))
+    {
+        auto file = entry.getFile();
+        auto& timing = timings[file.getFileExtension().toLowerCase()];
+        ++timing.numFiles;
+
+        Result result;
+        auto start = juce::Time::getMillisecondCounterHiRes();
+
+        if (probe (file, result))
+            ++timing.numProbed;
+
+        timing.probeMs += juce::Time::getMillisecondCounterHiRes() - start;
+
+        start = juce::Time::getMillisecondCounterHiRes();
+        std::unique_ptr<juce::AudioFormatReader> reader (formatManager.createReaderFor (file));
+        timing.readerMs += juce::Time::getMillisecondCounterHiRes() - start;
+    }
+
+    std::cout << "format    files   probed   probe ms/file   reader ms/file   speed-up" << std::endl;
+
+    for (auto& [extension, timing] : timings)
+    {
+        auto probeAverage = timing.probeMs / timing.numFiles;
+        auto readerAverage = timing.readerMs / timing.numFiles;
+
+        std::cout << extension.paddedRight (' ', 10)
+                  << juce::String (timing.numFiles).paddedLeft (' ', 5)
+                  << juce::String (timing.numProbed).paddedLeft (' ', 9)
+                  << juce::String (probeAverage, 3).paddedLeft (' ', 16)
+                  << juce::String (readerAverage, 3).paddedLeft (' ', 17)
+                  << juce::String (probeAverage > 0.0 ? readerAverage / probeAverage : 0.0, 1).paddedLeft (' ', 10) << "x"
+                  << std::endl;
+    }
+}
@@ -0,0 +1,56 @@
+/*
+  ==============================================================================
+
+    AudioFileProbe.h
+    Created: 20 Oct 2026 10:12:36am
+    Author:  Justin  Lim
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/**
+    Reads the duration, sample rate and tags of an audio file from its headers only.
+
+    WAV and AIFF come from their chunk headers, FLAC from STREAMINFO and its Vorbis
+    comment, Ogg Vorbis from its identification header and the granule position of
+    the last page, and MP3 from its Xing/Info or VBRI frame (or the bitrate of a CBR
+    file) plus ID3 tags. Nothing is decoded, so a file costs a few small reads.
+    Callers fall back to a full AudioFormatReader when probe() returns false.
+*/
+class AudioFileProbe
+{
+public:
+    struct Result
+    {
+        double sampleRate = 0.0;
+        juce::int64 lengthInSamples = 0;
+        juce::String title;
+        juce::String artist;
+        juce::String album;
+    };
+
+    /** Probes a file by its extension, returns false if the format is not handled or the headers are not usable */
+    static bool probe (const juce::File& file, Result& result);
+
+    /** Times header probing against opening a full reader for every audio file below a folder, per format */
+    static void runBenchmark (juce::AudioFormatManager& formatManager, const juce::File& folder);
+
+private:
+    static bool probeWav  (juce::InputStream& in, Result& result);
+    static bool probeAiff (juce::InputStream& in, Result& result);
+    static bool probeFlac (juce::InputStream& in, Result& result);
+    static bool probeOgg  (juce::InputStream& in, Result& result);
+    static bool probeMp3  (juce::InputStream& in, Result& result);
+
+    /** Reads the text frames of an ID3v2 tag whose 10 byte header has already been read */
+    static void readId3v2Tags (juce::InputStream& in, int majorVersion, juce::int64 tagEnd, Result& result);
+
+    /** Reads the fields of a Vorbis comment block, as used by FLAC and Ogg Vorbis */
+    static void readVorbisComment (const void* data, size_t size, Result& result);
+
+    AudioFileProbe() = delete;
+};
@@ -0,0 +1,396 @@
+/*
+  ==============================================================================
+
+    AutoMixer.cpp
+    Created: 22 Oct 2026 2:37:52pm
+    Author:  Justin  Lim
+
+  ==============================================================================
+*/
+
+#include "AutoMixer.h"
+
+namespace
+{
+    // A song counts as audible from the first 50 ms window above -40 dBFS to the last one
+    constexpr double levelWindowSeconds = 0.05;
+    constexpr float audibleLevel = 0.01f;
+
+    // How far ahead of the output a song is started when it cannot follow on from the one before
+    constexpr double startMarginSeconds = 0.05;
+}
+
+//==============================================================================
+AutoMixer::AutoMixer (TrackPreloader& preloaderToUse)
+    : juce::Thread ("Automix"),
+      preloader (preloaderToUse)
+{
+}
+
+AutoMixer::~AutoMixer()
+{
+    cancelPendingUpdate();
+    stop();
+}
+
+
+void AutoMixer::prepareToPlay (int samplesPerBlockExpected, double sampleRate)
+{
+    deviceSampleRate = sampleRate;
+
+    const juce::SpinLock::ScopedLockType sl (scheduleLock);
+    voiceBuffer.setSize (2, juce::jmax (1, samplesPerBlockExpected));
+    gains.resize ((size_t) voiceBuffer.getNumSamples());
+}
+
+
+/*
+    Mixes the scheduled songs into the block.
+
+    The block is rendered in stretches no longer than the scratch buffers, so a
+    device that delivers bigger blocks than it announced never makes this allocate.
+    Nothing here waits for another thread: if stop() is clearing the schedule, the
+    block is left silent.
+*/
+void AutoMixer::getNextAudioBlock (const juce::AudioSourceChannelInfo& bufferToFill)
+{
+    bufferToFill.clearActiveBufferRegion();
+
+    auto firstSample = outputSample.load();
+    outputSample += bufferToFill.numSamples;
+
+    const juce::SpinLock::ScopedTryLockType tryLock (scheduleLock);
+
+    if (! tryLock.isLocked() || ! isRunning || voiceBuffer.getNumSamples() == 0)
+        return;
+
+    for (int done = 0; done < bufferToFill.numSamples;)
+    {
+        auto numSamples = juce::jmin (bufferToFill.numSamples - done, voiceBuffer.getNumSamples());
+        auto stretchStart = firstSample + done;
+
+        // The song playing and the one after it, which may already be fading in
+        int start1, size1, start2, size2;
+        fifo.prepareToRead (2, start1, size1, start2, size2);
+
+        std::array<int, 2> slots { start1, size1 > 1 ? start1 + 1 : start2 };
+        auto numActive = size1 + size2;
+        auto frontHasEnded = false;
+
+        for (int i = 0; i < numActive; ++i)
+        {
+            auto& segment = schedule[(size_t) slots[(size_t) i]];
+            auto hasEnded = renderSegment (segment, voices[(size_t) slots[(size_t) i]], *bufferToFill.buffer,
+                                           bufferToFill.startSample + done, stretchStart, numSamples);
+
+            if (i == 0)
+                frontHasEnded = hasEnded;
+
+            if (segment.startSample < stretchStart + numSamples)
+                currentSongIndex = segment.playlistIndex;
+        }
+
+        // The thread refills the slot, so the song's memory is freed there rather than here
+        if (frontHasEnded)
+        {
+            voices[(size_t) start1].hasStarted = false;
+            fifo.finishedRead (1);
+        }
+
+        done += numSamples;
+    }
+}
+
+
+void AutoMixer::releaseResources()
+{
+}
+
+
+/*
+    Adds a segment's part of a stretch of output to the buffer.
+
+    The song is resampled to the output rate and shaped by equal-power curves,
+    sin rising over its fade in and cos falling over its fade out, so the summed
+    power stays level through a crossfade.
+
+    @param segment           The song and where it sits on the output clock.
+    @param voice             The audio thread's read position in the song.
+    @param buffer            Buffer to add the song to.
+    @param startInBuffer     Where the stretch starts in the buffer.
+    @param firstSample       Output sample the stretch starts on.
+    @param numSamples        Length of the stretch, at most the size of the scratch buffers.
+
+    @return                  True once the segment has played to its end.
+*/
+bool AutoMixer::renderSegment (const Segment& segment, Voice& voice, juce::AudioBuffer<float>& buffer,
+                               int startInBuffer, juce::int64 firstSample, int numSamples)
+{
+    auto stretchEnd = firstSample + numSamples;
+
+    if (segment.startSample >= stretchEnd)
+        return false;
+
+    if (firstSample >= segment.endSample || segment.track == nullptr)
+        return true;
+
+    auto& audio = segment.track -> audio;
+
+    if (! voice.hasStarted)
+    {
+        voice.hasStarted = true;
+        voice.sourcePosition = segment.sourceStart;
+
+        for (auto& interpolator : voice.interpolators)
+            interpolator.reset();
+    }
+
+    auto numAvailable = audio.getNumSamples() - voice.sourcePosition;
+
+    if (numAvailable <= 0)
+        return true;
+
+    auto offset = static_cast<int> (juce::jmax<juce::int64> (0, segment.startSample - firstSample));
+    auto numToRender = static_cast<int> (juce::jmin (stretchEnd, segment.endSample) - firstSample) - offset;
+    auto fadeOutLength = static_cast<double> (segment.endSample - segment.fadeOutSample);
+
+    for (int i = 0; i < numToRender; ++i)
+    {
+        auto sample = firstSample + offset + i;
+        auto gain = 1.0;
+
+        if (sample < segment.startSample + segment.fadeInLength)
+            gain = std::sin (juce::MathConstants<double>::halfPi * (double) (sample - segment.startSample) / segment.fadeInLength);
+        else if (sample >= segment.fadeOutSample)
+            gain = std::cos (juce::MathConstants<double>::halfPi * (double) (sample - segment.fadeOutSample) / fadeOutLength);
+
+        gains[(size_t) i] = static_cast<float> (gain);
+    }
+
+    auto numUsed = 0;
+
+    for (int ch = 0; ch < juce::jmin (2, buffer.getNumChannels()); ++ch)
+    {
+        auto sourceChannel = juce::jmin (ch, audio.getNumChannels() - 1);
+
+        numUsed = voice.interpolators[(size_t) ch].process (segment.ratio, audio.getReadPointer (sourceChannel, voice.sourcePosition),
+                                                            voiceBuffer.getWritePointer (ch), numToRender, numAvailable, 0);
+
+        juce::FloatVectorOperations::addWithMultiply (buffer.getWritePointer (ch, startInBuffer + offset),
+                                                      voiceBuffer.getReadPointer (ch), gains.data(), numToRender);
+    }
+
+    voice.sourcePosition += numUsed;
+
+    return stretchEnd >= segment.endSample || voice.sourcePosition >= audio.getNumSamples();
+}
+
+
+//==============================================================================
+// Starts mixing through the songs in order
+void AutoMixer::start (const juce::Array<juce::File>& playlist)
+{
+    stop();
+
+    songs = playlist;
+    nextSongIndex = 0;
+    numFailedSongs = 0;
+    lastFadeOutSample = 0;
+    lastFadeLength = 0;
+
+    if (songs.isEmpty())
+        return;
+
+    isRunning = true;
+    startThread();
+}
+
+
+// Stops mixing and empties the schedule, the audio thread skips blocks while it is being cleared
+void AutoMixer::stop()
+{
+    isRunning = false;
+    stopThread (10000);
+
+    const juce::SpinLock::ScopedLockType sl (scheduleLock);
+
+    fifo.reset();
+
+    for (auto& segment : schedule)
+        segment = {};
+
+    for (auto& voice : voices)
+        voice.hasStarted = false;
+
+    currentSongIndex = -1;
+}
+
+
+// Returns true while a playlist is being mixed
+bool AutoMixer::isMixing() const
+{
+    return isRunning.load();
+}
+
+
+// Set the length of the crossfades that have not been scheduled yet
+void AutoMixer::setCrossfadeLength (double seconds)
+{
+    crossfadeSeconds = juce::jmax (0.0, seconds);
+}
+
+
+// Returns the position in the playlist of the song playing
+int AutoMixer::getCurrentSongIndex() const
+{
+    return currentSongIndex.load();
+}
+
+
+// Keeps the schedule full, giving up once every song in the playlist has failed to decode in a row
+void AutoMixer::run()
+{
+    while (! threadShouldExit())
+    {
+        if (deviceSampleRate.load() <= 0.0 || fifo.getFreeSpace() == 0)
+        {
+            wait (50);
+            continue;
+        }
+
+        if (scheduleNextSong())
+        {
+            numFailedSongs = 0;
+        }
+        else if (! threadShouldExit() && ++numFailedSongs >= songs.size())
+        {
+            isRunning = false;
+            triggerAsyncUpdate();
+            return;
+        }
+    }
+}
+
+
+// Reports that mixing stopped, unless it was started again in the meantime
+void AutoMixer::handleAsyncUpdate()
+{
+    if (! isRunning && onMixingStopped != nullptr)
+        onMixingStopped();
+}
+
+
+/*
+    Decodes the next song and lays it out after the last one scheduled.
+
+    The song starts on the output sample where the song before it starts fading
+    out, and fades in over the same length. If the song before has already passed
+    that point, because decoding fell behind, the song starts just ahead of the
+    output instead.
+
+    @return              False if the song could not be read or does not fit in the memory budget.
+*/
+bool AutoMixer::scheduleNextSong()
+{
+    auto index = nextSongIndex;
+    nextSongIndex = (nextSongIndex + 1) % songs.size();
+
+    auto track = preloader.decode (songs[index], [this] { return threadShouldExit(); });
+
+    if (track == nullptr || track -> sampleRate <= 0.0)
+        return false;
+
+    auto rate = deviceSampleRate.load();
+    auto points = findMixPoints (*track, juce::roundToInt (crossfadeSeconds.load() * track -> sampleRate));
+
+    Segment segment;
+    segment.playlistIndex = index;
+    segment.ratio = track -> sampleRate / rate;
+    segment.sourceStart = points.start;
+
+    auto earliestStart = outputSample.load() + juce::roundToInt (rate * startMarginSeconds);
+
+    if (fifo.getNumReady() > 0 && lastFadeOutSample >= earliestStart)
+    {
+        segment.startSample = lastFadeOutSample;
+        segment.fadeInLength = lastFadeLength;
+    }
+    else
+    {
+        segment.startSample = earliestStart;
+    }
+
+    segment.fadeOutSample = segment.startSample + static_cast<juce::int64> ((points.fadeOutStart - points.start) / segment.ratio);
+    segment.endSample     = segment.startSample + static_cast<juce::int64> ((points.end - points.start) / segment.ratio);
+    segment.fadeInLength  = static_cast<int> (juce::jmin<juce::int64> (segment.fadeInLength, segment.fadeOutSample - segment.startSample));
+    segment.track         = std::move (track);
+
+    lastFadeOutSample = segment.fadeOutSample;
+    lastFadeLength = static_cast<int> (segment.endSample - segment.fadeOutSample);
+
+    // The slot is free, so the audio thread is not reading it, and the song it held is released here
+    int start1, size1, start2, size2;
+    fifo.prepareToWrite (1, start1, size1, start2, size2);
+
+    if (size1 == 0)
+        return false;
+
+    schedule[(size_t) start1] = std::move (segment);
+    fifo.finishedWrite (1);
+
+    return true;
+}
+
+
+/*
+    Finds where a song becomes audible and where its fade out should start.
+
+    Leading and trailing silence is skipped, so songs follow each other without
+    gaps, and the fade out ends where the song stops being audible. A song too
+    short for the full fade gets a third of its length.
+
+    @param track         The decoded song.
+    @param fadeLength    Length of the fade out, in the song's samples.
+
+    @return              The mix points, in the song's samples.
+*/
+AutoMixer::MixPoints AutoMixer::findMixPoints (const PreloadedTrack& track, int fadeLength)
+{
+    auto& audio = track.audio;
+    auto numSamples = audio.getNumSamples();
+    auto windowLength = juce::jmax (1, juce::roundToInt (track.sampleRate * levelWindowSeconds));
+
+    auto isAudible = [&audio, numSamples, windowLength] (int start)
+    {
+        auto length = juce::jmin (windowLength, numSamples - start);
+
+        for (int ch = 0; ch < audio.getNumChannels(); ++ch)
+            if (audio.getRMSLevel (ch, start, length) >= audibleLevel)
+                return true;
+
+        return false;
+    };
+
+    MixPoints points { 0, numSamples, numSamples };
+
+    for (int start = 0; start < numSamples; start += windowLength)
+    {
+        if (isAudible (start))
+        {
+            points.start = start;
+            break;
+        }
+    }
+
+    for (int start = (numSamples - 1) / windowLength * windowLength; start >= points.start; start -= windowLength)
+    {
+        if (isAudible (start))
+        {
+            points.end = juce::jmin (numSamples, start + windowLength);
+            break;
+        }
+    }
+
+    points.fadeOutStart = points.end - juce::jmin (fadeLength, (points.end - points.start) / 3);
+    return points;
+}
@@ -0,0 +1,141 @@
+/*
+  ==============================================================================
+
+    AutoMixer.h
+    Created: 22 Oct 2026 2:37:52pm
+    Author:  Justin  Lim
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "TrackPreloader.h"
+
+/**
+    Plays through a playlist unattended, crossfading from each song into the next.
+
+    A background thread decodes the upcoming songs, finds where each one becomes
+    audible and where it fades out, and lays them out on the output's sample clock.
+    Each song starts on the exact sample its predecessor starts fading out, and the
+    two are mixed with equal-power gain curves. The schedule is handed to the audio
+    thread through a lock-free FIFO a song ahead, so mixing carries on
+    without the message thread, whatever it is busy with. Only the songs in the
+    schedule are held in memory, decoded by the track preloader within its budget.
+
+    The playlist loops back to its first song after the last. If every song in it
+    fails to decode in a row, mixing stops and onMixingStopped is called.
+*/
+class AutoMixer : public juce::AudioSource,
+                  private juce::Thread,
+                  private juce::AsyncUpdater
+{
+public:
+    AutoMixer (TrackPreloader& preloaderToUse);
+    ~AutoMixer() override;
+
+    //==============================================================================
+    void prepareToPlay (int samplesPerBlockExpected, double sampleRate) override;
+    void getNextAudioBlock (const juce::AudioSourceChannelInfo& bufferToFill) override;
+    void releaseResources() override;
+
+    //==============================================================================
+    /** Starts mixing through the songs in order, replacing any playlist that is playing */
+    void start (const juce::Array<juce::File>& playlist);
+
+    /** Stops mixing straight away */
+    void stop();
+
+    /** Returns true while a playlist is being mixed */
+    bool isMixing() const;
+
+    /** Set the length of the crossfades that have not been scheduled yet */
+    void setCrossfadeLength (double seconds);
+
+    /** Returns the position in the playlist of the song playing, or the song fading in during a crossfade, -1 if none */
+    int getCurrentSongIndex() const;
+
+    /** Called on the message thread when mixing stops because no song in the playlist could be played */
+    std::function<void()> onMixingStopped;
+
+private:
+    /** Where a song is played from, in its own samples */
+    struct MixPoints
+    {
+        int start = 0;          // first audible sample
+        int fadeOutStart = 0;   // where the fade into the next song starts
+        int end = 0;            // last audible sample
+    };
+
+    /** A song laid out on the output's sample clock */
+    struct Segment
+    {
+        std::shared_ptr<PreloadedTrack> track;
+        int playlistIndex = 0;
+        double ratio = 1.0;                 // song samples per output sample
+        int sourceStart = 0;                // first song sample played
+        juce::int64 startSample = 0;        // output sample the song starts on
+        juce::int64 fadeOutSample = 0;      // output sample its fade out starts on, where the next song starts
+        juce::int64 endSample = 0;          // output sample after its last
+        int fadeInLength = 0;               // in output samples
+    };
+
+    /** Audio thread state of a segment being played */
+    struct Voice
+    {
+        bool hasStarted = false;
+        int sourcePosition = 0;
+        std::array<juce::LagrangeInterpolator, 2> interpolators;
+    };
+
+    void run() override;
+
+    // Tells the owner that the thread gave up
+    void handleAsyncUpdate() override;
+
+    // Decodes the next song of the playlist and appends it to the schedule, returns false if it could not be used
+    bool scheduleNextSong();
+
+    // Finds where a song becomes audible and where its fade out should start
+    static MixPoints findMixPoints (const PreloadedTrack& track, int fadeLength);
+
+    // Adds a segment's part of a stretch of output to the buffer, returns true once the segment has ended
+    bool renderSegment (const Segment& segment, Voice& voice, juce::AudioBuffer<float>& buffer,
+                        int startInBuffer, juce::int64 firstSample, int numSamples);
+
+    // Slots in the schedule, the FIFO keeps one of them empty, which leaves room for the song playing and the next one
+    static constexpr int scheduleSize = 3;
+
+    // Decodes the songs, so they share the memory budget of the decks' preloaded tracks
+    TrackPreloader& preloader;
+
+    // Songs to play, only touched while the thread is stopped or by the thread
+    juce::Array<juce::File> songs;
+    int nextSongIndex = 0;
+    int numFailedSongs = 0;
+
+    // Schedule, written by the thread and read by the audio thread
+    juce::AbstractFifo fifo { scheduleSize };
+    std::array<Segment, scheduleSize> schedule;
+    std::array<Voice, scheduleSize> voices;
+
+    // Held by the audio thread while it reads the schedule and by stop() while it clears it
+    juce::SpinLock scheduleLock;
+
+    std::atomic<bool> isRunning { false };
+    std::atomic<double> crossfadeSeconds { 8.0 };
+    std::atomic<double> deviceSampleRate { 0.0 };
+    std::atomic<juce::int64> outputSample { 0 };
+    std::atomic<int> currentSongIndex { -1 };
+
+    // Output samples of the fade out of the last song scheduled, which the next song fades in over
+    juce::int64 lastFadeOutSample = 0;
+    int lastFadeLength = 0;
+
+    // Audio thread scratch space, sized in prepareToPlay
+    juce::AudioBuffer<float> voiceBuffer;
+    std::vector<float> gains;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AutoMixer)
+};
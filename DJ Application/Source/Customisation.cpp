@@ -1,158 +1,231 @@
-/*
-  ==============================================================================
-
-    Customisation.cpp
-    Created: 4 Mar 2024 7:37:18pm
-    Author:  Justin  Lim
-
-  ==============================================================================
-*/
-
-// Start of Added Code file "Customisation", everything in the code below is added on top of starter code
-#include "Customisation.h"
-
-// Customisation linear sliders
-void Customisation::drawLinearSlider(juce::Graphics &g, int x, int y, int width, int height, float sliderPos, float minSliderPos, float maxSliderPos, const juce::Slider::SliderStyle style, juce::Slider &slider)
-{
-    // Set the colour (slider background)
-    g.fillAll (slider.findColour (juce::Slider::backgroundColourId));
-    
-    // Set the colour (slider indictaor)
-    g.setColour (offWhite);
-    
-    juce::Path p;
-    
-    // Draw the indicators on the slider
-    for (int i = 0; i < 10; i++) {
-        p.addRectangle(x + 10, y + 20 * i, width - 20, 1);
-        g.fillPath(p);
-    }
-    
-    // Draw the remaining components of the slider
-    drawLinearSliderBackground (g, x, y, width, height, sliderPos, minSliderPos, maxSliderPos, style, slider);
-    drawLinearSliderThumb      (g, x, y, width, height, sliderPos, minSliderPos, maxSliderPos, style, slider);
-}
-
-
-// Customisation linear slider thmb
-void Customisation::drawLinearSliderThumb(juce::Graphics& g, int x, int y, int width, int height,
-                                              float sliderPos, float minSliderPos, float maxSliderPos,
-                                              const juce::Slider::SliderStyle style, juce::Slider& slider)
-{
-    auto sliderRadius = (float) getSliderThumbRadius (slider);
-
-    bool isDownOrDragging = slider.isEnabled() && (slider.isMouseOverOrDragging() || slider.isMouseButtonDown());
-
-    auto knobColour = slider.findColour (juce::Slider::thumbColourId)
-                            .withMultipliedSaturation ((slider.hasKeyboardFocus (false) || isDownOrDragging) ? 1.3f : 0.9f)
-                            .withMultipliedAlpha (slider.isEnabled() ? 1.0f : 0.7f);
-
-    g.setColour(knobColour);
-    
-
-    float kx, ky;
-
-    kx = (float) x + (float) width * 0.5f;
-    ky = sliderPos;
-    g.fillRect (juce::Rectangle<float> (kx - sliderRadius, ky - 2.5f, sliderRadius * 2.0f, 15.0f));
-    
-    g.setColour (offWhite);
-    g.fillRect  (juce::Rectangle<float> (kx - sliderRadius, ky + 5.0f, sliderRadius * 2.0f, 1.0f));
-}
-
-
-// Draw a custom look and feel for any linear slider background
-void Customisation::drawLinearSliderBackground(juce::Graphics& g, int x, int y, int width, int height,
-                                                    float /*sliderPos*/,
-                                                    float /*minSliderPos*/,
-                                                    float /*maxSliderPos*/,
-                                                    const juce::Slider::SliderStyle /*style*/, juce::Slider& slider)
-{
-    auto sliderRadius = (float) getSliderThumbRadius(slider) - 5.0f;
-    juce::Path on, off;
-
-    // Draws the slider that is below thumb
-    if (slider.isHorizontal())
-    {
-        auto iy = (float) y + (float) height * 0.5f - sliderRadius * 0.5f;
-        juce::Rectangle<float> r((float) x - sliderRadius * 0.5f, iy, (float) width + sliderRadius, sliderRadius);
-        auto onW = r.getWidth() * ((float) slider.valueToProportionOfLength(slider.getValue()));
-
-        on.addRectangle(r.removeFromLeft(onW));
-        off.addRectangle(r);
-    }
-    else
-    {
-        auto ix = (float) x + (float) width * 0.5f - sliderRadius * 0.5f;
-        juce::Rectangle<float> r(ix, (float) y - sliderRadius * 0.5f, sliderRadius, (float) height + sliderRadius);
-        auto onH = r.getHeight() * ((float) slider.valueToProportionOfLength(slider.getValue()));
-
-        on.addRectangle(r.removeFromBottom(onH));
-        off.addRectangle(r);
-    }
-
-    // Set the slider path below the thumb to be orange
-    g.setColour(orange);
-    g.fillPath(on);
-
-    // Set the slider path above the thumb to be grey
-    g.setColour(grey);
-    g.fillPath(off);
-}
-
-
-
-/*
-    Draws a customized button background with enhanced aesthetics.
-
-    @param g                    The graphics context for drawing.
-    @param button               The button to customize.
-    @param backgroundColour     The base background colour of the button.
-    @param isMouseOverButton    Indicates whether the mouse is over the button.
-    @param isButtonDown         Indicates whether the button is currently pressed.
-*/
-void Customisation::drawButtonBackground(juce::Graphics& g, juce::Button& button, const juce::Colour& backgroundColour,
-                                        bool isMouseOverButton, bool isButtonDown)
-{
-    auto baseColour = button.findColour(juce::TextButton::buttonColourId)
-        .withMultipliedSaturation(button.hasKeyboardFocus(true) ? 1.3f : 0.9f)
-        .withMultipliedAlpha(button.isEnabled() ? 0.9f : 0.5f);
-
-    if (isButtonDown || isMouseOverButton)
-        baseColour = baseColour.contrasting(isButtonDown ? 0.2f : 0.1f);
-
-    auto flatOnLeft = button.isConnectedOnLeft();
-    auto flatOnRight = button.isConnectedOnRight();
-    auto flatOnTop = button.isConnectedOnTop();
-    auto flatOnBottom = button.isConnectedOnBottom();
-
-    auto width = static_cast<float>(button.getWidth()) - 1.0f;
-    auto height = static_cast<float>(button.getHeight()) - 1.0f;
-
-    if (width > 0 && height > 0)
-    {
-        auto cornerSize = fmin(15.0f, fmin(width, height) * 0.45f);
-        auto lineThickness = cornerSize * 0.1f;
-        auto halfThickness = lineThickness * 0.5f;
-
-        juce::Path outline;
-        outline.addRoundedRectangle(0.5f + halfThickness, 0.5f + halfThickness, width - lineThickness, height - lineThickness,
-                                    cornerSize, cornerSize,
-                                    !(flatOnLeft || flatOnTop),
-                                    !(flatOnRight || flatOnTop),
-                                    !(flatOnLeft || flatOnBottom),
-                                    !(flatOnRight || flatOnBottom));
-
-        auto outlineColour = button.findColour(button.getToggleState() ? juce::TextButton::textColourOnId
-            : juce::TextButton::textColourOffId);
-
-        g.setColour(baseColour);
-        g.fillPath(outline);
-
-        if (!button.getToggleState())
-        {
-            g.setColour(outlineColour);
-        }
-    }
-}
-
+/*
+  ==============================================================================
+
+    Customisation.cpp
+    Created: 4 Mar 2024 7:37:18pm
+    Author:  Justin  Lim
+
+  ==============================================================================
+*/
+
+// Start of Added Code file "Customisation", everything in the code below is added on top of starter code
+#include "Customisation.h"
+
+// Customisation linear sliders
+void Customisation::drawLinearSlider(juce::Graphics &g, int x, int y, int width, int height, float sliderPos, float minSliderPos, float maxSliderPos, const juce::Slider::SliderStyle style, juce::Slider &slider)
+{
+    FrameProfiler::ScopedSection section ("Customisation::drawLinearSlider");
+    
+    auto backgroundColour = slider.findColour (juce::Slider::backgroundColourId);
+    
+    // The background and indicators only change with the slider's size, so they are drawn once and blitted
+    drawSkin (g, { SkinKey::sliderTrack, slider.getLocalBounds(), { x, y, width, height }, backgroundColour.getARGB() },
+              [&] (juce::Graphics& skin)
+    {
+        // Set the colour (slider background)
+        skin.fillAll (backgroundColour);
+        
+        // Set the colour (slider indictaor)
+        skin.setColour (offWhite);
+        
+        juce::Path p;
+        
+        // Draw the indicators on the slider, filled together once they are all added
+        for (int i = 0; i < 10; i++)
+            p.addRectangle (x + 10, y + 20 * i, width - 20, 1);
+        
+        skin.fillPath (p);
+    });
+    
+    // Draw the remaining components of the slider
+    drawLinearSliderBackground (g, x, y, width, height, sliderPos, minSliderPos, maxSliderPos, style, slider);
+    drawLinearSliderThumb      (g, x, y, width, height, sliderPos, minSliderPos, maxSliderPos, style, slider);
+}
+
+
+// Customisation linear slider thmb
+void Customisation::drawLinearSliderThumb(juce::Graphics& g, int x, int y, int width, int height,
+                                              float sliderPos, float minSliderPos, float maxSliderPos,
+                                              const juce::Slider::SliderStyle style, juce::Slider& slider)
+{
+    auto sliderRadius = (float) getSliderThumbRadius (slider);
+
+    bool isDownOrDragging = slider.isEnabled() && (slider.isMouseOverOrDragging() || slider.isMouseButtonDown());
+
+    auto knobColour = slider.findColour (juce::Slider::thumbColourId)
+                            .withMultipliedSaturation ((slider.hasKeyboardFocus (false) || isDownOrDragging) ? 1.3f : 0.9f)
+                            .withMultipliedAlpha (slider.isEnabled() ? 1.0f : 0.7f);
+
+    g.setColour(knobColour);
+    
+
+    float kx, ky;
+
+    kx = (float) x + (float) width * 0.5f;
+    ky = sliderPos;
+    g.fillRect (juce::Rectangle<float> (kx - sliderRadius, ky - 2.5f, sliderRadius * 2.0f, 15.0f));
+    
+    g.setColour (offWhite);
+    g.fillRect  (juce::Rectangle<float> (kx - sliderRadius, ky + 5.0f, sliderRadius * 2.0f, 1.0f));
+}
+
+
+// Draw a custom look and feel for any linear slider background
+void Customisation::drawLinearSliderBackground(juce::Graphics& g, int x, int y, int width, int height,
+                                                    float /*sliderPos*/,
+                                                    float /*minSliderPos*/,
+                                                    float /*maxSliderPos*/,
+                                                    const juce::Slider::SliderStyle /*style*/, juce::Slider& slider)
+{
+    auto sliderRadius = (float) getSliderThumbRadius(slider) - 5.0f;
+    juce::Rectangle<float> on, off;
+
+    // Draws the slider that is below thumb
+    if (slider.isHorizontal())
+    {
+        auto iy = (float) y + (float) height * 0.5f - sliderRadius * 0.5f;
+        juce::Rectangle<float> r((float) x - sliderRadius * 0.5f, iy, (float) width + sliderRadius, sliderRadius);
+        auto onW = r.getWidth() * ((float) slider.valueToProportionOfLength(slider.getValue()));
+
+        on = r.removeFromLeft(onW);
+        off = r;
+    }
+    else
+    {
+        auto ix = (float) x + (float) width * 0.5f - sliderRadius * 0.5f;
+        juce::Rectangle<float> r(ix, (float) y - sliderRadius * 0.5f, sliderRadius, (float) height + sliderRadius);
+        auto onH = r.getHeight() * ((float) slider.valueToProportionOfLength(slider.getValue()));
+
+        on = r.removeFromBottom(onH);
+        off = r;
+    }
+
+    // Set the slider below the thumb to be orange, plain rectangles fill without building a path
+    g.setColour(orange);
+    g.fillRect(on);
+
+    // Set the slider above the thumb to be grey
+    g.setColour(grey);
+    g.fillRect(off);
+}
+
+
+
+/*
+    Draws a customized button background with enhanced aesthetics.
+
+    @param g                    The graphics context for drawing.
+    @param button               The button to customize.
+    @param backgroundColour     The base background colour of the button.
+    @param isMouseOverButton    Indicates whether the mouse is over the button.
+    @param isButtonDown         Indicates whether the button is currently pressed.
+*/
+void Customisation::drawButtonBackground(juce::Graphics& g, juce::Button& button, const juce::Colour& backgroundColour,
+                                        bool isMouseOverButton, bool isButtonDown)
+{
+    FrameProfiler::ScopedSection section ("Customisation::drawButtonBackground");
+
+    auto baseColour = button.findColour(juce::TextButton::buttonColourId)
+        .withMultipliedSaturation(button.hasKeyboardFocus(true) ? 1.3f : 0.9f)
+        .withMultipliedAlpha(button.isEnabled() ? 0.9f : 0.5f);
+
+    if (isButtonDown || isMouseOverButton)
+        baseColour = baseColour.contrasting(isButtonDown ? 0.2f : 0.1f);
+
+    auto flatOnLeft = button.isConnectedOnLeft();
+    auto flatOnRight = button.isConnectedOnRight();
+    auto flatOnTop = button.isConnectedOnTop();
+    auto flatOnBottom = button.isConnectedOnBottom();
+
+    auto width = static_cast<float>(button.getWidth()) - 1.0f;
+    auto height = static_cast<float>(button.getHeight()) - 1.0f;
+
+    if (width > 0 && height > 0)
+    {
+        auto flags = (flatOnLeft ? 1 : 0) | (flatOnRight ? 2 : 0) | (flatOnTop ? 4 : 0) | (flatOnBottom ? 8 : 0);
+
+        // One skin per size, colour and set of connected edges, so hovering and pressing only swap images
+        drawSkin (g, { SkinKey::buttonBackground, button.getLocalBounds(), {}, baseColour.getARGB(), flags },
+                  [&] (juce::Graphics& skin)
+        {
+            auto cornerSize = fmin(15.0f, fmin(width, height) * 0.45f);
+            auto lineThickness = cornerSize * 0.1f;
+            auto halfThickness = lineThickness * 0.5f;
+
+            juce::Path outline;
+            outline.addRoundedRectangle(0.5f + halfThickness, 0.5f + halfThickness, width - lineThickness, height - lineThickness,
+                                        cornerSize, cornerSize,
+                                        !(flatOnLeft || flatOnTop),
+                                        !(flatOnRight || flatOnTop),
+                                        !(flatOnLeft || flatOnBottom),
+                                        !(flatOnRight || flatOnBottom));
+
+            skin.setColour(baseColour);
+            skin.fillPath(outline);
+        });
+    }
+}
+
+
+// Draws a button-styled action cell with the same rounded outline as drawButtonBackground
+void Customisation::drawTableActionCell (juce::Graphics& g, juce::Rectangle<float> area, const juce::String& text,
+                                         const juce::Colour& backgroundColour)
+{
+    FrameProfiler::ScopedSection section ("Customisation::drawTableActionCell");
+    
+    auto cell = area.getSmallestIntegerContainer();
+    
+    if (area.reduced (0.5f).isEmpty())
+        return;
+    
+    // The cell and its laid out text are rendered once per size, colour and label, every row after that is a blit
+    drawSkin (g, { SkinKey::actionCell, cell, {}, backgroundColour.getARGB(), 0, text }, [&] (juce::Graphics& skin)
+    {
+        auto bounds = area.reduced (0.5f);
+        auto cornerSize = fmin (15.0f, fmin (bounds.getWidth(), bounds.getHeight()) * 0.45f);
+        auto lineThickness = cornerSize * 0.1f;
+        
+        skin.setColour (backgroundColour.withMultipliedSaturation (0.9f).withMultipliedAlpha (0.9f));
+        skin.fillRoundedRectangle (bounds.reduced (lineThickness * 0.5f), cornerSize);
+        
+        skin.setColour (juce::Colours::white);
+        skin.setFont (juce::jmin (15.0f, bounds.getHeight() * 0.6f));
+        skin.drawText (text, bounds, juce::Justification::centred, false);
+    });
+}
+
+
+// Returns the Verdana font at a height, built the first time any Customisation asks for it
+juce::Font Customisation::getFont (float height, bool bold)
+{
+    auto key = std::make_pair (juce::roundToInt (height * 100.0f), bold);
+    auto& fonts = skinCache -> fonts;
+    auto existing = fonts.find (key);
+    
+    if (existing == fonts.end())
+        existing = fonts.emplace (key, juce::Font ("Verdana", height, bold ? juce::Font::bold : juce::Font::plain)).first;
+    
+    return existing -> second;
+}
+
+
+// Skins are equal when everything that shows in their image is
+bool Customisation::SkinKey::operator== (const SkinKey& other) const
+{
+    return kind == other.kind && bounds == other.bounds && inner == other.inner && colour == other.colour
+        && flags == other.flags && scale == other.scale && text == other.text;
+}
+
+
+// Combines the fields of a skin key into one hash
+size_t Customisation::SkinKeyHash::operator() (const SkinKey& key) const
+{
+    size_t hash = (size_t) key.text.hashCode64();
+    
+    for (auto value : { (int) key.kind, key.bounds.getX(), key.bounds.getY(), key.bounds.getWidth(), key.bounds.getHeight(),
+                        key.inner.getX(), key.inner.getY(), key.inner.getWidth(), key.inner.getHeight(),
+                        (int) key.colour, key.flags, key.scale })
+        hash = hash * 31 + (size_t) (juce::uint32) value;
+    
+    return hash;
+}
@@ -1,78 +1,160 @@
-/*
-  ==============================================================================
-
-    Customisation.h
-    Created: 4 Mar 2024 7:37:18pm
-    Author:  Justin  Lim
-
-  ==============================================================================
-*/
-
-// Start of Added Code file "Customisation", everything in the code below is added on top of starter code
-#pragma once
-
-#include <JuceHeader.h>
-
-class Customisation :   public juce::LookAndFeel_V4
-{
-public:
-    Customisation(){};
-    ~Customisation(){};
-    
-    /** Customisation linear sliders */
-    void drawLinearSlider (juce::Graphics& g,
-                           int       x,
-                           int       y,
-                           int       width,
-                           int       height,
-                           float     sliderPos,
-                           float     minSliderPos,
-                           float     maxSliderPos,
-                           const     juce::Slider::SliderStyle,
-                           juce::Slider&   slider
-                           ) override;
-    
-    /** Customisation linear slider thmb */
-    void drawLinearSliderThumb (juce::Graphics& g,
-                                int       x,
-                                int       y,
-                                int       width,
-                                int       height,
-                                float     sliderPos,
-                                float     minSliderPos,
-                                float     maxSliderPos,
-                                const     juce::Slider::SliderStyle style,
-                                juce::Slider&   slider
-                                ) override;
-    
-    /** Customisation linear slider background */
-    void drawLinearSliderBackground (juce::Graphics& g,
-                                     int       x,
-                                     int       y,
-                                     int       width,
-                                     int       height,
-                                     float     /*sliderPos*/,
-                                     float     /*minSliderPos*/,
-                                     float     /*maxSliderPos*/,
-                                     const     juce::Slider::SliderStyle /*style*/,
-                                     juce::Slider&   slider
-                                     ) override;
-    
-    /** Customisation any button background */
-    void drawButtonBackground (juce::Graphics& g,
-                               juce::Button&   button,
-                               const     juce::Colour& backgroundColour,
-                               bool      isMouseOverButton,
-                               bool      isButtonDown
-                               ) override;
-
-private:
-    //==============================================================================
-    // Colours
-    juce::Colour offWhite  = juce::Colour::fromFloatRGBA (0.83f, 0.84f, 0.9f,  1.0f);
-    juce::Colour grey      = juce::Colour::fromFloatRGBA (0.42f, 0.42f, 0.42f, 1.0f);
-    juce::Colour orange    = juce::Colour(255, 165, 0);
-
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Customisation);
-};
-// End of Added Code
+/*
+  ==============================================================================
+
+    Customisation.h
+    Created: 4 Mar 2024 7:37:18pm
+    Author:  Justin  Lim
+
+  ==============================================================================
+*/
+
+// Start of Added Code file "Customisation", everything in the code below is added on top of starter code
+#pragma once
+
+#include <JuceHeader.h>
+#include "FrameProfiler.h"
+
+class Customisation :   public juce::LookAndFeel_V4
+{
+public:
+    Customisation(){};
+    ~Customisation(){};
+    
+    /** Customisation linear sliders */
+    void drawLinearSlider (juce::Graphics& g,
+                           int       x,
+                           int       y,
+                           int       width,
+                           int       height,
+                           float     sliderPos,
+                           float     minSliderPos,
+                           float     maxSliderPos,
+                           const     juce::Slider::SliderStyle,
+                           juce::Slider&   slider
+                           ) override;
+    
+    /** Customisation linear slider thmb */
+    void drawLinearSliderThumb (juce::Graphics& g,
+                                int       x,
+                                int       y,
+                                int       width,
+                                int       height,
+                                float     sliderPos,
+                                float     minSliderPos,
+                                float     maxSliderPos,
+                                const     juce::Slider::SliderStyle style,
+                                juce::Slider&   slider
+                                ) override;
+    
+    /** Customisation linear slider background */
+    void drawLinearSliderBackground (juce::Graphics& g,
+                                     int       x,
+                                     int       y,
+                                     int       width,
+                                     int       height,
+                                     float     /*sliderPos*/,
+                                     float     /*minSliderPos*/,
+                                     float     /*maxSliderPos*/,
+                                     const     juce::Slider::SliderStyle /*style*/,
+                                     juce::Slider&   slider
+                                     ) override;
+    
+    /** Customisation any button background */
+    void drawButtonBackground (juce::Graphics& g,
+                               juce::Button&   button,
+                               const     juce::Colour& backgroundColour,
+                               bool      isMouseOverButton,
+                               bool      isButtonDown
+                               ) override;
+    
+    /** Draws a button-styled action cell directly into a table row, without a component */
+    void drawTableActionCell (juce::Graphics& g,
+                              juce::Rectangle<float> area,
+                              const     juce::String& text,
+                              const     juce::Colour& backgroundColour);
+    
+    /** Returns the Verdana font at a height, shared by every Customisation instead of being built each time */
+    juce::Font getFont (float height, bool bold = false);
+
+private:
+    //==============================================================================
+    /** Identifies a pre-rendered skin: what it is, its size, geometry and colour, and the display scale */
+    struct SkinKey
+    {
+        enum Kind { sliderTrack, buttonBackground, actionCell };
+        
+        Kind kind;
+        juce::Rectangle<int> bounds;    // size of the image, in logical pixels
+        juce::Rectangle<int> inner;     // geometry drawn inside it, such as the slider track
+        juce::uint32 colour = 0;
+        int flags = 0;
+        juce::String text;
+        int scale = 100;                // physical pixels per logical pixel, in hundredths
+        
+        bool operator== (const SkinKey& other) const;
+    };
+    
+    struct SkinKeyHash
+    {
+        size_t operator() (const SkinKey& key) const;
+    };
+    
+    /** Skins and fonts shared by every Customisation, used on the message thread only */
+    struct SkinCache
+    {
+        std::unordered_map<SkinKey, juce::Image, SkinKeyHash> skins;
+        std::map<std::pair<int, bool>, juce::Font> fonts;
+    };
+    
+    // Most skins kept before the cache is emptied, windows being resized would otherwise fill it with stale sizes
+    static constexpr size_t maxSkins = 512;
+    
+    /**
+        Blits a skin into an area, rendering it first if it is not cached.
+        
+        The skin is rendered at the context's physical pixel scale, so it stays
+        sharp on high density displays.
+    */
+    template <typename RenderFunction>
+    void drawSkin (juce::Graphics& g, SkinKey key, RenderFunction&& render)
+    {
+        auto scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+        key.scale = juce::roundToInt (scale * 100.0f);
+        
+        auto& skins = skinCache -> skins;
+        auto existing = skins.find (key);
+        
+        if (existing == skins.end())
+        {
+            FrameProfiler::ScopedSection section ("Customisation::renderSkin");
+            
+            if (skins.size() >= maxSkins)
+                skins.clear();
+            
+            juce::Image image (juce::Image::ARGB,
+                               juce::jmax (1, juce::roundToInt (key.bounds.getWidth() * scale)),
+                               juce::jmax (1, juce::roundToInt (key.bounds.getHeight() * scale)), true);
+            {
+                juce::Graphics imageGraphics (image);
+                imageGraphics.addTransform (juce::AffineTransform::scale (scale).translated (-key.bounds.getX() * scale,
+                                                                                              -key.bounds.getY() * scale));
+                render (imageGraphics);
+            }
+            
+            existing = skins.emplace (key, std::move (image)).first;
+        }
+        
+        g.drawImage (existing -> second, key.bounds.toFloat());
+    }
+    
+    juce::SharedResourcePointer<SkinCache> skinCache;
+    
+    //==============================================================================
+    // Colours
+    juce::Colour offWhite  = juce::Colour::fromFloatRGBA (0.83f, 0.84f, 0.9f,  1.0f);
+    juce::Colour grey      = juce::Colour::fromFloatRGBA (0.42f, 0.42f, 0.42f, 1.0f);
+    juce::Colour orange    = juce::Colour(255, 165, 0);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Customisation);
+};
+// End of Added Code
@@ -1,206 +1,437 @@
-/*
-  ==============================================================================
-
-    DJAudioPlayer.cpp
-    Created: 4 Mar 2024 7:36:32pm
-    Author:  Justin  Lim
-
-  ==============================================================================
-*/
-
-#include "DJAudioPlayer.h"
-
-DJAudioPlayer::DJAudioPlayer (juce::AudioFormatManager& _formatManager) : formatManager(_formatManager) {}
-
-DJAudioPlayer::~DJAudioPlayer() {}
-
-
-void DJAudioPlayer::prepareToPlay (int samplesPerBlockExpected, double sampleRate)
-{
-    transportSource.prepareToPlay (samplesPerBlockExpected, sampleRate);
-    resampleSource.prepareToPlay  (samplesPerBlockExpected, sampleRate);
-    reverbSource.prepareToPlay    (samplesPerBlockExpected, sampleRate);
-}
-
-void DJAudioPlayer::getNextAudioBlock (const juce::AudioSourceChannelInfo& bufferToFill)
-{
-    reverbSource.getNextAudioBlock(bufferToFill);
-}
-
-void DJAudioPlayer::releaseResources()
-{
-    transportSource.releaseResources();
-    resampleSource.releaseResources();
-    // Start of Added Code
-    reverbSource.releaseResources();
-    // End of Added Code
-}
-
-// Start of Added Code
-// Start audio playback
-void DJAudioPlayer::start()
-{
-    transportSource.start();
-    
-    songIsPlaying = true;
-}
-
-
-// Stop audio playback
-void DJAudioPlayer::stop()
-{
-    transportSource.stop();
-    
-    songIsPlaying = false;
-}
-
-
-// Looping
-void DJAudioPlayer::setLooping(bool shouldLoop)
-{
-    if (readerSource == nullptr)
-    {
-        return; 
-    }
-
-    readerSource->setLooping(shouldLoop);
-    loopState = shouldLoop;
-}
-
-
-
-// Load an audio URL and reads the data. Accepts an URL as parameter
-void DJAudioPlayer::loadURL(juce::URL audioURL)
-{
-    juce::URL::InputStreamOptions options(juce::URL::ParameterHandling::inAddress);  // Adjust with the appropriate parameter
-    // Set any required options for the input stream
-
-    auto* reader = formatManager.createReaderFor(audioURL.createInputStream(options));
-
-    if (reader != nullptr) // good file!
-    {
-        std::unique_ptr<juce::AudioFormatReaderSource> newSource(new juce::AudioFormatReaderSource(reader, true));
-
-        newSource->setLooping(loopState);
-
-        transportSource.setSource(newSource.get(), 0, nullptr, reader->sampleRate);
-
-        readerSource.reset(newSource.release());
-    }
-}
-
-
-// Set the volume of the audio playback
-void DJAudioPlayer::setGain (double gain)
-{
-    if (gain < 0 || gain > 1.0)
-    {
-        std::cout << "DJAudioPlayer::setGain gain should be between 0 and 1" << std::endl;
-    }
-    else
-    {
-        transportSource.setGain (gain);
-    }
-}
-
-
-// Set the speed of the audio playback
-void DJAudioPlayer::setSpeed (double ratio)
-{
-    if (ratio < 0 || ratio > 100.0)
-    {
-        std::cout << "DJAudioPlayer::setSpeed ratio should be between 0 and 100" << std::endl;
-    }
-    else
-    {
-        resampleSource.setResamplingRatio (ratio);
-    }
-}
-
-
-// Set reverb parameters based on user input
-void DJAudioPlayer::setReverbParameters(double parameter, double minValue, double maxValue, juce::String errorMessage)
-{
-    // Check if the parameter is within the valid range
-    if (parameter < minValue || parameter > maxValue)
-    {
-        DBG(errorMessage);
-    }
-    else
-    {
-        // Update the corresponding reverb parameter and apply changes
-        reverbParameters.roomSize = parameter;
-        reverbSource.setParameters(reverbParameters);
-    }
-}
-
-// Set the reverb room size
-void DJAudioPlayer::setRoomSize(double size)
-{
-    setReverbParameters(size, 0.0, 1.0, "DJAudioPlayer::setRoomSize size should be between 0 and 1.0");
-}
-
-// Set the damping effect
-void DJAudioPlayer::setDamping(double dampingRatio)
-{
-    setReverbParameters(dampingRatio, 0.0, 1.0, "DJAudioPlayer::setDamping amount should be between 0 and 1.0");
-}
-
-// Set the position in the audio playback
-void DJAudioPlayer::setPosition(double posInSecs)
-{
-    transportSource.setPosition(posInSecs);
-}
-
-// Set the relative position of the playhead
-void DJAudioPlayer::setPositionRelative(double pos)
-{
-    // Check if pos is within valid range [0, 1.0]
-    if (pos < 0 || pos > 1.0)
-    {
-        std::cout << "DJAudioPlayer::setPositionRelative pos should be between 0 and 1" << std::endl;
-    }
-    else
-    {
-        // Calculate the absolute position in seconds based on the relative position
-        double posInSecs = transportSource.getLengthInSeconds() * pos;
-        // Set the calculated absolute position
-        setPosition(posInSecs);
-    }
-}
-
-// Get the relative position of the playhead
-double DJAudioPlayer::getPositionRelative()
-{
-    // Return the relative position of the playhead
-    return transportSource.getCurrentPosition() / transportSource.getLengthInSeconds();
-}
-
-
-
-// Get the current position of the playback
-double DJAudioPlayer::getCurrentPosition()
-{
-    return transportSource.getCurrentPosition();
-}
-
-// Retrives the value from the zoom slider from the DeckGUI
-void DJAudioPlayer::retrieveZoomValue (double amount)
-{
-    if (amount < 0 || amount > 1.0)
-    {
-        std::cout << "DJAudioPlayer::retrieveZoomValue amount should be between 0 and 1" << std::endl;
-    }
-    else
-    {
-        zoomValue = amount;
-    }
-}
-
-
-// Retrieves the audio length of a song
-double DJAudioPlayer::getAudioLength()
-{
-    return transportSource.getLengthInSeconds();
-}
-// End of Added Code
+/*
+  ==============================================================================
+
+    DJAudioPlayer.cpp
+    Created: 4 Mar 2024 7:36:32pm
+    Author:  Justin  Lim
+
+  ==============================================================================
+*/
+
+#include "DJAudioPlayer.h"
+
+DJAudioPlayer::DJAudioPlayer (juce::AudioFormatManager& _formatManager) : formatManager(_formatManager) {}
+
+DJAudioPlayer::~DJAudioPlayer() {}
+
+
+void DJAudioPlayer::prepareToPlay (int samplesPerBlockExpected, double sampleRate)
+{
+    deviceSampleRate = sampleRate;
+    samplesRendered = 0;
+    
+    transportSource.prepareToPlay (samplesPerBlockExpected, sampleRate);
+    resampleSource.prepareToPlay  (samplesPerBlockExpected, sampleRate);
+    reverbSource.prepareToPlay    (samplesPerBlockExpected, sampleRate);
+}
+
+void DJAudioPlayer::getNextAudioBlock (const juce::AudioSourceChannelInfo& bufferToFill)
+{
+    // Start of Added Code
+    applyBeatSync (bufferToFill.numSamples);
+    publishPlayhead();
+    // End of Added Code
+    
+    reverbSource.getNextAudioBlock(bufferToFill);
+    
+    // Start of Added Code
+    samplesRendered += bufferToFill.numSamples;
+    // End of Added Code
+}
+
+void DJAudioPlayer::releaseResources()
+{
+    transportSource.releaseResources();
+    resampleSource.releaseResources();
+    // Start of Added Code
+    reverbSource.releaseResources();
+    // End of Added Code
+}
+
+// Start of Added Code
+// Start audio playback
+void DJAudioPlayer::start()
+{
+    transportSource.start();
+    
+    songIsPlaying = true;
+}
+
+
+// Stop audio playback
+void DJAudioPlayer::stop()
+{
+    transportSource.stop();
+    
+    songIsPlaying = false;
+}
+
+
+// Looping
+void DJAudioPlayer::setLooping(bool shouldLoop)
+{
+    if (readerSource == nullptr)
+    {
+        return; 
+    }
+
+    readerSource->setLooping(shouldLoop);
+    loopState = shouldLoop;
+}
+
+
+
+// Load an audio URL and reads the data. Accepts an URL as parameter
+void DJAudioPlayer::loadURL(juce::URL audioURL)
+{
+    juce::URL::InputStreamOptions options(juce::URL::ParameterHandling::inAddress);  // Adjust with the appropriate parameter
+    // Set any required options for the input stream
+
+    auto* reader = formatManager.createReaderFor(audioURL.createInputStream(options));
+    
+    // The previous song's beat grid and loudness do not apply to the new one
+    setBeatGrid ({});
+    setLoudness ({});
+
+    if (reader != nullptr) // good file!
+    {
+        std::unique_ptr<juce::AudioFormatReaderSource> newSource(new juce::AudioFormatReaderSource(reader, true));
+
+        newSource->setLooping(loopState);
+
+        transportSource.setSource(newSource.get(), 0, nullptr, reader->sampleRate);
+
+        readerSource.reset(newSource.release());
+        preloadedTrack = nullptr;
+    }
+}
+
+
+// Swap in a preloaded track, playing from memory so nothing is opened or decoded on the message thread
+void DJAudioPlayer::loadPreloaded (std::shared_ptr<PreloadedTrack> track)
+{
+    if (track == nullptr)
+        return;
+    
+    setBeatGrid ({});
+    setLoudness ({});
+    
+    auto newSource = std::make_unique<juce::MemoryAudioSource> (track -> audio, false, loopState);
+    transportSource.setSource (newSource.get(), 0, nullptr, track -> sampleRate);
+    
+    // The previous source is only released once the transport has stopped reading it
+    readerSource = std::move (newSource);
+    preloadedTrack = std::move (track);
+}
+
+
+// Set the trim gain of the loaded song, songs that were not measured play as they are
+// The transport source ramps between gains, so a change never clicks
+void DJAudioPlayer::setLoudness (const LoudnessMeasurement& loudness)
+{
+    trimGain = juce::Decibels::decibelsToGain (loudness.getNormalisationGainInDecibels());
+    transportSource.setGain (trimGain);
+}
+
+
+// Set the speed of the audio playback
+void DJAudioPlayer::setSpeed (double ratio)
+{
+    if (ratio < 0 || ratio > 100.0)
+    {
+        std::cout << "DJAudioPlayer::setSpeed ratio should be between 0 and 100" << std::endl;
+    }
+    else
+    {
+        speedRatio = ratio;
+        resampleSource.setResamplingRatio (ratio);
+    }
+}
+
+
+// Get the speed set by setSpeed
+double DJAudioPlayer::getSpeed() const
+{
+    return speedRatio.load();
+}
+
+
+// Set the beat grid of the loaded song
+void DJAudioPlayer::setBeatGrid (const BeatGrid& grid)
+{
+    beatGridBpm = grid.bpm;
+    beatGridFirstBeat = grid.firstBeatSeconds;
+}
+
+
+// Get the beat grid of the loaded song
+BeatGrid DJAudioPlayer::getBeatGrid() const
+{
+    BeatGrid grid;
+    grid.bpm = beatGridBpm.load();
+    grid.firstBeatSeconds = beatGridFirstBeat.load();
+    return grid;
+}
+
+
+// Match the leader's tempo through setSpeed, the audio thread then keeps the beats in phase
+bool DJAudioPlayer::syncTo (DJAudioPlayer* leader)
+{
+    auto grid = getBeatGrid();
+    
+    if (leader == nullptr || leader == this || ! grid.isValid() || ! leader -> getBeatGrid().isValid())
+        return false;
+    
+    // Two players following each other would never settle, the leader stops following
+    if (leader -> syncLeader.load() == this)
+        leader -> stopSync();
+    
+    setSpeed (leader -> getSpeed() * leader -> getBeatGrid().bpm / grid.bpm);
+    syncLeader = leader;
+    
+    return true;
+}
+
+
+// Stop following the other player, the audio thread restores the speed set by setSpeed
+void DJAudioPlayer::stopSync()
+{
+    syncLeader = nullptr;
+}
+
+
+// Returns true while the player is following another player
+bool DJAudioPlayer::isSynced() const
+{
+    return syncLeader.load() != nullptr;
+}
+
+
+/*
+    Sets the resampling ratio for the next block so this player's beats stay on the leader's.
+    
+    Runs on the audio thread before the block is rendered. Both players count the samples
+    they have rendered, so the leader's position at the start of this block is known to the
+    sample, whichever of the two the mixer renders first. The ratio is the leader's tempo
+    scaled by the ratio of the two grids, trimmed by at most 1% to pull in the phase error.
+    An error of more than 20 ms, after a seek or when sync is switched on, is jumped over
+    instead, so the trim only has to absorb rounding and stays inaudible.
+    
+    @param numSamples     Number of samples in the block about to be rendered.
+*/
+void DJAudioPlayer::applyBeatSync (int numSamples)
+{
+    constexpr double maxPhaseTrim = 0.01;
+    constexpr double maxSlewSeconds = 0.02;
+    constexpr double phaseCorrectionSeconds = 0.1;   // time constant of the phase correction
+    
+    auto* leader = syncLeader.load();
+    auto grid = getBeatGrid();
+    auto ratio = speedRatio.load();
+    
+    if (leader != nullptr && deviceSampleRate > 0.0 && numSamples > 0 && grid.isValid()
+        && songIsPlaying && leader -> songIsPlaying && leader -> getBeatGrid().isValid())
+    {
+        auto leaderGrid = leader -> getBeatGrid();
+        
+        // A leader that has not rendered this block yet is extrapolated from its previous one
+        auto leaderRatio = leader -> blockRatio.load();
+        auto leaderPosition = leader -> blockStartPosition.load()
+                            + (samplesRendered - leader -> blockStartSample.load()) / deviceSampleRate * leaderRatio;
+        auto position = transportSource.getCurrentPosition();
+        
+        auto phaseError = grid.getBeatAt (position) - leaderGrid.getBeatAt (leaderPosition);
+        phaseError -= std::round (phaseError);
+        
+        if (std::abs (phaseError) * grid.getBeatLengthInSeconds() > maxSlewSeconds)
+        {
+            position -= phaseError * grid.getBeatLengthInSeconds();
+            transportSource.setPosition (position);
+            phaseError = 0.0;
+        }
+        
+        // Beats the leader covers in this block, less a share of the error
+        auto blockSeconds = numSamples / deviceSampleRate;
+        auto leaderBeats = blockSeconds * leaderRatio * leaderGrid.bpm / 60.0;
+        auto targetBeats = leaderBeats - phaseError * juce::jmin (1.0, blockSeconds / phaseCorrectionSeconds);
+        
+        auto matchedRatio = leaderRatio * leaderGrid.bpm / grid.bpm;
+        ratio = juce::jlimit (matchedRatio * (1.0 - maxPhaseTrim), matchedRatio * (1.0 + maxPhaseTrim),
+                              targetBeats * 60.0 / (grid.bpm * blockSeconds));
+        
+        resampleSource.setResamplingRatio (ratio);
+        wasSynced = true;
+    }
+    else if (wasSynced)
+    {
+        // Sync was switched off, or one of the players stopped
+        resampleSource.setResamplingRatio (ratio);
+        wasSynced = false;
+    }
+    
+    blockStartSample = samplesRendered;
+    blockStartPosition = transportSource.getCurrentPosition();
+    blockRatio = wasSynced ? ratio : speedRatio.load();
+}
+
+
+/*
+    Publishes where the block about to be rendered starts in the song.
+    
+    The GUI extrapolates the playhead from this snapshot, so it moves smoothly
+    between blocks and never has to read the transport, whose state belongs to
+    the audio thread. The fields are written between two increments of the
+    sequence count; a reader that sees the count change or odd reads again.
+*/
+void DJAudioPlayer::publishPlayhead()
+{
+    auto sequence = playheadSequence.load (std::memory_order_relaxed);
+    
+    playheadSequence.store (sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence (std::memory_order_release);
+    
+    playheadPosition.store (blockStartPosition.load(), std::memory_order_relaxed);
+    playheadLength.store (transportSource.getLengthInSeconds(), std::memory_order_relaxed);
+    playheadHostTime.store (juce::Time::getMillisecondCounterHiRes(), std::memory_order_relaxed);
+    playheadRate.store (transportSource.isPlaying() ? blockRatio.load() : 0.0, std::memory_order_relaxed);
+    playheadLooping.store (loopState, std::memory_order_relaxed);
+    
+    playheadSequence.store (sequence + 2, std::memory_order_release);
+}
+
+
+// Returns the playhead as the audio thread last published it
+DJAudioPlayer::PlayheadSnapshot DJAudioPlayer::getPlayheadSnapshot() const
+{
+    PlayheadSnapshot snapshot;
+    
+    for (;;)
+    {
+        auto sequence = playheadSequence.load (std::memory_order_acquire);
+        
+        if ((sequence & 1) != 0)
+            continue;
+        
+        snapshot.position   = playheadPosition.load (std::memory_order_relaxed);
+        snapshot.length     = playheadLength.load (std::memory_order_relaxed);
+        snapshot.hostTimeMs = playheadHostTime.load (std::memory_order_relaxed);
+        snapshot.rate       = playheadRate.load (std::memory_order_relaxed);
+        snapshot.looping    = playheadLooping.load (std::memory_order_relaxed);
+        
+        std::atomic_thread_fence (std::memory_order_acquire);
+        
+        if (playheadSequence.load (std::memory_order_relaxed) == sequence)
+            return snapshot;
+    }
+}
+
+
+// Extrapolates the playhead at the rate it was moving, for no longer than a stalled device could plausibly take to publish again
+double DJAudioPlayer::PlayheadSnapshot::getPositionAt (double timeMs) const
+{
+    constexpr double maxExtrapolationSeconds = 0.25;
+    
+    if (length <= 0.0)
+        return 0.0;
+    
+    auto elapsed = juce::jlimit (0.0, maxExtrapolationSeconds, (timeMs - hostTimeMs) / 1000.0);
+    auto extrapolated = position + elapsed * rate;
+    
+    if (looping)
+        return std::fmod (extrapolated, length);
+    
+    return juce::jmin (extrapolated, length);
+}
+
+
+// Set reverb parameters based on user input
+void DJAudioPlayer::setReverbParameters(double parameter, double minValue, double maxValue, juce::String errorMessage)
+{
+    // Check if the parameter is within the valid range
+    if (parameter < minValue || parameter > maxValue)
+    {
+        DBG(errorMessage);
+    }
+    else
+    {
+        // Update the corresponding reverb parameter and apply changes
+        reverbParameters.roomSize = parameter;
+        reverbSource.setParameters(reverbParameters);
+    }
+}
+
+// Set the reverb room size
+void DJAudioPlayer::setRoomSize(double size)
+{
+    setReverbParameters(size, 0.0, 1.0, "DJAudioPlayer::setRoomSize size should be between 0 and 1.0");
+}
+
+// Set the damping effect
+void DJAudioPlayer::setDamping(double dampingRatio)
+{
+    setReverbParameters(dampingRatio, 0.0, 1.0, "DJAudioPlayer::setDamping amount should be between 0 and 1.0");
+}
+
+// Set the position in the audio playback
+void DJAudioPlayer::setPosition(double posInSecs)
+{
+    transportSource.setPosition(posInSecs);
+}
+
+// Set the relative position of the playhead
+void DJAudioPlayer::setPositionRelative(double pos)
+{
+    // Check if pos is within valid range [0, 1.0]
+    if (pos < 0 || pos > 1.0)
+    {
+        std::cout << "DJAudioPlayer::setPositionRelative pos should be between 0 and 1" << std::endl;
+    }
+    else
+    {
+        // Calculate the absolute position in seconds based on the relative position
+        double posInSecs = transportSource.getLengthInSeconds() * pos;
+        // Set the calculated absolute position
+        setPosition(posInSecs);
+    }
+}
+
+// Get the relative position of the playhead, extrapolated from the audio thread's last snapshot
+double DJAudioPlayer::getPositionRelative()
+{
+    auto snapshot = getPlayheadSnapshot();
+    
+    // Return the relative position of the playhead
+    if (snapshot.length <= 0.0)
+        return 0.0;
+    
+    return snapshot.getPositionAt (juce::Time::getMillisecondCounterHiRes()) / snapshot.length;
+}
+
+
+
+// Get the current position of the playback, extrapolated from the audio thread's last snapshot
+double DJAudioPlayer::getCurrentPosition()
+{
+    return getPlayheadSnapshot().getPositionAt (juce::Time::getMillisecondCounterHiRes());
+}
+
+// Retrives the value from the zoom slider from the DeckGUI
+void DJAudioPlayer::retrieveZoomValue (double amount)
+{
+    if (amount < 0 || amount > 1.0)
+    {
+        std::cout << "DJAudioPlayer::retrieveZoomValue amount should be between 0 and 1" << std::endl;
+    }
+    else
+    {
+        zoomValue = amount;
+    }
+}
+
+
+// Retrieves the audio length of a song
+double DJAudioPlayer::getAudioLength()
+{
+    return transportSource.getLengthInSeconds();
+}
+// End of Added Code
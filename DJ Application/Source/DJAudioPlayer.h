@@ -1,103 +1,185 @@
-/*
-  ==============================================================================
-
-    DJAudioPlayer.h
-    Created: 4 Mar 2024 7:36:32pm
-    Author:  Justin  Lim
-
-  ==============================================================================
-*/
-
-#pragma once
-
-#include <JuceHeader.h>
-
-class DJAudioPlayer : public juce::AudioSource
-{
-public:
-    //==============================================================================
-    DJAudioPlayer(juce::AudioFormatManager& _formatManager);
-    ~DJAudioPlayer();
-    
-    //==============================================================================
-    void prepareToPlay (int samplesPerBlockExpected, double sampleRate) override;
-    void getNextAudioBlock (const juce::AudioSourceChannelInfo& bufferToFill) override;
-    void releaseResources() override;
-    
-    //==============================================================================
-    // Start of Added Code
-    /** Start audio playback */
-    void start();
-    
-    /** Stop audio playback */
-    void stop();
-    
-    /** Set loop state to true or false */
-    void setLooping(bool shouldLoop);
-    
-    /** Load an audio URL and reads the data */
-    void loadURL (juce::URL audioURL);
-    
-    /** Set the volume of the audio playback */
-    void setGain (double gain);
-    
-    /** Set the speed of the audio playback  */
-    void setSpeed (double ratio);
-    
-    /** Set reverb parameters based on user input **/
-    void setReverbParameters(double parameter, double minValue, double maxValue, juce::String errorMessage);;
-    
-    /** Set the reverb room size */
-    void setRoomSize (double size);
-    
-    /** Set the damping effect */
-    void setDamping (double dampingRatio);
-    
-    /** Set the position in the audio playback */
-    void setPosition (double posInSecs);
-    
-    /** Set the relative position of the playhead */
-    void setPositionRelative (double pos);
-    
-    /** Get the relative position of the playhead */
-    double getPositionRelative();
-    
-    /** Get the current position of the playback */
-    double getCurrentPosition();
-    
-    /** Retrives the value from the zoom slider from the DeckGUI */
-    void retrieveZoomValue (double amount);
-    
-    /** Retrieves the audio length of a song */
-    double getAudioLength ();
-    
-    /** Store the song status of the DJ player */
-    bool songIsPlaying;
-    
-    /** Store the zoom value from the zoom slider in a variable */
-    double zoomValue;
-    
-    /** Store the current loop state */
-    bool loopState = false;
-    
-private:
-private:
-    //Manages audio formats and determines which file to open
-    juce::AudioFormatManager& formatManager;
-
-    // Utilizes an AudioFormatReader to read audio data
-    std::unique_ptr<juce::AudioFormatReaderSource> readerSource;
-
-    // Takes a PositionableAudioSource and allows certain actions to be executed
-    juce::AudioTransportSource transportSource;
-
-    // Takes an input source and alter its sample rate
-    juce::ResamplingAudioSource resampleSource {&transportSource, false, 2};
-
-    // Applies reverb using the Reverb class to enhance another AudioSource
-    juce::ReverbAudioSource reverbSource { &resampleSource, false };
-
-    juce::Reverb::Parameters reverbParameters;
-};
-
-// End of Added Code
+/*
+  ==============================================================================
+
+    DJAudioPlayer.h
+    Created: 4 Mar 2024 7:36:32pm
+    Author:  Justin  Lim
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "TempoAnalyser.h"
+#include "LoudnessAnalyser.h"
+#include "TrackPreloader.h"
+
+class DJAudioPlayer : public juce::AudioSource
+{
+public:
+    /** Where the playhead was at a moment on the message thread's clock, published by the audio thread once per block */
+    struct PlayheadSnapshot
+    {
+        double position = 0.0;      // seconds into the song
+        double length = 0.0;        // length of the song in seconds, 0 with no song loaded
+        double hostTimeMs = 0.0;    // juce::Time::getMillisecondCounterHiRes() when the block started
+        double rate = 0.0;          // seconds of song played per second, 0 while stopped
+        bool looping = false;
+        
+        /** Returns where the playhead is at a time on the same clock, extrapolated from the snapshot */
+        double getPositionAt (double timeMs) const;
+    };
+    
+    //==============================================================================
+    DJAudioPlayer(juce::AudioFormatManager& _formatManager);
+    ~DJAudioPlayer();
+    
+    //==============================================================================
+    void prepareToPlay (int samplesPerBlockExpected, double sampleRate) override;
+    void getNextAudioBlock (const juce::AudioSourceChannelInfo& bufferToFill) override;
+    void releaseResources() override;
+    
+    //==============================================================================
+    // Start of Added Code
+    /** Start audio playback */
+    void start();
+    
+    /** Stop audio playback */
+    void stop();
+    
+    /** Set loop state to true or false */
+    void setLooping(bool shouldLoop);
+    
+    /** Load an audio URL and reads the data */
+    void loadURL (juce::URL audioURL);
+    
+    /** Swap in a track that was decoded ahead of time, the player holds on to it while it is loaded */
+    void loadPreloaded (std::shared_ptr<PreloadedTrack> track);
+    
+    /** Set the trim gain that brings the loaded song to the reference loudness */
+    void setLoudness (const LoudnessMeasurement& loudness);
+    
+    /** Set the speed of the audio playback  */
+    void setSpeed (double ratio);
+    
+    /** Get the speed set by setSpeed */
+    double getSpeed() const;
+    
+    /** Set the beat grid of the loaded song, used to keep it in phase when synced */
+    void setBeatGrid (const BeatGrid& grid);
+    
+    /** Get the beat grid of the loaded song */
+    BeatGrid getBeatGrid() const;
+    
+    /** Match the tempo of another player and keep the beats in phase with it, returns false if either song has no beat grid */
+    bool syncTo (DJAudioPlayer* leader);
+    
+    /** Stop following the other player and go back to the speed set by setSpeed */
+    void stopSync();
+    
+    /** Returns true while the player is following another player */
+    bool isSynced() const;
+    
+    /** Set reverb parameters based on user input **/
+    void setReverbParameters(double parameter, double minValue, double maxValue, juce::String errorMessage);;
+    
+    /** Set the reverb room size */
+    void setRoomSize (double size);
+    
+    /** Set the damping effect */
+    void setDamping (double dampingRatio);
+    
+    /** Set the position in the audio playback */
+    void setPosition (double posInSecs);
+    
+    /** Set the relative position of the playhead */
+    void setPositionRelative (double pos);
+    
+    /** Get the relative position of the playhead, 0 with no song loaded */
+    double getPositionRelative();
+    
+    /** Get the current position of the playback */
+    double getCurrentPosition();
+    
+    /** Returns the playhead as the audio thread last published it, without touching the transport */
+    PlayheadSnapshot getPlayheadSnapshot() const;
+    
+    /** Retrives the value from the zoom slider from the DeckGUI */
+    void retrieveZoomValue (double amount);
+    
+    /** Retrieves the audio length of a song */
+    double getAudioLength ();
+    
+    /** Store the song status of the DJ player, read by the other player's audio callback while synced */
+    std::atomic<bool> songIsPlaying { false };
+    
+    /** Store the zoom value from the zoom slider in a variable */
+    double zoomValue;
+    
+    /** Store the current loop state */
+    bool loopState = false;
+    
+private:
+    /** Adjust the resampling ratio for the next block so the beats line up with the sync leader */
+    void applyBeatSync (int numSamples);
+    
+    /** Publish where the block about to be rendered starts, called on the audio thread */
+    void publishPlayhead();
+    
+    //Manages audio formats and determines which file to open
+    juce::AudioFormatManager& formatManager;
+
+    // Reads the loaded song, from its file or from a preloaded track in memory
+    std::unique_ptr<juce::PositionableAudioSource> readerSource;
+    
+    // Decoded audio the reader source plays from when the song was preloaded, otherwise nullptr
+    std::shared_ptr<PreloadedTrack> preloadedTrack;
+
+    // Takes a PositionableAudioSource and allows certain actions to be executed
+    juce::AudioTransportSource transportSource;
+
+    // Takes an input source and alter its sample rate
+    juce::ResamplingAudioSource resampleSource {&transportSource, false, 2};
+
+    // Applies reverb using the Reverb class to enhance another AudioSource
+    juce::ReverbAudioSource reverbSource { &resampleSource, false };
+
+    juce::Reverb::Parameters reverbParameters;
+    
+    // Trim that normalises the loaded song, the volume slider is applied by the master mixer
+    double trimGain = 1.0;
+    
+    // Speed set by setSpeed, the resampling ratio drifts from it while synced
+    std::atomic<double> speedRatio { 1.0 };
+    
+    // Beat grid of the loaded song, written on the message thread and read on the audio thread
+    std::atomic<double> beatGridBpm { 0.0 };
+    std::atomic<double> beatGridFirstBeat { 0.0 };
+    
+    // Player whose beats this one follows, or nullptr
+    std::atomic<DJAudioPlayer*> syncLeader { nullptr };
+    
+    // Audio thread only: the output sample clock
+    double deviceSampleRate = 0.0;
+    juce::int64 samplesRendered = 0;
+    bool wasSynced = false;
+    
+    // Where the song was at the start of the last block, so a follower can work out the leader's position at the
+    // start of its own block. Written by this player's callback and read by the follower's; both players are
+    // rendered one after the other by the master mixer on the same callback, the atomics keep that assumption safe
+    std::atomic<juce::int64> blockStartSample { 0 };
+    std::atomic<double> blockStartPosition { 0.0 };
+    std::atomic<double> blockRatio { 1.0 };
+    
+    // Playhead snapshot, written by the audio thread under a sequence count that is odd while a write is under way,
+    // so readers on other threads retry instead of ever blocking the audio thread
+    std::atomic<juce::uint32> playheadSequence { 0 };
+    std::atomic<double> playheadPosition { 0.0 };
+    std::atomic<double> playheadLength { 0.0 };
+    std::atomic<double> playheadHostTime { 0.0 };
+    std::atomic<double> playheadRate { 0.0 };
+    std::atomic<bool> playheadLooping { false };
+};
+
+// End of Added Code
@@ -1,102 +1,151 @@
-/*
-  ==============================================================================
-
-    DeckGUI.h
-    Created: 4 Mar 2024 7:37:03pm
-    Author:  Justin  Lim
-
-  ==============================================================================
-*/
-
-#pragma once
-
-#include <JuceHeader.h>
-#include "DJAudioPlayer.h"
-#include "WaveformDisplay.h"
-#include "Customisation.h"
-
-class DeckGUI : public juce::Component,
-public juce::Button::Listener,
-public juce::Slider::Listener,
-public juce::FileDragAndDropTarget,
-public juce::Timer
-{
-public:
-    //==============================================================================
-    DeckGUI(DJAudioPlayer*       player,
-            juce::AudioFormatManager&  formatManagerToUse,
-            juce::AudioThumbnailCache& cacheToUse);
-    ~DeckGUI();
-    
-    //==============================================================================
-    void paint (juce::Graphics&) override;
-    void resized() override;
-    
-    //==============================================================================
-    // Below are added code on top of starter code
-    /** Button listener to check if a button is clicked */
-    void buttonClicked (juce::Button*) override;
-    
-    /** Slider listener to check if a slider is used */
-    void sliderValueChanged (juce::Slider* slider) override;
-    
-    /** For DeckGUI component to register for and receive drag events */
-    bool isInterestedInFileDrag (const juce::StringArray& files) override;
-    
-    /** For DeckGUI component to register for and receive drop events */
-    void filesDropped (const juce::StringArray& files, int x, int y) override;
-    
-    /** Show the current playback position and update the play head */
-    void timerCallback() override;
-    
-    /** Loads  URL into the player and draws the waveform */
-    void loadAudio (juce::URL audioURL);
-    
-    /** Update song name label */
-    void updateSongNameLabel (juce::String songSelected);
-    
-    /** Update song duration label*/
-    void updateSongDurationLabel (juce::String songDuration);
-    
-private:
-    // ( Added code on top of starter code)
-    void initializeUIElements();
-    void initializeLookAndFeel();
-    
-    // Object that points to the DJAudioPlayer  ( Added code on top of starter code)
-    DJAudioPlayer* player;
-    
-    // Manipulate the waveform display  ( Added code on top of starter code)
-    WaveformDisplay waveformDisplay;
-    
-    // Manage visual UI elements  ( Added code on top of starter code)
-    Customisation customisation;
-    
-    // Text buttons  ( Added code on top of starter code)
-    juce::TextButton playStopButton {"PLAY"};
-    juce::TextButton loopButton     {"ENABLE LOOP"};
-    
-    
-    // Sliders ( Added code on top of starter code)
-    juce::Slider volSlider            { juce::Slider::LinearVertical,   juce::Slider::NoTextBox };
-    juce::Slider speedSlider          { juce::Slider::LinearVertical,   juce::Slider::NoTextBox };
-    juce::Slider reverbSlider { juce::Slider::LinearVertical,   juce::Slider::NoTextBox };
-    juce::Slider dampingSlider        { juce::Slider::LinearVertical,   juce::Slider::NoTextBox };
-    
-    // Labels  ( Added code on top of starter code)
-    juce::Label volLabel            { {}, "Volume" };
-    juce::Label speedLabel          { {}, "Speed"};
-    juce::Label reverbLabel { {}, "Room size" };
-    juce::Label dampingLabel        { {}, "Damping" };
-    juce::Label songNameLabel;
-    juce::Label songDurationLabel;
-
-    // Colours  ( Added code on top of starter code)
-    juce::Colour grey        = juce::Colour::fromFloatRGBA (0.42f, 0.42f, 0.42f, 1.0f);
-    juce::Colour green       = juce::Colour (27, 126, 60);
-    juce::Colour red         = juce::Colour (153, 102, 102);
-    juce::Colour lightOrange = juce::Colour (179, 119, 0);
-    juce::Colour darkOrange  = juce::Colour (102, 68, 0);
-    
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DeckGUI)
-};
+/*
+  ==============================================================================
+
+    DeckGUI.h
+    Created: 4 Mar 2024 7:37:03pm
+    Author:  Justin  Lim
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "DJAudioPlayer.h"
+#include "KeyAnalyser.h"
+#include "WaveformDisplay.h"
+#include "ZoomedWaveformDisplay.h"
+#include "Customisation.h"
+#include "RefreshScheduler.h"
+
+class DeckGUI : public juce::Component,
+public juce::Button::Listener,
+public juce::Slider::Listener,
+public juce::FileDragAndDropTarget,
+public RefreshScheduler::Client
+{
+public:
+    //==============================================================================
+    DeckGUI(DJAudioPlayer*       player,
+            juce::AudioFormatManager&  formatManagerToUse,
+            juce::AudioThumbnailCache& cacheToUse,
+            RefreshScheduler&          refreshSchedulerToUse);
+    ~DeckGUI();
+    
+    //==============================================================================
+    void paint (juce::Graphics&) override;
+    void resized() override;
+    
+    //==============================================================================
+    // Below are added code on top of starter code
+    /** Button listener to check if a button is clicked */
+    void buttonClicked (juce::Button*) override;
+    
+    /** Slider listener to check if a slider is used */
+    void sliderValueChanged (juce::Slider* slider) override;
+    
+    /** For DeckGUI component to register for and receive drag events */
+    bool isInterestedInFileDrag (const juce::StringArray& files) override;
+    
+    /** For DeckGUI component to register for and receive drop events */
+    void filesDropped (const juce::StringArray& files, int x, int y) override;
+    
+    /** Returns true while the playhead is moving or the deck follows the other deck */
+    bool needsRefresh() override;
+    
+    /** Show the current playback position and update the play head */
+    void refreshDisplay() override;
+    
+    /** Loads  URL into the player and draws the waveform */
+    void loadAudio (juce::URL audioURL);
+    
+    /** Swaps a preloaded track into the player and draws its waveform from memory */
+    void loadPreloadedAudio (std::shared_ptr<PreloadedTrack> track);
+    
+    /** Update song name label */
+    void updateSongNameLabel (juce::String songSelected);
+    
+    /** Update song duration label*/
+    void updateSongDurationLabel (juce::String songDuration);
+    
+    /** Give the player the beat grid of the loaded song and show its tempo */
+    void setBeatGrid (const BeatGrid& grid);
+    
+    /** Give the player the loudness of the loaded song, so it plays at the same level as every other song */
+    void setLoudness (const LoudnessMeasurement& loudness);
+    
+    /** Show the key of the loaded song */
+    void setKey (MusicalKey key);
+    
+    /** Returns true if both decks have a beat grid, which sync needs */
+    bool canSync() const;
+    
+    /** Set the player of the other deck, which the sync button follows */
+    void setSyncPartner (DJAudioPlayer* otherPlayer);
+    
+    /** Returns true while the player is playing */
+    bool isPlaying() const;
+    
+    /** Called when the play button starts the player */
+    std::function<void()> onPlaybackStarted;
+    
+    /** Called with the new gain when the volume slider moves, the deck's fader is in the master mixer */
+    std::function<void (double gain)> onVolumeChanged;
+    
+private:
+    // ( Added code on top of starter code)
+    void initializeUIElements();
+    void initializeLookAndFeel();
+    
+    // Object that points to the DJAudioPlayer  ( Added code on top of starter code)
+    DJAudioPlayer* player;
+    
+    // Key of the loaded song, shown next to its tempo
+    MusicalKey songKey;
+    
+    // Player of the other deck, followed while sync is on
+    DJAudioPlayer* syncPartner = nullptr;
+    
+    // Refreshes the deck once per frame, and the position it showed last
+    RefreshScheduler& refreshScheduler;
+    double shownPosition = -1.0;
+    
+    // Manipulate the waveform display  ( Added code on top of starter code)
+    WaveformDisplay waveformDisplay;
+    
+    // Zoomed strip that scrolls with the playhead, drawn from the overview's waveform data
+    ZoomedWaveformDisplay zoomedWaveformDisplay;
+    
+    // Manage visual UI elements  ( Added code on top of starter code)
+    Customisation customisation;
+    
+    // Text buttons  ( Added code on top of starter code)
+    juce::TextButton playStopButton {"PLAY"};
+    juce::TextButton loopButton     {"ENABLE LOOP"};
+    juce::TextButton syncButton     {"SYNC"};
+    
+    
+    // Sliders ( Added code on top of starter code)
+    juce::Slider volSlider            { juce::Slider::LinearVertical,   juce::Slider::NoTextBox };
+    juce::Slider speedSlider          { juce::Slider::LinearVertical,   juce::Slider::NoTextBox };
+    juce::Slider reverbSlider { juce::Slider::LinearVertical,   juce::Slider::NoTextBox };
+    juce::Slider dampingSlider        { juce::Slider::LinearVertical,   juce::Slider::NoTextBox };
+    
+    // Labels  ( Added code on top of starter code)
+    juce::Label volLabel            { {}, "Volume" };
+    juce::Label speedLabel          { {}, "Speed"};
+    juce::Label reverbLabel { {}, "Room size" };
+    juce::Label dampingLabel        { {}, "Damping" };
+    juce::Label songNameLabel;
+    juce::Label songDurationLabel;
+    juce::Label songBpmLabel;
+
+    // Colours  ( Added code on top of starter code)
+    juce::Colour grey        = juce::Colour::fromFloatRGBA (0.42f, 0.42f, 0.42f, 1.0f);
+    juce::Colour green       = juce::Colour (27, 126, 60);
+    juce::Colour red         = juce::Colour (153, 102, 102);
+    juce::Colour lightOrange = juce::Colour (179, 119, 0);
+    juce::Colour darkOrange  = juce::Colour (102, 68, 0);
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DeckGUI)
+};
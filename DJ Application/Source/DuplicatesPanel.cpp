@@ -0,0 +1,225 @@
+/*
+  ==============================================================================
+
+    DuplicatesPanel.cpp
+    Created: 21 Oct 2026 10:26:51pm
+    Author:  Justin  Lim
+
+  ==============================================================================
+*/
+
+#include "DuplicatesPanel.h"
+
+DuplicatesPanel::DuplicatesPanel()
+{
+    addAndMakeVisible (headingLabel);
+    addAndMakeVisible (listBox);
+
+    // Heading label properties
+    headingLabel.setFont              (juce::Font (13.0f, juce::Font::bold));
+    headingLabel.setJustificationType (juce::Justification::centredLeft);
+    headingLabel.setColour            (juce::Label::textColourId, juce::Colours::white);
+
+    listBox.setRowHeight (24);
+}
+
+DuplicatesPanel::~DuplicatesPanel() {}
+
+
+void DuplicatesPanel::paint (juce::Graphics& g)
+{
+    g.fillAll (getLookAndFeel().findColour (juce::ResizableWindow::backgroundColourId));
+}
+
+
+// Heading on top, list below
+void DuplicatesPanel::resized()
+{
+    auto bounds = getLocalBounds();
+
+    headingLabel.setBounds (bounds.removeFromTop (24));
+    listBox.setBounds (bounds);
+}
+
+
+// Shows the groups of copies
+void DuplicatesPanel::setGroups (std::vector<std::vector<Song>> newGroups, int numSongsNotAnalysed)
+{
+    groups = std::move (newGroups);
+    numNotAnalysed = numSongsNotAnalysed;
+
+    updateRows();
+}
+
+
+// Empties the list and shows a message in place of the heading
+void DuplicatesPanel::clearGroups (const juce::String& message)
+{
+    groups.clear();
+    rows.clear();
+
+    headingLabel.setText (message, juce::dontSendNotification);
+    listBox.updateContent();
+    listBox.repaint();
+}
+
+
+// Lists each group's heading followed by its songs, dropping groups that are no longer duplicates
+void DuplicatesPanel::updateRows()
+{
+    groups.erase (std::remove_if (groups.begin(), groups.end(), [] (auto& group) { return group.size() < 2; }), groups.end());
+    rows.clear();
+
+    for (size_t group = 0; group < groups.size(); ++group)
+    {
+        rows.push_back ({ static_cast<int> (group), -1 });
+
+        for (size_t song = 0; song < groups[group].size(); ++song)
+            rows.push_back ({ static_cast<int> (group), static_cast<int> (song) });
+    }
+
+    juce::String heading = groups.empty() ? "No duplicates found"
+                                          : juce::String (groups.size()) + (groups.size() == 1 ? " song has copies" : " songs have copies");
+
+    if (numNotAnalysed > 0)
+        heading << ", " << numNotAnalysed << " not checked yet";
+
+    headingLabel.setText (heading, juce::dontSendNotification);
+    listBox.updateContent();
+    listBox.repaint();
+}
+
+
+// Returns the number of rows in the list
+int DuplicatesPanel::getNumRows()
+{
+    return static_cast<int> (rows.size());
+}
+
+
+// Draws a group heading, or a song's title and details between its actions
+void DuplicatesPanel::paintListBoxItem (int rowNumber, juce::Graphics& g, int width, int height, bool rowIsSelected)
+{
+    if (! juce::isPositiveAndBelow (rowNumber, getNumRows()))
+        return;
+
+    auto& row = rows[(size_t) rowNumber];
+    juce::Rectangle<float> area (0.0f, 0.0f, static_cast<float> (width), static_cast<float> (height));
+
+    if (row.song < 0)
+    {
+        g.fillAll (darkGrey);
+        g.setColour (juce::Colours::lightgrey);
+        g.setFont (juce::Font (13.0f, juce::Font::bold));
+        g.drawText (juce::String (groups[(size_t) row.group].size()) + " copies", area.reduced (5.0f, 0.0f), juce::Justification::centredLeft, true);
+        return;
+    }
+
+    auto& song = groups[(size_t) row.group][(size_t) row.song];
+
+    g.fillAll (rowIsSelected ? juce::Colours::darkblue : juce::Colours::grey);
+
+    customisation.drawTableActionCell (g, area.removeFromRight ((float) actionCellWidth), "Delete", red);
+    customisation.drawTableActionCell (g, area.removeFromRight ((float) actionCellWidth), "Keep", lightGrey);
+
+    area = area.reduced (5.0f, 0.0f);
+
+    g.setColour (juce::Colours::white);
+    g.setFont (14.0f);
+    g.drawText (song.title, area.removeFromTop (area.getHeight() * 0.6f), juce::Justification::bottomLeft, true);
+
+    g.setColour (juce::Colours::lightgrey);
+    g.setFont (10.0f);
+    g.drawText (song.details, area, juce::Justification::topLeft, true);
+}
+
+
+// Keeps or deletes a song when one of its action cells is clicked
+void DuplicatesPanel::listBoxItemClicked (int rowNumber, const juce::MouseEvent& e)
+{
+    if (! juce::isPositiveAndBelow (rowNumber, getNumRows()) || rows[(size_t) rowNumber].song < 0)
+        return;
+
+    auto row = rows[(size_t) rowNumber];
+    auto& group = groups[(size_t) row.group];
+    auto trackId = group[(size_t) row.song].trackId;
+
+    auto x = e.getEventRelativeTo (&listBox).x;
+    auto rowWidth = listBox.getVisibleRowWidth();
+
+    if (x >= rowWidth - actionCellWidth)
+    {
+        group.erase (group.begin() + row.song);
+        updateRows();
+
+        if (onDelete != nullptr)
+            onDelete (trackId);
+    }
+    else if (x >= rowWidth - 2 * actionCellWidth)
+    {
+        confirmMerge (trackId);
+    }
+}
+
+
+/*
+    Asks whether to keep one copy and delete the rest of its group.
+
+    The group is looked up again once the answer comes, as the list may have
+    changed while the box was open.
+
+    @param keptTrackId   The copy whose "Keep" cell was clicked.
+*/
+void DuplicatesPanel::confirmMerge (juce::uint32 keptTrackId)
+{
+    auto isKept = [keptTrackId] (const Song& song) { return song.trackId == keptTrackId; };
+    auto group = std::find_if (groups.begin(), groups.end(), [&isKept] (auto& songs)
+    {
+        return std::any_of (songs.begin(), songs.end(), isKept);
+    });
+
+    if (group == groups.end())
+        return;
+
+    auto& kept = *std::find_if (group -> begin(), group -> end(), isKept);
+    auto numOthers = static_cast<int> (group -> size()) - 1;
+
+    juce::String message;
+    message << "Keep \"" << kept.title << "\" (" << kept.details << ") and move "
+            << numOthers << (numOthers == 1 ? " other copy" : " other copies") << " to the trash?";
+
+    juce::Component::SafePointer<DuplicatesPanel> safeThis (this);
+
+    juce::AlertWindow::showOkCancelBox (juce::MessageBoxIconType::WarningIcon, "Merge duplicates", message,
+                                        "Keep this copy", "Cancel", this,
+                                        juce::ModalCallbackFunction::create ([safeThis, keptTrackId] (int result)
+    {
+        if (safeThis != nullptr && result != 0)
+            safeThis -> mergeGroup (keptTrackId);
+    }));
+}
+
+
+// Drops a song's group from the list and reports the copies to delete
+void DuplicatesPanel::mergeGroup (juce::uint32 keptTrackId)
+{
+    for (auto& group : groups)
+    {
+        if (std::none_of (group.begin(), group.end(), [keptTrackId] (const Song& song) { return song.trackId == keptTrackId; }))
+            continue;
+
+        std::vector<juce::uint32> otherTrackIds;
+
+        for (auto& song : group)
+            if (song.trackId != keptTrackId)
+                otherTrackIds.push_back (song.trackId);
+
+        group.clear();
+        updateRows();
+
+        if (onMerge != nullptr)
+            onMerge (keptTrackId, otherTrackIds);
+
+        return;
+    }
+}
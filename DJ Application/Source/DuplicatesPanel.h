@@ -0,0 +1,98 @@
+/*
+  ==============================================================================
+
+    DuplicatesPanel.h
+    Created: 21 Oct 2026 10:26:51pm
+    Author:  Justin  Lim
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "Customisation.h"
+
+/**
+    Lists the groups of songs that are copies of each other.
+
+    Each group starts with a heading row followed by its songs. A song's "Keep"
+    cell merges the group into that copy, once deleting the other copies is
+    confirmed, and its "Delete" cell deletes just that copy. Groups left with a
+    single song disappear from the list.
+*/
+class DuplicatesPanel : public juce::Component,
+                        public juce::ListBoxModel
+{
+public:
+    /** A copy of a song */
+    struct Song
+    {
+        juce::uint32 trackId = 0;
+        juce::String title;
+        juce::String details;
+    };
+
+    DuplicatesPanel();
+    ~DuplicatesPanel() override;
+
+    void paint (juce::Graphics&) override;
+    void resized() override;
+
+    /** Shows the groups of copies, with a note about songs that are still being fingerprinted */
+    void setGroups (std::vector<std::vector<Song>> newGroups, int numSongsNotAnalysed);
+
+    /** Empties the list, showing a message instead, such as while the groups are being found */
+    void clearGroups (const juce::String& message);
+
+    /** Returns the number of rows in the list */
+    int getNumRows() override;
+
+    /** Draws a group heading, or a song between its actions */
+    void paintListBoxItem (int rowNumber, juce::Graphics& g, int width, int height, bool rowIsSelected) override;
+
+    /** Keeps or deletes a song when one of its action cells is clicked */
+    void listBoxItemClicked (int row, const juce::MouseEvent& e) override;
+
+    /** Called with the copy to keep and the other copies in its group */
+    std::function<void (juce::uint32 keptTrackId, const std::vector<juce::uint32>& otherTrackIds)> onMerge;
+
+    /** Called with a copy to delete */
+    std::function<void (juce::uint32 trackId)> onDelete;
+
+private:
+    // Group and song shown on a row, song is -1 on a group's heading row
+    struct Row
+    {
+        int group = 0;
+        int song = -1;
+    };
+
+    // Rebuilds the rows and heading after the groups changed
+    void updateRows();
+
+    // Asks before merging a song's group into it, as every other copy is deleted
+    void confirmMerge (juce::uint32 keptTrackId);
+
+    // Merges the group a song is in into that song, if it is still listed
+    void mergeGroup (juce::uint32 keptTrackId);
+
+    // Width of the action cells at the end of a song's row
+    static constexpr int actionCellWidth = 44;
+
+    juce::Label headingLabel;
+    juce::ListBox listBox { {}, this };
+
+    std::vector<std::vector<Song>> groups;
+    std::vector<Row> rows;
+    int numNotAnalysed = 0;
+
+    // A customLookAndFeel object to draw the action cells the way the library table does
+    Customisation customisation;
+
+    juce::Colour lightGrey = juce::Colour (61, 61, 61);
+    juce::Colour darkGrey  = juce::Colour (39, 39, 39);
+    juce::Colour red       = juce::Colour (153, 0, 0);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DuplicatesPanel)
+};
@@ -0,0 +1,171 @@
+/*
+  ==============================================================================
+
+    FingerprintAnalyser.cpp
+    Created: 21 Oct 2026 9:12:37pm
+    Author:  Justin  Lim
+
+  ==============================================================================
+*/
+
+#include "FingerprintAnalyser.h"
+
+namespace
+{
+    // Time between frames, and the spacing of the frequency grid the hashes use,
+    // both taken from a 1024 point FFT at 11025 Hz so they match across sample rates
+    constexpr double hopSeconds = 512.0 / 11025.0;
+    constexpr double gridSpacing = 11025.0 / 1024.0;
+
+    // Lowest edge of the octave bands in Hz, the bands reach up to about 5.5 kHz
+    constexpr double lowestBandEdge = 86.0;
+
+    // Length of the fingerprinted stretch, about 20 seconds of frames, must fit in the frame bits of an entry
+    constexpr int maxFrames = 430;
+
+    // Mean square level a frame has to reach to end the leading silence, about -60 dBFS
+    constexpr float silentFrameLevel = 1.0e-6f;
+
+    // A band's strongest bin has to stand this far above the band's recent level to be a peak
+    constexpr float minPeakStrength = 1.5f;
+
+    // How quickly the band levels follow the music
+    constexpr float bandLevelSmoothing = 0.2f;
+
+    // Peaks kept per frame, and pairs made from each peak
+    constexpr size_t maxPeaksPerFrame = 2;
+    constexpr int maxPairsPerAnchor = 3;
+
+    // Furthest a paired peak can be from its anchor, in frames, the distance has five bits of the hash
+    constexpr int maxPairDistance = 31;
+
+    // Fewest distinct entries worth keeping as a fingerprint
+    constexpr size_t minEntries = 30;
+}
+
+//==============================================================================
+// Works out the hop, frequency grid and band edges for the rate the audio is decimated to
+FingerprintAnalyser::FingerprintAnalyser (double analysisRate)
+    : fftData (2 * fftSize, 0.0f)
+{
+    static_assert (maxFrames <= (1 << frameBits), "Frames must fit in the frame bits of an entry");
+    static_assert (maxPairDistance < (1 << 5), "Pair distances must fit in the distance bits of a hash");
+
+    auto binWidth = analysisRate / fftSize;
+
+    hopSize = juce::jlimit (1, fftSize, juce::roundToInt (analysisRate * hopSeconds));
+    binsToGrid = binWidth / gridSpacing;
+
+    for (size_t edge = 0; edge < bandEdges.size(); ++edge)
+        bandEdges[edge] = juce::jlimit (1, fftSize / 2, juce::roundToInt (lowestBandEdge * (1 << edge) / binWidth));
+
+    frame.reserve (fftSize);
+    entries.reserve ((size_t) maxFrames * maxPeaksPerFrame * maxPairsPerAnchor);
+}
+
+
+// Adds a block of decimated samples to the frame buffer
+void FingerprintAnalyser::process (const float* samples, int numSamples)
+{
+    for (int i = 0; i < numSamples && numFrames < maxFrames; ++i)
+    {
+        frame.push_back (samples[i]);
+
+        if (static_cast<int> (frame.size()) == fftSize)
+        {
+            processFrame();
+            frame.erase (frame.begin(), frame.begin() + hopSize);
+        }
+    }
+}
+
+
+/*
+    Picks the strongest peaks of a frame and hashes them against earlier peaks.
+
+    Each octave band offers its strongest bin, which counts as a peak when it stands
+    out from that band's recent level. Measuring peaks against the music around them
+    rather than a fixed threshold keeps the same peaks whatever the track's gain.
+*/
+void FingerprintAnalyser::processFrame()
+{
+    if (! hasStarted)
+    {
+        float level = 0.0f;
+
+        for (auto sample : frame)
+            level += sample * sample;
+
+        if (level / fftSize < silentFrameLevel)
+            return;
+
+        hasStarted = true;
+    }
+
+    std::fill (fftData.begin(), fftData.end(), 0.0f);
+    std::copy (frame.begin(), frame.end(), fftData.begin());
+
+    window.multiplyWithWindowingTable (fftData.data(), fftSize);
+    fft.performFrequencyOnlyForwardTransform (fftData.data());
+
+    // Strength and bin of each band's candidate peak
+    std::array<std::pair<float, int>, numBands> candidates;
+
+    for (size_t band = 0; band < (size_t) numBands; ++band)
+    {
+        auto* first = fftData.data() + bandEdges[band];
+        auto* strongest = std::max_element (first, juce::jmax (first + 1, fftData.data() + bandEdges[band + 1]));
+        auto& level = bandLevels[band];
+
+        candidates[band] = { level > 0.0f ? *strongest / level : 0.0f, static_cast<int> (strongest - fftData.data()) };
+        level = level > 0.0f ? level + bandLevelSmoothing * (*strongest - level) : *strongest;
+    }
+
+    std::sort (candidates.begin(), candidates.end(), [] (auto& a, auto& b) { return a.first > b.first; });
+
+    // Pair the new peaks with the anchors before them, then make them anchors themselves
+    std::vector<juce::uint32> frequencies;
+
+    for (size_t i = 0; i < maxPeaksPerFrame && candidates[i].first >= minPeakStrength; ++i)
+        frequencies.push_back ((juce::uint32) juce::jmin (511, juce::roundToInt (candidates[i].second * binsToGrid)));
+
+    for (auto frequency : frequencies)
+    {
+        for (auto& anchor : anchors)
+        {
+            if (anchor.numPairs >= maxPairsPerAnchor)
+                continue;
+
+            auto distance = static_cast<juce::uint32> (numFrames - anchor.frame);
+            auto hash = (anchor.frequency << 14) | (frequency << 5) | distance;
+
+            entries.push_back ((hash << frameBits) | (juce::uint32) anchor.frame);
+            ++anchor.numPairs;
+        }
+    }
+
+    for (auto frequency : frequencies)
+        anchors.push_back ({ numFrames, frequency, 0 });
+
+    // Anchors are dropped before the next frame would be too far from them to pair with
+    anchors.erase (std::remove_if (anchors.begin(), anchors.end(), [this] (const Anchor& anchor)
+    {
+        return anchor.numPairs >= maxPairsPerAnchor || numFrames + 1 - anchor.frame > maxPairDistance;
+    }), anchors.end());
+
+    ++numFrames;
+}
+
+
+// Returns the distinct entries found so far in ascending order
+std::vector<juce::uint32> FingerprintAnalyser::getFingerprint() const
+{
+    auto fingerprint = entries;
+    std::sort (fingerprint.begin(), fingerprint.end());
+    fingerprint.erase (std::unique (fingerprint.begin(), fingerprint.end()), fingerprint.end());
+
+    if (fingerprint.size() < minEntries)
+        fingerprint.clear();
+
+    return fingerprint;
+}
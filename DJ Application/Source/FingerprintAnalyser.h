@@ -0,0 +1,93 @@
+/*
+  ==============================================================================
+
+    FingerprintAnalyser.h
+    Created: 21 Oct 2026 9:12:37pm
+    Author:  Justin  Lim
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/**
+    Computes an acoustic fingerprint of a track for finding duplicate copies.
+
+    Works on the track mixed to mono at about 11 kHz. Every 46 ms the
+    strongest spectral peaks, relative to the recent level of their octave, are
+    picked, and each peak is paired with the next few peaks after it. A pair hashes
+    to its two frequencies and the time between them, which survives re-encoding,
+    resampling and gain changes. Only the first 20 seconds after any leading
+    silence are fingerprinted, which is enough to tell songs apart and keeps the
+    fingerprint small.
+
+    Each entry of a fingerprint packs a hash with the frame its first peak was in,
+    so copies can be told apart from songs that merely share some hashes by how
+    their matching entries line up in time.
+
+    Feed the track in order with process(), then call getFingerprint().
+*/
+class FingerprintAnalyser
+{
+public:
+    /** Low bits of a fingerprint entry that hold its frame, the bits above hold its hash */
+    static constexpr int frameBits = 9;
+
+    /** Returns the hash of a fingerprint entry */
+    static juce::uint32 getHash (juce::uint32 entry)      { return entry >> frameBits; }
+
+    /** Returns the frame of a fingerprint entry */
+    static int getFrame (juce::uint32 entry)              { return static_cast<int> (entry & ((1u << frameBits) - 1)); }
+
+    FingerprintAnalyser (double analysisRate);
+
+    /** Adds the next block of the track, mixed to mono and decimated by an AnalysisDecimator; blocks after the fingerprinted stretch are ignored */
+    void process (const float* samples, int numSamples);
+
+    /** Returns the distinct entries found so far in ascending order, empty if the track was too short or silent */
+    std::vector<juce::uint32> getFingerprint() const;
+
+private:
+    // Picks the peaks of the frame in the frame buffer and pairs them with earlier peaks
+    void processFrame();
+
+    static constexpr int fftOrder = 10;
+    static constexpr int fftSize = 1 << fftOrder;
+    static constexpr int numBands = 6;
+
+    // A peak still waiting to be paired with later peaks
+    struct Anchor
+    {
+        int frame = 0;
+        juce::uint32 frequency = 0;
+        int numPairs = 0;
+    };
+
+    // Samples between frames, about 46 ms whatever the sample rate
+    int hopSize = fftSize / 2;
+
+    // Width of a bin in units of the fixed frequency grid the hashes use
+    double binsToGrid = 1.0;
+
+    // Octave bands the peaks are picked from, as FFT bins
+    std::array<int, numBands + 1> bandEdges {};
+
+    std::vector<float> frame;
+    juce::dsp::FFT fft { fftOrder };
+    juce::dsp::WindowingFunction<float> window { fftSize, juce::dsp::WindowingFunction<float>::hann, false };
+    std::vector<float> fftData;
+
+    // Recent level of each band's strongest bin, peaks are picked relative to it
+    std::array<float, numBands> bandLevels {};
+
+    std::vector<Anchor> anchors;
+    std::vector<juce::uint32> entries;
+
+    // Frames fingerprinted so far, counted from the first frame that is not silent
+    int numFrames = 0;
+    bool hasStarted = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FingerprintAnalyser)
+};
@@ -0,0 +1,192 @@
+/*
+  ==============================================================================
+
+    FingerprintIndex.cpp
+    Created: 21 Oct 2026 9:48:02pm
+    Author:  Justin  Lim
+
+  ==============================================================================
+*/
+
+#include "FingerprintIndex.h"
+
+namespace
+{
+    // Hashes occurring more often than this across the library are too common to identify a song
+    constexpr size_t maxPostingsPerHash = 200;
+
+    // Fewest matching hashes for two songs to count as copies, however short their fingerprints
+    constexpr int minMatchingHashes = 20;
+
+    // Offsets are stored shifted by this much so that they are never negative
+    constexpr int offsetBias = 1 << FingerprintAnalyser::frameBits;
+
+    // Finds the group a song belongs to, flattening the path as it goes
+    juce::uint32 findGroup (std::unordered_map<juce::uint32, juce::uint32>& parents, juce::uint32 key)
+    {
+        auto root = key;
+
+        while (parents[root] != root)
+            root = parents[root];
+
+        while (parents[key] != root)
+            key = std::exchange (parents[key], root);
+
+        return root;
+    }
+}
+
+//==============================================================================
+// Adds or replaces the fingerprint of a song
+void FingerprintIndex::update (juce::uint32 key, const std::vector<juce::uint32>& fingerprint)
+{
+    remove (key);
+
+    if (fingerprint.empty())
+        return;
+
+    for (auto entry : fingerprint)
+        postingsByHash[FingerprintAnalyser::getHash (entry)].push_back ({ key, FingerprintAnalyser::getFrame (entry) });
+
+    fingerprints[key] = fingerprint;
+}
+
+
+// Removes a song and its postings
+void FingerprintIndex::remove (juce::uint32 key)
+{
+    auto existing = fingerprints.find (key);
+
+    if (existing == fingerprints.end())
+        return;
+
+    for (auto entry : existing -> second)
+    {
+        auto found = postingsByHash.find (FingerprintAnalyser::getHash (entry));
+
+        if (found == postingsByHash.end())
+            continue;
+
+        auto& postings = found -> second;
+        postings.erase (std::remove_if (postings.begin(), postings.end(), [key] (const Posting& p) { return p.key == key; }),
+                        postings.end());
+
+        if (postings.empty())
+            postingsByHash.erase (found);
+    }
+
+    fingerprints.erase (existing);
+}
+
+
+// Removes every song
+void FingerprintIndex::clear()
+{
+    fingerprints.clear();
+    postingsByHash.clear();
+}
+
+
+// Returns the number of songs with fingerprints
+int FingerprintIndex::size() const
+{
+    return static_cast<int> (fingerprints.size());
+}
+
+
+// Copies the fingerprints and postings so a duplicate search can run off the message thread
+std::shared_ptr<const FingerprintIndex> FingerprintIndex::createSnapshot() const
+{
+    auto snapshot = std::make_shared<FingerprintIndex>();
+    snapshot -> fingerprints = fingerprints;
+    snapshot -> postingsByHash = postingsByHash;
+    return snapshot;
+}
+
+
+/*
+    Groups the songs that are copies of each other.
+
+    For each song, the matching hashes of every other song are counted by the time
+    offset they match at. A song's best offset, together with its neighbours to
+    allow for a frame of jitter, gives the number of hashes that line up. Each pair
+    of songs is only counted from the song with the smaller key, so every pair is
+    looked at once.
+
+    @param minMatchingFraction   Fraction of the smaller fingerprint that has to line up for two songs to be copies.
+
+    @return                      Groups of two or more songs, each sorted by key, largest groups first.
+*/
+std::vector<std::vector<juce::uint32>> FingerprintIndex::findDuplicates (double minMatchingFraction) const
+{
+    std::unordered_map<juce::uint32, juce::uint32> parents;
+
+    // Matching hashes by other song and offset, packed as (key << 16) | (offset + offsetBias)
+    std::unordered_map<juce::uint64, int> matchesAtOffset;
+    std::unordered_map<juce::uint32, int> bestMatches;
+
+    auto countAt = [&matchesAtOffset] (juce::uint64 packed)
+    {
+        auto found = matchesAtOffset.find (packed);
+        return found != matchesAtOffset.end() ? found -> second : 0;
+    };
+
+    for (auto& [key, fingerprint] : fingerprints)
+    {
+        matchesAtOffset.clear();
+        bestMatches.clear();
+
+        for (auto entry : fingerprint)
+        {
+            auto& postings = postingsByHash.at (FingerprintAnalyser::getHash (entry));
+
+            if (postings.size() > maxPostingsPerHash)
+                continue;
+
+            auto frame = FingerprintAnalyser::getFrame (entry);
+
+            for (auto& posting : postings)
+                if (posting.key > key)
+                    ++matchesAtOffset[((juce::uint64) posting.key << 16) | (juce::uint64) (posting.frame - frame + offsetBias)];
+        }
+
+        for (auto [packed, count] : matchesAtOffset)
+        {
+            auto other = static_cast<juce::uint32> (packed >> 16);
+            auto& best = bestMatches[other];
+            best = juce::jmax (best, count + countAt (packed - 1) + countAt (packed + 1));
+        }
+
+        for (auto [other, numMatching] : bestMatches)
+        {
+            auto smallerSize = juce::jmin (fingerprint.size(), fingerprints.at (other).size());
+
+            if (numMatching < minMatchingHashes || numMatching < minMatchingFraction * (double) smallerSize)
+                continue;
+
+            parents.emplace (key, key);
+            parents.emplace (other, other);
+            parents[findGroup (parents, other)] = findGroup (parents, key);
+        }
+    }
+
+    std::unordered_map<juce::uint32, std::vector<juce::uint32>> groupsByRoot;
+
+    for (auto& entry : parents)
+        groupsByRoot[findGroup (parents, entry.first)].push_back (entry.first);
+
+    std::vector<std::vector<juce::uint32>> groups;
+
+    for (auto& entry : groupsByRoot)
+    {
+        std::sort (entry.second.begin(), entry.second.end());
+        groups.push_back (std::move (entry.second));
+    }
+
+    std::sort (groups.begin(), groups.end(), [] (auto& a, auto& b)
+    {
+        return a.size() != b.size() ? a.size() > b.size() : a.front() < b.front();
+    });
+
+    return groups;
+}
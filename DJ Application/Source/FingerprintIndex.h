@@ -0,0 +1,67 @@
+/*
+  ==============================================================================
+
+    FingerprintIndex.h
+    Created: 21 Oct 2026 9:48:02pm
+    Author:  Justin  Lim
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "FingerprintAnalyser.h"
+
+/**
+    Inverted index from fingerprint hashes to the songs and frames they occur at.
+
+    Finding duplicates looks up each song's hashes and counts, for every other song
+    and every time offset between the two, how many hashes match at that offset.
+    Songs that merely share hashes spread their matches over many offsets, copies
+    pile them up on one. Two songs are copies of each other when enough of the
+    smaller fingerprint lines up, and copies are grouped transitively, so a song and
+    two re-encodings of it form one group. Hashes that occur in a great many songs
+    say little and are skipped, which keeps a whole-library pass fast.
+
+    Songs are identified by the caller's key, such as a track id.
+*/
+class FingerprintIndex
+{
+public:
+    FingerprintIndex() = default;
+
+    /** Adds or replaces the fingerprint of a song, a song without a fingerprint is removed */
+    void update (juce::uint32 key, const std::vector<juce::uint32>& fingerprint);
+
+    /** Removes a song */
+    void remove (juce::uint32 key);
+
+    /** Removes every song */
+    void clear();
+
+    /** Returns the number of songs with fingerprints */
+    int size() const;
+
+    /** Returns a copy of the index that can be searched on another thread while this one keeps changing */
+    std::shared_ptr<const FingerprintIndex> createSnapshot() const;
+
+    /** Returns the groups of songs that are copies of each other, each group sorted by key, largest groups first */
+    std::vector<std::vector<juce::uint32>> findDuplicates (double minMatchingFraction = 0.2) const;
+
+private:
+    // A song a hash occurs in, and the frame it occurs at
+    struct Posting
+    {
+        juce::uint32 key = 0;
+        int frame = 0;
+    };
+
+    // Fingerprint of every song, entries in ascending order
+    std::unordered_map<juce::uint32, std::vector<juce::uint32>> fingerprints;
+
+    // Where each hash occurs
+    std::unordered_map<juce::uint32, std::vector<Posting>> postingsByHash;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FingerprintIndex)
+};
@@ -0,0 +1,231 @@
+/*
+  ==============================================================================
+
+    FrameProfiler.cpp
+    Created: 23 Oct 2026 10:04:37am
+    Author:  Justin  Lim
+
+  ==============================================================================
+*/
+
+#include "FrameProfiler.h"
+
+JUCE_IMPLEMENT_SINGLETON (FrameProfiler)
+
+bool FrameProfiler::enabled = false;
+
+FrameProfiler::~FrameProfiler()
+{
+    enabled = false;
+    clearSingletonInstance();
+}
+
+
+// Turns measuring on or off, the windows start again from empty
+void FrameProfiler::setEnabled (bool shouldBeEnabled)
+{
+    if (! shouldBeEnabled && tracing)
+        stopTrace();
+
+    enabled = shouldBeEnabled;
+
+    currentWindow.clear();
+    lastWindow.clear();
+    currentLatency.reset();
+    lastLatency.reset();
+    windowStartMs = juce::Time::getMillisecondCounterHiRes();
+}
+
+
+// Adds a section to the current window, and to the trace while one is recording
+void FrameProfiler::addSection (const char* name, double startMs, double endMs)
+{
+    auto duration = endMs - startMs;
+    auto& totals = currentWindow[name];
+
+    ++totals.count;
+    totals.totalMs += duration;
+    totals.maxMs = juce::jmax (totals.maxMs, duration);
+
+    if (tracing && traceEvents.size() < maxTraceEvents)
+        traceEvents.push_back ({ name, 'X', startMs, duration });
+}
+
+
+// Counts an event that has no duration
+void FrameProfiler::addEvent (const char* name)
+{
+    if (! enabled)
+        return;
+
+    ++currentWindow[name].count;
+
+    if (tracing && traceEvents.size() < maxTraceEvents)
+        traceEvents.push_back ({ name, 'i', juce::Time::getMillisecondCounterHiRes(), 0.0 });
+}
+
+
+// Adds how long a message waited before it ran
+void FrameProfiler::addMessageLatency (double milliseconds)
+{
+    if (! enabled)
+        return;
+
+    currentLatency.addValue (milliseconds);
+
+    if (tracing && traceEvents.size() < maxTraceEvents)
+        traceEvents.push_back ({ "message latency", 'C', juce::Time::getMillisecondCounterHiRes(), milliseconds });
+}
+
+
+// Closes the current window once a second has passed
+void FrameProfiler::update()
+{
+    auto now = juce::Time::getMillisecondCounterHiRes();
+
+    if (now - windowStartMs < 1000.0)
+        return;
+
+    // Totals are per second, so a window that ran long because the thread stalled is scaled down to one
+    auto scale = 1000.0 / (now - windowStartMs);
+
+    lastWindow.clear();
+
+    for (auto& section : currentWindow)
+    {
+        auto& totals = lastWindow[section.first];
+        totals.count = juce::roundToInt (section.second.count * scale);
+        totals.totalMs = section.second.totalMs * scale;
+        totals.maxMs = section.second.maxMs;
+    }
+
+    lastLatency = currentLatency;
+
+    currentWindow.clear();
+    currentLatency.reset();
+    windowStartMs = now;
+}
+
+
+// Returns the sections of the last complete second, merging sections with the same name, slowest in total first
+std::vector<FrameProfiler::SectionStats> FrameProfiler::getSectionStats() const
+{
+    std::vector<SectionStats> stats;
+
+    for (auto& section : lastWindow)
+    {
+        auto name = juce::String (section.first);
+        auto existing = std::find_if (stats.begin(), stats.end(), [&] (const SectionStats& s) { return s.name == name; });
+
+        if (existing == stats.end())
+            existing = stats.insert (stats.end(), SectionStats { name });
+
+        existing -> count += section.second.count;
+        existing -> totalMs += section.second.totalMs;
+        existing -> maxMs = juce::jmax (existing -> maxMs, section.second.maxMs);
+    }
+
+    std::sort (stats.begin(), stats.end(), [] (const SectionStats& a, const SectionStats& b)
+    {
+        return a.totalMs > b.totalMs || (a.totalMs == b.totalMs && a.name < b.name);
+    });
+
+    return stats;
+}
+
+
+// Returns the average and worst message latency of the last complete second
+juce::Range<double> FrameProfiler::getMessageLatency() const
+{
+    if (lastLatency.getCount() == 0)
+        return {};
+
+    return { lastLatency.getAverage(), lastLatency.getMaxValue() };
+}
+
+
+// Starts keeping every section for a trace
+void FrameProfiler::startTrace()
+{
+    if (! enabled)
+        setEnabled (true);
+
+    traceEvents.clear();
+    traceEvents.reserve (65536);
+    traceStartMs = juce::Time::getMillisecondCounterHiRes();
+    tracing = true;
+}
+
+
+/*
+    Writes the recorded trace in the Trace Event Format and stops recording.
+
+    Sections become complete events, counted events become instant events and
+    the latency samples become a counter track, all on one thread of one process,
+    with times in microseconds from the start of the trace.
+
+    @return     The file written, or an empty file if nothing was recording or it could not be written.
+*/
+juce::File FrameProfiler::stopTrace()
+{
+    if (! tracing)
+        return {};
+
+    tracing = false;
+
+    auto folder = juce::File::getSpecialLocation (juce::File::userDocumentsDirectory).getChildFile ("DJ Application Traces");
+    auto file = folder.getChildFile ("UI trace " + juce::Time::getCurrentTime().formatted ("%Y-%m-%d %H-%M-%S") + ".json");
+
+    std::unique_ptr<juce::FileOutputStream> stream;
+
+    if (folder.createDirectory().wasOk())
+        stream = file.createOutputStream();
+
+    if (stream == nullptr || ! stream -> openedOk())
+    {
+        DBG ("FrameProfiler::stopTrace could not write " << file.getFullPathName());
+        traceEvents.clear();
+        return {};
+    }
+
+    stream -> setPosition (0);
+    stream -> truncate();
+
+    auto& out = *stream;
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n"
+        << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"Message thread\"}}";
+
+    for (auto& event : traceEvents)
+    {
+        auto timestamp = juce::String ((event.startMs - traceStartMs) * 1000.0, 1);
+
+        out << ",\n{\"name\":" << juce::JSON::toString (juce::String (event.name)) << ",\"ph\":\"" << juce::String::charToString (event.phase)
+            << "\",\"ts\":" << timestamp << ",\"pid\":1,\"tid\":1";
+
+        if (event.phase == 'X')
+            out << ",\"cat\":\"ui\",\"dur\":" << juce::String (event.value * 1000.0, 1);
+        else if (event.phase == 'i')
+            out << ",\"cat\":\"ui\",\"s\":\"t\"";
+        else
+            out << ",\"args\":{\"ms\":" << juce::String (event.value, 3) << "}";
+
+        out << "}";
+    }
+
+    out << "\n]}\n";
+    out.flush();
+
+    DBG ("FrameProfiler::stopTrace wrote " << traceEvents.size() << " events to " << file.getFullPathName());
+
+    traceEvents.clear();
+    traceEvents.shrink_to_fit();
+
+    return file;
+}
+
+
+// Returns true while a trace is recording
+bool FrameProfiler::isTracing() const
+{
+    return tracing;
+}
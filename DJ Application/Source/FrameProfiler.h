@@ -0,0 +1,131 @@
+/*
+  ==============================================================================
+
+    FrameProfiler.h
+    Created: 23 Oct 2026 10:04:37am
+    Author:  Justin  Lim
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/**
+    Measures where the message thread spends its time drawing the UI.
+
+    Paint routines and look-and-feel draw calls open a ScopedSection named after
+    themselves. While profiling is on, the sections are totalled over one second
+    windows for the overlay, and while a trace is recording every section is also
+    kept so it can be written as a JSON trace that Chrome's trace viewer and
+    Perfetto open. With profiling off a section costs a single flag check.
+
+    Everything here runs on the message thread.
+*/
+class FrameProfiler : public juce::DeletedAtShutdown
+{
+public:
+    /** Totals for one section over the last complete second */
+    struct SectionStats
+    {
+        juce::String name;
+        int count = 0;              // times the section ran, the repaint count for a paint routine
+        double totalMs = 0.0;
+        double maxMs = 0.0;
+    };
+
+    /** Times the enclosing scope as a named section, the name must be a string literal */
+    class ScopedSection
+    {
+    public:
+        explicit ScopedSection (const char* sectionName) noexcept
+            : name (sectionName),
+              startMs (isEnabled() ? juce::Time::getMillisecondCounterHiRes() : 0.0)
+        {
+        }
+
+        ~ScopedSection()
+        {
+            if (startMs > 0.0 && isEnabled())
+                getInstance() -> addSection (name, startMs, juce::Time::getMillisecondCounterHiRes());
+        }
+
+    private:
+        const char* name;
+        double startMs;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedSection)
+    };
+
+    FrameProfiler() = default;
+    ~FrameProfiler() override;
+
+    JUCE_DECLARE_SINGLETON_SINGLETHREADED (FrameProfiler, true)
+
+    /** Returns true while sections are being measured */
+    static bool isEnabled() noexcept    { return enabled; }
+
+    /** Turns measuring on or off, turning it off also stops a trace that is recording */
+    void setEnabled (bool shouldBeEnabled);
+
+    /** Adds a section that ran between two times on juce::Time::getMillisecondCounterHiRes() */
+    void addSection (const char* name, double startMs, double endMs);
+
+    /** Counts an event that has no duration, such as a change message */
+    void addEvent (const char* name);
+
+    /** Adds how long a message posted to the message thread waited before it ran */
+    void addMessageLatency (double milliseconds);
+
+    /** Closes the current window once a second has passed, so the stats cover the last complete second */
+    void update();
+
+    /** Returns the sections of the last complete second, slowest in total first */
+    std::vector<SectionStats> getSectionStats() const;
+
+    /** Returns the average and worst message latency of the last complete second, in milliseconds */
+    juce::Range<double> getMessageLatency() const;
+
+    /** Starts keeping every section for a trace, turning profiling on if it is off */
+    void startTrace();
+
+    /** Writes the trace recorded so far to a JSON file and stops recording, returns the file or an empty one on failure */
+    juce::File stopTrace();
+
+    /** Returns true while a trace is recording */
+    bool isTracing() const;
+
+private:
+    struct Totals
+    {
+        int count = 0;
+        double totalMs = 0.0;
+        double maxMs = 0.0;
+    };
+
+    struct TraceEvent
+    {
+        const char* name;
+        char phase;                 // 'X' for a section, 'i' for an event, 'C' for a latency sample
+        double startMs;
+        double value;               // duration of a section, or the latency of a sample
+    };
+
+    // Most events a trace keeps, about a minute of a busy UI, so a forgotten trace cannot eat the memory
+    static constexpr size_t maxTraceEvents = 2000000;
+
+    static bool enabled;
+
+    // Sections are keyed by their literal, the same name from two files is merged when the stats are read
+    std::unordered_map<const char*, Totals> currentWindow, lastWindow;
+    double windowStartMs = 0.0;
+
+    juce::StatisticsAccumulator<double> currentLatency, lastLatency;
+
+    bool tracing = false;
+    double traceStartMs = 0.0;
+    std::vector<TraceEvent> traceEvents;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FrameProfiler)
+};
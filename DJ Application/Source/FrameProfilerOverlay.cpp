@@ -0,0 +1,127 @@
+/*
+  ==============================================================================
+
+    FrameProfilerOverlay.cpp
+    Created: 23 Oct 2026 10:52:18am
+    Author:  Justin  Lim
+
+  ==============================================================================
+*/
+
+#include "FrameProfilerOverlay.h"
+
+FrameProfilerOverlay::FrameProfilerOverlay (RefreshScheduler& _refreshScheduler)
+    : refreshScheduler (_refreshScheduler)
+{
+    setInterceptsMouseClicks (false, false);
+    setAlwaysOnTop (true);
+}
+
+FrameProfilerOverlay::~FrameProfilerOverlay()
+{
+    stopTimer();
+}
+
+
+// Figures on a translucent panel, one line per section
+void FrameProfilerOverlay::paint (juce::Graphics& g)
+{
+    g.setColour (juce::Colours::black.withAlpha (0.75f));
+    g.fillRoundedRectangle (getLocalBounds().toFloat(), 4.0f);
+
+    g.setFont (font);
+
+    auto area = getLocalBounds().reduced (6, 4);
+    auto drawLine = [&] (const juce::String& text, juce::Colour colour)
+    {
+        g.setColour (colour);
+        g.drawText (text, area.removeFromTop (lineHeight), juce::Justification::centredLeft, false);
+    };
+
+    drawLine ("F12 hide   Shift+F12 trace" + (traceStatus.isEmpty() ? juce::String() : "   " + traceStatus), juce::Colours::orange);
+    drawLine ("refresh " + juce::String (refreshScheduler.getLastFrameTime(), 2) + " / " + juce::String (refreshScheduler.getFrameBudget(), 1)
+              + " ms   deferred " + juce::String (refreshScheduler.getNumDeferredClients()), juce::Colours::white);
+    drawLine ("message latency " + juce::String (messageLatency.getStart(), 2) + " avg  " + juce::String (messageLatency.getEnd(), 2) + " max ms",
+              juce::Colours::white);
+    drawLine (juce::String ("section").paddedRight (' ', 36) + "  ms/s    max ms   per s", juce::Colours::lightgrey);
+
+    for (size_t i = 0; i < sections.size() && i < (size_t) maxSections; ++i)
+    {
+        auto& section = sections[i];
+
+        drawLine (section.name.paddedRight (' ', 36).substring (0, 36)
+                  + juce::String (section.totalMs, 2).paddedLeft (' ', 7)
+                  + juce::String (section.maxMs, 2).paddedLeft (' ', 10)
+                  + juce::String (section.count).paddedLeft (' ', 8),
+                  section.totalMs > 4.0 ? juce::Colours::orangered : juce::Colours::white);
+    }
+}
+
+
+// Shows the overlay and starts profiling, or hides it and stops
+void FrameProfilerOverlay::setProfiling (bool shouldProfile)
+{
+    FrameProfiler::getInstance() -> setEnabled (shouldProfile);
+
+    sections.clear();
+    messageLatency = {};
+    traceStatus.clear();
+
+    setVisible (shouldProfile);
+
+    if (shouldProfile)
+        startTimer (250);
+    else
+        stopTimer();
+}
+
+
+// Starts recording a trace, or stops and writes the one recording, showing the overlay while it records
+void FrameProfilerOverlay::toggleTrace()
+{
+    auto* profiler = FrameProfiler::getInstance();
+
+    if (profiler -> isTracing())
+    {
+        auto file = profiler -> stopTrace();
+        traceStatus = file == juce::File() ? "trace could not be written" : "wrote " + file.getFileName();
+    }
+    else
+    {
+        if (! isVisible())
+            setProfiling (true);
+
+        profiler -> startTrace();
+        traceStatus = "recording trace";
+    }
+
+    repaint();
+}
+
+
+// Returns the height the overlay needs to show its lines
+int FrameProfilerOverlay::getPreferredHeight() const
+{
+    return (4 + maxSections) * lineHeight + 8;
+}
+
+
+// Posts a probe that measures how long the message queue holds it, then refreshes the figures
+void FrameProfilerOverlay::timerCallback()
+{
+    auto postedMs = juce::Time::getMillisecondCounterHiRes();
+
+    juce::MessageManager::callAsync ([postedMs]
+    {
+        if (FrameProfiler::isEnabled())
+            FrameProfiler::getInstance() -> addMessageLatency (juce::Time::getMillisecondCounterHiRes() - postedMs);
+    });
+
+    auto* profiler = FrameProfiler::getInstance();
+    profiler -> update();
+
+    sections = profiler -> getSectionStats();
+    messageLatency = profiler -> getMessageLatency();
+
+    repaint();
+}
@@ -0,0 +1,61 @@
+/*
+  ==============================================================================
+
+    FrameProfilerOverlay.h
+    Created: 23 Oct 2026 10:52:18am
+    Author:  Justin  Lim
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "FrameProfiler.h"
+#include "RefreshScheduler.h"
+
+/**
+    Debug overlay showing the FrameProfiler's measurements on top of the UI.
+
+    Lists the time spent in each paint routine and draw call over the last second
+    with how often it ran, the refresh scheduler's cost per frame and how long
+    messages wait before the message thread runs them. Profiling is on while the
+    overlay is shown. The overlay ignores the mouse so the UI underneath stays
+    usable.
+*/
+class FrameProfilerOverlay : public juce::Component,
+                             private juce::Timer
+{
+public:
+    explicit FrameProfilerOverlay (RefreshScheduler& refreshScheduler);
+    ~FrameProfilerOverlay() override;
+
+    void paint (juce::Graphics&) override;
+
+    /** Shows the overlay and starts profiling, or hides it and stops */
+    void setProfiling (bool shouldProfile);
+
+    /** Starts recording a trace, or stops and writes the one recording */
+    void toggleTrace();
+
+    /** Returns the height the overlay needs to show its lines */
+    int getPreferredHeight() const;
+
+private:
+    // Posts a latency probe and refreshes the figures
+    void timerCallback() override;
+
+    // Sections listed, the slowest ones
+    static constexpr int maxSections = 12;
+    static constexpr int lineHeight = 15;
+
+    RefreshScheduler& refreshScheduler;
+
+    std::vector<FrameProfiler::SectionStats> sections;
+    juce::Range<double> messageLatency;
+    juce::String traceStatus;
+
+    juce::Font font { juce::Font::getDefaultMonospacedFontName(), 12.0f, juce::Font::plain };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FrameProfilerOverlay)
+};
@@ -0,0 +1,97 @@
+/*
+  ==============================================================================
+
+    HarmonicMixIndex.cpp
+    Created: 21 Oct 2026 5:03:52pm
+    Author:  Justin  Lim
+
+  ==============================================================================
+*/
+
+#include "HarmonicMixIndex.h"
+
+//==============================================================================
+// Inserts a song into its key's bucket at its tempo, taking it out of the bucket it was in before
+void HarmonicMixIndex::update (juce::uint32 key, MusicalKey musicalKey, double bpm)
+{
+    remove (key);
+
+    if (! musicalKey.isValid() || bpm <= 0.0)
+        return;
+
+    Song song;
+    song.bpm = static_cast<float> (bpm);
+    song.key = key;
+
+    auto& bucket = buckets[(size_t) musicalKey.index];
+    bucket.insert (std::upper_bound (bucket.begin(), bucket.end(), song), song);
+
+    placeOfKey[key] = { musicalKey.index, song.bpm };
+}
+
+
+// Removes a song from its bucket
+void HarmonicMixIndex::remove (juce::uint32 key)
+{
+    auto place = placeOfKey.find (key);
+
+    if (place == placeOfKey.end())
+        return;
+
+    Song song;
+    song.bpm = place -> second.second;
+    song.key = key;
+
+    auto& bucket = buckets[(size_t) place -> second.first];
+    auto it = std::lower_bound (bucket.begin(), bucket.end(), song);
+
+    if (it != bucket.end() && it -> key == key)
+        bucket.erase (it);
+
+    placeOfKey.erase (place);
+}
+
+
+// Removes every song
+void HarmonicMixIndex::clear()
+{
+    for (auto& bucket : buckets)
+        bucket.clear();
+
+    placeOfKey.clear();
+}
+
+
+/*
+    Finds the songs that can be mixed into a song.
+
+    @param musicalKey        Key of the song playing.
+    @param bpm               Tempo of the song playing.
+    @param tempoTolerance    Largest tempo difference as a fraction of bpm.
+
+    @return                  Keys of the songs in the same key, its relative key or a fifth
+                             either side, whose tempo is within the tolerance.
+*/
+std::vector<juce::uint32> HarmonicMixIndex::findCompatible (MusicalKey musicalKey, double bpm, double tempoTolerance) const
+{
+    std::vector<juce::uint32> results;
+
+    if (! musicalKey.isValid() || bpm <= 0.0)
+        return results;
+
+    auto lowest = static_cast<float> (bpm * (1.0 - tempoTolerance));
+    auto highest = static_cast<float> (bpm * (1.0 + tempoTolerance));
+
+    for (auto compatibleKey : musicalKey.getCompatibleKeys())
+    {
+        auto& bucket = buckets[(size_t) compatibleKey.index];
+
+        auto first = std::lower_bound (bucket.begin(), bucket.end(), lowest, [] (const Song& song, float value) { return song.bpm < value; });
+        auto last = std::upper_bound (first, bucket.end(), highest, [] (float value, const Song& song) { return value < song.bpm; });
+
+        for (auto it = first; it != last; ++it)
+            results.push_back (it -> key);
+    }
+
+    return results;
+}
@@ -0,0 +1,58 @@
+/*
+  ==============================================================================
+
+    HarmonicMixIndex.h
+    Created: 21 Oct 2026 5:03:52pm
+    Author:  Justin  Lim
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "KeyAnalyser.h"
+
+/**
+    Index of songs by key and tempo, for finding the songs that mix well with another.
+
+    Songs are bucketed by key, and each bucket is kept sorted by tempo. A query
+    looks in the four buckets of the Camelot-compatible keys and binary searches
+    each for the tempo range, so it only touches the songs it returns. Songs
+    without a key or tempo are left out of every bucket.
+
+    Songs are identified by the caller's key, such as a track id.
+*/
+class HarmonicMixIndex
+{
+public:
+    HarmonicMixIndex() = default;
+
+    /** Adds a song, or moves it if the key is already in the index */
+    void update (juce::uint32 key, MusicalKey musicalKey, double bpm);
+
+    /** Removes a song */
+    void remove (juce::uint32 key);
+
+    /** Removes every song */
+    void clear();
+
+    /** Returns the keys of the songs in a compatible key within a fraction of a tempo, in no particular order */
+    std::vector<juce::uint32> findCompatible (MusicalKey musicalKey, double bpm, double tempoTolerance = 0.06) const;
+
+private:
+    struct Song
+    {
+        float bpm = 0.0f;
+        juce::uint32 key = 0;
+
+        bool operator< (const Song& other) const    { return bpm < other.bpm || (bpm == other.bpm && key < other.key); }
+    };
+
+    std::array<std::vector<Song>, MusicalKey::numKeys> buckets;
+
+    // Bucket and tempo of every indexed song
+    std::unordered_map<juce::uint32, std::pair<int, float>> placeOfKey;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (HarmonicMixIndex)
+};
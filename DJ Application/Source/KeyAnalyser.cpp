@@ -0,0 +1,227 @@
+/*
+  ==============================================================================
+
+    KeyAnalyser.cpp
+    Created: 21 Oct 2026 4:12:37pm
+    Author:  Justin  Lim
+
+  ==============================================================================
+*/
+
+#include "KeyAnalyser.h"
+
+namespace
+{
+    // Frequency range folded into the chroma
+    constexpr double minFrequency = 55.0;
+    constexpr double maxFrequency = 2000.0;
+
+    // Shortest track, in frames, that a key is estimated for
+    constexpr int minFrames = 20;
+
+    // Krumhansl-Kessler probe tone profiles, starting from the tonic
+    constexpr std::array<double, 12> majorProfile { 6.35, 2.23, 3.48, 2.33, 4.38, 4.09, 2.52, 5.19, 2.39, 3.66, 2.29, 2.88 };
+    constexpr std::array<double, 12> minorProfile { 6.33, 2.68, 3.52, 5.38, 2.60, 3.53, 2.54, 4.75, 3.98, 2.69, 3.34, 3.17 };
+
+    const char* const pitchNames[] { "C", "Db", "D", "Eb", "E", "F", "F#", "G", "Ab", "A", "Bb", "B" };
+
+    // Returns the Pearson correlation of the chroma with a profile whose tonic is at a pitch class
+    double correlate (const std::array<double, 12>& chroma, const std::array<double, 12>& profile, int tonic)
+    {
+        double chromaMean = 0.0, profileMean = 0.0;
+
+        for (int i = 0; i < 12; ++i)
+        {
+            chromaMean += chroma[(size_t) i];
+            profileMean += profile[(size_t) i];
+        }
+
+        chromaMean /= 12.0;
+        profileMean /= 12.0;
+
+        double covariance = 0.0, chromaVariance = 0.0, profileVariance = 0.0;
+
+        for (int i = 0; i < 12; ++i)
+        {
+            auto c = chroma[(size_t) ((tonic + i) % 12)] - chromaMean;
+            auto p = profile[(size_t) i] - profileMean;
+
+            covariance += c * p;
+            chromaVariance += c * c;
+            profileVariance += p * p;
+        }
+
+        auto denominator = std::sqrt (chromaVariance * profileVariance);
+        return denominator > 0.0 ? covariance / denominator : 0.0;
+    }
+}
+
+//==============================================================================
+// Returns true if a key was found
+bool MusicalKey::isValid() const
+{
+    return juce::isPositiveAndBelow (index, numKeys);
+}
+
+
+// Returns true for minor keys
+bool MusicalKey::isMinor() const
+{
+    return index >= 12;
+}
+
+
+// Returns the number of the key on the Camelot wheel, C major being 8B and A minor 8A
+// Each step round the wheel is a fifth, and a minor key shares its number with its relative major
+int MusicalKey::getCamelotNumber() const
+{
+    if (! isValid())
+        return 0;
+
+    auto majorPitchClass = isMinor() ? (index - 12 + 3) % 12 : index;
+    return (7 * majorPitchClass + 7) % 12 + 1;
+}
+
+
+// Returns the Camelot code, like "8A" for A minor, or an empty string
+juce::String MusicalKey::getCamelotCode() const
+{
+    if (! isValid())
+        return {};
+
+    return juce::String (getCamelotNumber()) + (isMinor() ? "A" : "B");
+}
+
+
+// Returns the name of the key, like "A minor"
+juce::String MusicalKey::getName() const
+{
+    if (! isValid())
+        return {};
+
+    return juce::String (pitchNames[index % 12]) + (isMinor() ? " minor" : " major");
+}
+
+
+// Returns the key itself, its relative major or minor, and the keys a fifth above and below
+std::array<MusicalKey, 4> MusicalKey::getCompatibleKeys() const
+{
+    auto number = getCamelotNumber();
+
+    return { *this,
+             fromCamelot (number, ! isMinor()),
+             fromCamelot (number % 12 + 1, isMinor()),
+             fromCamelot ((number + 10) % 12 + 1, isMinor()) };
+}
+
+
+// Returns the key with a number and letter on the Camelot wheel
+MusicalKey MusicalKey::fromCamelot (int number, bool minor)
+{
+    MusicalKey key;
+
+    if (number < 1 || number > 12)
+        return key;
+
+    // Inverse of getCamelotNumber, 7 is its own inverse modulo 12
+    auto majorPitchClass = (7 * (number - 8) + 120) % 12;
+    key.index = minor ? 12 + (majorPitchClass + 9) % 12 : majorPitchClass;
+
+    return key;
+}
+
+
+//==============================================================================
+KeyAnalyser::KeyAnalyser (double analysisRateToUse)
+    : analysisRate (analysisRateToUse),
+      fftData (2 * fftSize, 0.0f),
+      pitchClassOfBin (fftSize / 2 + 1, -1)
+{
+    pendingSamples.reserve (fftSize + hopSize);
+
+    // Bins are assigned to the nearest equal-tempered pitch, A4 being 440 Hz
+    for (size_t bin = 1; bin < pitchClassOfBin.size(); ++bin)
+    {
+        auto frequency = bin * analysisRate / fftSize;
+
+        if (frequency < minFrequency || frequency > maxFrequency)
+            continue;
+
+        auto midiNote = juce::roundToInt (69.0 + 12.0 * std::log2 (frequency / 440.0));
+        pitchClassOfBin[bin] = ((midiNote % 12) + 12) % 12;
+    }
+}
+
+
+// Adds a block of decimated samples to the frame buffer
+void KeyAnalyser::process (const float* samples, int numSamples)
+{
+    for (int i = 0; i < numSamples; ++i)
+    {
+        pendingSamples.push_back (samples[i]);
+
+        if (static_cast<int> (pendingSamples.size()) >= fftSize)
+            processFrame();
+    }
+}
+
+
+// Folds the oldest frame's spectrum into pitch classes and adds it to the track's chroma
+void KeyAnalyser::processFrame()
+{
+    std::fill (fftData.begin(), fftData.end(), 0.0f);
+    std::copy (pendingSamples.begin(), pendingSamples.begin() + fftSize, fftData.begin());
+    pendingSamples.erase (pendingSamples.begin(), pendingSamples.begin() + hopSize);
+
+    window.multiplyWithWindowingTable (fftData.data(), fftSize);
+    fft.performFrequencyOnlyForwardTransform (fftData.data());
+
+    std::array<double, 12> frameChroma {};
+
+    for (size_t bin = 1; bin < pitchClassOfBin.size(); ++bin)
+        if (pitchClassOfBin[bin] >= 0)
+            frameChroma[(size_t) pitchClassOfBin[bin]] += fftData[bin];
+
+    auto loudest = *std::max_element (frameChroma.begin(), frameChroma.end());
+
+    // Silent frames say nothing about the key
+    if (loudest <= 1.0e-6)
+        return;
+
+    for (size_t i = 0; i < chroma.size(); ++i)
+        chroma[i] += frameChroma[i] / loudest;
+
+    ++numFrames;
+}
+
+
+// Returns the major or minor key whose profile correlates best with the track's chroma
+MusicalKey KeyAnalyser::getKey() const
+{
+    MusicalKey key;
+
+    if (numFrames < minFrames)
+        return key;
+
+    auto bestCorrelation = 0.0;
+
+    for (int tonic = 0; tonic < 12; ++tonic)
+    {
+        auto major = correlate (chroma, majorProfile, tonic);
+        auto minor = correlate (chroma, minorProfile, tonic);
+
+        if (major > bestCorrelation)
+        {
+            bestCorrelation = major;
+            key.index = tonic;
+        }
+
+        if (minor > bestCorrelation)
+        {
+            bestCorrelation = minor;
+            key.index = 12 + tonic;
+        }
+    }
+
+    return key;
+}
@@ -0,0 +1,95 @@
+/*
+  ==============================================================================
+
+    KeyAnalyser.h
+    Created: 21 Oct 2026 4:12:37pm
+    Author:  Justin  Lim
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/**
+    A major or minor key, with its position on the Camelot wheel.
+
+    Keys are numbered 0 to 11 for C major to B major and 12 to 23 for C minor to
+    B minor, so a key fits in an int and -1 means unknown.
+*/
+struct MusicalKey
+{
+    static constexpr int numKeys = 24;
+
+    /** Returns true if a key was found */
+    bool isValid() const;
+
+    /** Returns true for minor keys */
+    bool isMinor() const;
+
+    /** Returns the number of the key on the Camelot wheel, 1 to 12 */
+    int getCamelotNumber() const;
+
+    /** Returns the Camelot code, like "8A" for A minor, or an empty string */
+    juce::String getCamelotCode() const;
+
+    /** Returns the name of the key, like "A minor" */
+    juce::String getName() const;
+
+    /** Returns the keys that mix harmonically with this one: itself, its relative key and its neighbours on the wheel */
+    std::array<MusicalKey, 4> getCompatibleKeys() const;
+
+    /** Returns the key with a number and letter on the Camelot wheel */
+    static MusicalKey fromCamelot (int number, bool minor);
+
+    int index = -1;
+};
+
+
+/**
+    Estimates the key of a track from a stream of its audio.
+
+    Works on the track mixed to mono at about 11 kHz. Each 4096 point
+    spectrum, about 2.7 Hz per bin, is folded into a 12 bin chroma vector between
+    55 Hz and 2 kHz, normalised so quiet passages count as much as loud ones. The
+    chroma summed over the whole track is correlated with the Krumhansl-Kessler
+    major and minor key profiles in all twelve transpositions, and the best
+    correlating key is the result.
+
+    Feed the track in order with process(), then call getKey().
+*/
+class KeyAnalyser
+{
+public:
+    KeyAnalyser (double analysisRate);
+
+    /** Adds the next block of the track, mixed to mono and decimated by an AnalysisDecimator */
+    void process (const float* samples, int numSamples);
+
+    /** Returns the key of everything processed so far, invalid if there was no clear pitch content */
+    MusicalKey getKey() const;
+
+private:
+    // Adds the chroma of the oldest fftSize decimated samples and drops a hop of them
+    void processFrame();
+
+    static constexpr int fftOrder = 12;
+    static constexpr int fftSize = 1 << fftOrder;
+    static constexpr int hopSize = fftSize / 2;
+
+    double analysisRate = 0.0;
+
+    std::vector<float> pendingSamples;
+    juce::dsp::FFT fft { fftOrder };
+    juce::dsp::WindowingFunction<float> window { fftSize, juce::dsp::WindowingFunction<float>::hann, false };
+    std::vector<float> fftData;
+
+    // Pitch class of each spectrum bin, -1 for bins outside the analysed range
+    std::vector<int> pitchClassOfBin;
+
+    std::array<double, 12> chroma {};
+    int numFrames = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (KeyAnalyser)
+};
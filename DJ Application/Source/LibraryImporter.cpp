@@ -0,0 +1,358 @@
+/*
+  ==============================================================================
+
+    LibraryImporter.cpp
+    Created: 19 Oct 2026 8:26:05pm
+    Author:  Justin  Lim
+
+  ==============================================================================
+*/
+
+#include "LibraryImporter.h"
+#include "WaveformAnalyser.h"
+
+#if JUCE_LINUX
+ #include <fcntl.h>
+ #include <unistd.h>
+ #include <sys/ioctl.h>
+ #include <linux/fs.h>
+#elif JUCE_MAC
+ #include <unistd.h>
+ #include <sys/clonefile.h>
+#endif
+
+namespace
+{
+    // Makes a copy-on-write clone that shares the source's data blocks until either file is modified
+    bool reflinkFile (const juce::File& sourceFile, const juce::File& destinationFile)
+    {
+       #if JUCE_LINUX && defined (FICLONE)
+        auto sourceFd = ::open (sourceFile.getFullPathName().toRawUTF8(), O_RDONLY);
+
+        if (sourceFd < 0)
+            return false;
+
+        auto destinationFd = ::open (destinationFile.getFullPathName().toRawUTF8(), O_WRONLY | O_CREAT | O_EXCL, 0644);
+
+        if (destinationFd < 0)
+        {
+            ::close (sourceFd);
+            return false;
+        }
+
+        auto cloned = ::ioctl (destinationFd, FICLONE, sourceFd) == 0;
+
+        ::close (destinationFd);
+        ::close (sourceFd);
+
+        if (! cloned)
+            destinationFile.deleteFile();
+
+        return cloned;
+       #elif JUCE_MAC
+        return ::clonefile (sourceFile.getFullPathName().toRawUTF8(), destinationFile.getFullPathName().toRawUTF8(), 0) == 0;
+       #else
+        juce::ignoreUnused (sourceFile, destinationFile);
+        return false;
+       #endif
+    }
+
+    // Adds a second directory entry for the same data, which only works within one filesystem
+    bool hardlinkFile (const juce::File& sourceFile, const juce::File& destinationFile)
+    {
+       #if JUCE_LINUX || JUCE_MAC
+        return ::link (sourceFile.getFullPathName().toRawUTF8(), destinationFile.getFullPathName().toRawUTF8()) == 0;
+       #else
+        juce::ignoreUnused (sourceFile, destinationFile);
+        return false;
+       #endif
+    }
+}
+
+LibraryImporter::LibraryImporter (juce::AudioFormatManager& formatManagerToUse, const juce::File& destinationFolderToUse)
+    : juce::Thread ("Library importer"),
+      formatManager (formatManagerToUse),
+      destinationFolder (destinationFolderToUse)
+{
+    startThread();
+}
+
+LibraryImporter::~LibraryImporter()
+{
+    stopThread (10000);
+    cancelPendingUpdate();
+}
+
+
+// Set how files are brought into the library
+void LibraryImporter::setImportMode (ImportMode newMode)
+{
+    importMode = newMode;
+}
+
+
+// Returns how files are brought into the library
+LibraryImporter::ImportMode LibraryImporter::getImportMode() const
+{
+    return importMode.load();
+}
+
+
+// Queues files to import
+void LibraryImporter::import (const juce::Array<juce::File>& files)
+{
+    if (! isImporting())
+    {
+        bytesCopied = 0;
+        importStartTime = juce::Time::getMillisecondCounterHiRes();
+    }
+
+    {
+        const juce::ScopedLock sl (lock);
+        queue.addArray (files);
+    }
+
+    numQueued += files.size();
+    notify();
+}
+
+
+// Returns true while there are queued files that have not been delivered
+bool LibraryImporter::isImporting() const
+{
+    return numDelivered < numQueued.load();
+}
+
+
+// Returns the fraction of queued files that have been imported, including the file being copied
+double LibraryImporter::getProgress() const
+{
+    auto total = numQueued.load();
+    return total > 0 ? juce::jmin (1.0, (numImported.load() + currentFileProgress.load()) / total) : 1.0;
+}
+
+
+// Returns the number of files imported so far
+int LibraryImporter::getNumFilesImported() const
+{
+    return numImported.load();
+}
+
+
+// Returns the number of files queued in the current import
+int LibraryImporter::getNumFilesQueued() const
+{
+    return numQueued.load();
+}
+
+
+// Returns the copy throughput of the current import in bytes per second
+double LibraryImporter::getBytesPerSecond() const
+{
+    auto elapsedSeconds = (juce::Time::getMillisecondCounterHiRes() - importStartTime) / 1000.0;
+    return elapsedSeconds > 0.0 ? static_cast<double> (bytesCopied.load()) / elapsedSeconds : 0.0;
+}
+
+
+// Background loop that works through the queue one file at a time
+void LibraryImporter::run()
+{
+    while (! threadShouldExit())
+    {
+        juce::File sourceFile;
+
+        {
+            const juce::ScopedLock sl (lock);
+
+            if (! queue.isEmpty())
+                sourceFile = queue.removeAndReturn (0);
+        }
+
+        if (sourceFile == juce::File())
+        {
+            wait (-1);
+            continue;
+        }
+
+        LibraryEntry entry;
+        auto imported = importFile (sourceFile, entry);
+
+        if (! imported)
+            DBG ("LibraryImporter::run could not import " << sourceFile.getFullPathName());
+
+        {
+            const juce::ScopedLock sl (lock);
+
+            if (imported)
+                pendingEntries.push_back (std::move (entry));
+
+            ++numImported;
+            currentFileProgress = 0.0;
+        }
+
+        triggerAsyncUpdate();
+    }
+}
+
+
+/*
+    Brings a file into the library, probes it and caches its waveform analysis.
+
+    @param sourceFile   The file chosen by the user.
+    @param result       Receives the library entry of the imported file.
+
+    @return             True if the file was imported as a readable audio file.
+*/
+bool LibraryImporter::importFile (const juce::File& sourceFile, LibraryEntry& result)
+{
+    auto mode = importMode.load();
+    auto libraryFile = sourceFile;
+
+    if (mode != ImportMode::referenceInPlace && ! sourceFile.isAChildOf (destinationFolder))
+    {
+        libraryFile = destinationFolder.getChildFile (sourceFile.getFileName());
+
+        // A file of the same name and size is already in the folder, so there is nothing to place
+        auto alreadyInFolder = libraryFile.existsAsFile() && libraryFile.getSize() == sourceFile.getSize();
+
+        if (! alreadyInFolder)
+        {
+            if (libraryFile.exists())
+                libraryFile = libraryFile.getNonexistentSibling (false);
+
+            if (! placeInFolder (sourceFile, libraryFile, mode))
+                return false;
+        }
+    }
+
+    if (! LibraryIndex::probeFile (formatManager, libraryFile, result))
+        return false;
+
+    // Analyse the waveform now so loading the song onto a deck finds it in the cache
+    auto cacheFile = WaveformAnalyser::getCacheFileFor (libraryFile);
+
+    if (! cacheFile.existsAsFile())
+    {
+        std::unique_ptr<juce::AudioFormatReader> reader (formatManager.createReaderFor (libraryFile));
+
+        if (reader != nullptr)
+            if (auto data = WaveformAnalyser::computeWaveformData (*reader, [this] { return threadShouldExit(); }))
+                data -> writeToFile (cacheFile);
+    }
+
+    return true;
+}
+
+
+// Places a file in the music folder, trying a reflink then a hardlink before falling back to a copy
+bool LibraryImporter::placeInFolder (const juce::File& sourceFile, const juce::File& destinationFile, ImportMode mode)
+{
+    if (mode == ImportMode::linkOrCopy)
+    {
+        if (reflinkFile (sourceFile, destinationFile))
+        {
+            DBG ("LibraryImporter::placeInFolder reflinked " << destinationFile.getFileName());
+            return true;
+        }
+
+        if (hardlinkFile (sourceFile, destinationFile))
+        {
+            DBG ("LibraryImporter::placeInFolder hardlinked " << destinationFile.getFileName());
+            return true;
+        }
+    }
+
+    return copyWithProgress (sourceFile, destinationFile);
+}
+
+
+/*
+    Copies a file in chunks through a temporary file, so a cancelled copy never leaves a partial song behind.
+
+    The temporary file sits next to the destination, so the final rename stays on one
+    filesystem, but it ends in ".part" rather than the song's extension. The library
+    watcher reports it being written like any other file, and the library ignores it
+    because it is not audio; only the rename to the real name brings the song in.
+*/
+bool LibraryImporter::copyWithProgress (const juce::File& sourceFile, const juce::File& destinationFile)
+{
+    juce::FileInputStream in (sourceFile);
+
+    if (! in.openedOk())
+        return false;
+
+    auto totalBytes = juce::jmax<juce::int64> (1, in.getTotalLength());
+    juce::int64 bytesDone = 0;
+
+    auto temp = destinationFile.getSiblingFile (destinationFile.getFileName() + ".part").getNonexistentSibling (false);
+    auto copied = false;
+
+    {
+        juce::FileOutputStream out (temp);
+
+        if (! out.openedOk())
+            return false;
+
+        juce::HeapBlock<char> buffer (copyChunkSize);
+
+        for (;;)
+        {
+            if (threadShouldExit())
+                break;
+
+            auto numRead = in.read (buffer, copyChunkSize);
+
+            if (numRead <= 0)
+            {
+                out.flush();
+                copied = ! out.getStatus().failed();
+                break;
+            }
+
+            if (! out.write (buffer, static_cast<size_t> (numRead)))
+                break;
+
+            bytesDone += numRead;
+            bytesCopied += numRead;
+            currentFileProgress = static_cast<double> (bytesDone) / totalBytes;
+
+            triggerAsyncUpdate();
+        }
+    }
+
+    if (copied && temp.moveFileTo (destinationFile))
+        return true;
+
+    temp.deleteFile();
+    return false;
+}
+
+
+// Delivers everything imported since the last update as one batch
+void LibraryImporter::handleAsyncUpdate()
+{
+    std::vector<LibraryEntry> entries;
+
+    {
+        const juce::ScopedLock sl (lock);
+        entries.swap (pendingEntries);
+        numDelivered = numImported.load();
+    }
+
+    if (! entries.empty() && onBatchReady != nullptr)
+        onBatchReady (entries);
+
+    if (onProgress != nullptr)
+        onProgress();
+
+    if (! isImporting())
+    {
+        // Start counting progress from zero for the next import
+        numQueued -= numDelivered;
+        numImported -= numDelivered;
+        numDelivered = 0;
+
+        if (onImportFinished != nullptr)
+            onImportFinished();
+    }
+}
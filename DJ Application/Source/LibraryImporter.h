@@ -0,0 +1,106 @@
+/*
+  ==============================================================================
+
+    LibraryImporter.h
+    Created: 19 Oct 2026 8:26:05pm
+    Author:  Justin  Lim
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "LibraryIndex.h"
+
+/**
+    Imports songs into the library on a background thread.
+
+    Depending on the import mode a file is referenced where it is, linked into the
+    music folder, or copied as a last resort. It is then probed and has its waveform
+    analysed once, so importing n files opens n readers instead of re-reading the
+    whole library. Imported entries are handed to onBatchReady on the message
+    thread, coalesced into batches.
+*/
+class LibraryImporter : private juce::Thread,
+                        private juce::AsyncUpdater
+{
+public:
+    enum class ImportMode
+    {
+        referenceInPlace,   // Leave files where they are and index them there
+        linkOrCopy,         // Reflink or hardlink into the music folder, copy if the filesystem can do neither
+        copy                // Always copy into the music folder
+    };
+    
+    LibraryImporter (juce::AudioFormatManager& formatManagerToUse, const juce::File& destinationFolderToUse);
+    ~LibraryImporter() override;
+
+    /** Set how files are brought into the library, applies to files that have not been imported yet */
+    void setImportMode (ImportMode newMode);
+
+    /** Returns how files are brought into the library */
+    ImportMode getImportMode() const;
+
+    /** Queues files to import, can be called while an import is running */
+    void import (const juce::Array<juce::File>& files);
+
+    /** Returns true while there are queued files that have not been delivered */
+    bool isImporting() const;
+
+    /** Returns the fraction of queued files that have been imported, including the file being copied */
+    double getProgress() const;
+
+    /** Returns the number of files imported so far and the number queued */
+    int getNumFilesImported() const;
+    int getNumFilesQueued() const;
+
+    /** Returns the copy throughput of the current import in bytes per second */
+    double getBytesPerSecond() const;
+
+    /** Called on the message thread with the entries of newly imported songs */
+    std::function<void (std::vector<LibraryEntry>& entries)> onBatchReady;
+
+    /** Called on the message thread once the queue has been emptied */
+    std::function<void()> onImportFinished;
+
+    /** Called on the message thread whenever progress has been made, including during a copy */
+    std::function<void()> onProgress;
+
+private:
+    void run() override;
+    void handleAsyncUpdate() override;
+
+    /** Brings a single file into the library, probes and analyses it, returns false if it is not readable audio */
+    bool importFile (const juce::File& sourceFile, LibraryEntry& result);
+
+    /** Places a file in the music folder using the cheapest method the mode and filesystem allow */
+    bool placeInFolder (const juce::File& sourceFile, const juce::File& destinationFile, ImportMode mode);
+
+    /** Copies a file in chunks, publishing progress as it goes */
+    bool copyWithProgress (const juce::File& sourceFile, const juce::File& destinationFile);
+
+    // Size of each read/write while copying
+    static constexpr int copyChunkSize = 1 << 20;
+
+    juce::AudioFormatManager& formatManager;
+    juce::File destinationFolder;
+
+    // Files waiting to be imported and results waiting to be delivered, guarded by lock
+    juce::CriticalSection lock;
+    juce::Array<juce::File> queue;
+    std::vector<LibraryEntry> pendingEntries;
+
+    std::atomic<ImportMode> importMode { ImportMode::linkOrCopy };
+
+    std::atomic<int> numQueued { 0 };
+    std::atomic<int> numImported { 0 };
+    int numDelivered = 0;
+
+    // Copy progress of the current file and throughput of the current import
+    std::atomic<double> currentFileProgress { 0.0 };
+    std::atomic<juce::int64> bytesCopied { 0 };
+    double importStartTime = 0.0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LibraryImporter)
+};
@@ -0,0 +1,340 @@
+/*
+  ==============================================================================
+
+    LibraryIndex.cpp
+    Created: 19 Oct 2026 6:03:27pm
+    Author:  Justin  Lim
+
+  ==============================================================================
+*/
+
+#include "LibraryIndex.h"
+#include "AudioFileProbe.h"
+
+namespace
+{
+    // Identifies an index file and the layout version of its entries
+    constexpr int indexFileMagic = 0x31494c4f; // "OLI1"
+    constexpr int indexFileVersion = 7;
+
+    // Oldest layout that can still be read, version 1 had no date added, version 2 no beat grid,
+    // version 3 no loudness, version 4 no key, version 5 no timbre and version 6 no fingerprint
+    constexpr int oldestReadableVersion = 1;
+
+    // Returns the first non-empty metadata value out of a list of keys used by different formats
+    juce::String findTag (const juce::StringPairArray& metadata, std::initializer_list<const char*> keys)
+    {
+        for (auto* key : keys)
+        {
+            auto value = metadata.getValue (key, {}).trim();
+
+            if (value.isNotEmpty())
+                return value;
+        }
+
+        return {};
+    }
+}
+
+//==============================================================================
+// Returns true if the file on disk still has the size and modification time recorded here
+bool LibraryEntry::matchesFileOnDisk() const
+{
+    return matches (file.getSize(), file.getLastModificationTime());
+}
+
+
+// Returns true if a size and modification time, as listed by a directory walk, match this entry
+bool LibraryEntry::matches (juce::int64 size, juce::Time modified) const
+{
+    return size == fileSize && modified.toMilliseconds() == modificationTime;
+}
+
+
+//==============================================================================
+LibraryIndex::LibraryIndex (const juce::File& indexFileToUse) : indexFile (indexFileToUse) {}
+
+
+// Reads the index file
+bool LibraryIndex::load()
+{
+    entries.clear();
+    entryIndexByPath.clear();
+    dirty = false;
+
+    juce::FileInputStream fileStream (indexFile);
+
+    if (! fileStream.openedOk())
+        return false;
+
+    juce::BufferedInputStream in (fileStream, 1 << 16);
+
+    auto magic = in.readInt();
+    auto version = in.readInt();
+
+    if (magic != indexFileMagic || version < oldestReadableVersion || version > indexFileVersion)
+    {
+        DBG ("LibraryIndex::load ignoring index with an unknown format");
+        return false;
+    }
+
+    auto numEntries = in.readInt();
+
+    for (int i = 0; i < numEntries && ! in.isExhausted(); ++i)
+    {
+        LibraryEntry entry;
+        entry.file             = juce::File (in.readString());
+        entry.fileSize         = in.readInt64();
+        entry.modificationTime = in.readInt64();
+        entry.lengthInSeconds  = in.readDouble();
+        entry.sampleRate       = in.readDouble();
+        entry.title            = in.readString();
+        entry.artist           = in.readString();
+        entry.album            = in.readString();
+        entry.dateAdded        = version >= 2 ? in.readInt64() : entry.modificationTime;
+
+        if (version >= 3)
+        {
+            entry.bpm              = in.readDouble();
+            entry.firstBeatSeconds = in.readDouble();
+            entry.analysisVersion  = in.readInt();
+        }
+
+        if (version >= 4)
+        {
+            entry.loudness         = in.readDouble();
+            entry.truePeak         = in.readDouble();
+        }
+
+        if (version >= 5)
+            entry.key              = in.readInt();
+
+        if (version >= 6)
+        {
+            auto numFeatures = in.readInt();
+
+            for (int feature = 0; feature < numFeatures && ! in.isExhausted(); ++feature)
+                entry.timbre.push_back (in.readFloat());
+        }
+
+        if (version >= 7)
+        {
+            auto numHashes = in.readInt();
+
+            for (int hash = 0; hash < numHashes && ! in.isExhausted(); ++hash)
+                entry.fingerprint.push_back (static_cast<juce::uint32> (in.readInt()));
+        }
+
+        entryIndexByPath[entry.file.getFullPathName()] = entries.size();
+        entries.push_back (std::move (entry));
+    }
+
+    return true;
+}
+
+
+// Writes the index to a temporary file and swaps it in, so a crash never leaves a half-written index
+bool LibraryIndex::save()
+{
+    if (! dirty)
+        return true;
+
+    indexFile.getParentDirectory().createDirectory();
+
+    juce::TemporaryFile temp (indexFile);
+
+    {
+        juce::FileOutputStream out (temp.getFile(), 1 << 16);
+
+        if (! out.openedOk())
+            return false;
+
+        out.writeInt (indexFileMagic);
+        out.writeInt (indexFileVersion);
+        out.writeInt (static_cast<int> (entries.size()));
+
+        for (auto& entry : entries)
+        {
+            out.writeString (entry.file.getFullPathName());
+            out.writeInt64  (entry.fileSize);
+            out.writeInt64  (entry.modificationTime);
+            out.writeDouble (entry.lengthInSeconds);
+            out.writeDouble (entry.sampleRate);
+            out.writeString (entry.title);
+            out.writeString (entry.artist);
+            out.writeString (entry.album);
+            out.writeInt64  (entry.dateAdded);
+            out.writeDouble (entry.bpm);
+            out.writeDouble (entry.firstBeatSeconds);
+            out.writeInt    (entry.analysisVersion);
+            out.writeDouble (entry.loudness);
+            out.writeDouble (entry.truePeak);
+            out.writeInt    (entry.key);
+            out.writeInt    (static_cast<int> (entry.timbre.size()));
+
+            for (auto feature : entry.timbre)
+                out.writeFloat (feature);
+
+            out.writeInt    (static_cast<int> (entry.fingerprint.size()));
+
+            for (auto hash : entry.fingerprint)
+                out.writeInt (static_cast<int> (hash));
+        }
+
+        out.flush();
+
+        if (out.getStatus().failed())
+            return false;
+    }
+
+    if (! temp.overwriteTargetFileWithTemporary())
+        return false;
+
+    dirty = false;
+    return true;
+}
+
+
+// Returns true if there are changes that have not been saved
+bool LibraryIndex::isDirty() const
+{
+    return dirty;
+}
+
+
+// Returns the entry for a file, or nullptr if it is not indexed
+const LibraryEntry* LibraryIndex::find (const juce::File& file) const
+{
+    auto it = entryIndexByPath.find (file.getFullPathName());
+    return it != entryIndexByPath.end() ? &entries[it->second] : nullptr;
+}
+
+
+// Adds an entry, or replaces the existing entry for the same file
+// An entry without a date added keeps the one already indexed, or is dated now
+// An unanalysed entry keeps the analysis already indexed as long as the file has not changed
+void LibraryIndex::update (const LibraryEntry& entry)
+{
+    auto path = entry.file.getFullPathName();
+    auto it = entryIndexByPath.find (path);
+
+    if (it != entryIndexByPath.end())
+    {
+        auto previous = entries[it->second];
+        auto& updated = entries[it->second];
+        updated = entry;
+
+        if (entry.dateAdded == 0)
+            updated.dateAdded = previous.dateAdded;
+
+        if (entry.analysisVersion == 0 && previous.fileSize == entry.fileSize && previous.modificationTime == entry.modificationTime)
+        {
+            updated.bpm              = previous.bpm;
+            updated.firstBeatSeconds = previous.firstBeatSeconds;
+            updated.loudness         = previous.loudness;
+            updated.truePeak         = previous.truePeak;
+            updated.key              = previous.key;
+            updated.timbre           = previous.timbre;
+            updated.fingerprint      = previous.fingerprint;
+            updated.analysisVersion  = previous.analysisVersion;
+        }
+    }
+    else
+    {
+        entryIndexByPath[path] = entries.size();
+        entries.push_back (entry);
+
+        if (entry.dateAdded == 0)
+            entries.back().dateAdded = juce::Time::currentTimeMillis();
+    }
+
+    dirty = true;
+}
+
+
+// Removes the entry for a file by moving the last entry into its slot
+void LibraryIndex::remove (const juce::File& file)
+{
+    auto it = entryIndexByPath.find (file.getFullPathName());
+
+    if (it == entryIndexByPath.end())
+        return;
+
+    auto index = it->second;
+    entryIndexByPath.erase (it);
+
+    if (index != entries.size() - 1)
+    {
+        entries[index] = std::move (entries.back());
+        entryIndexByPath[entries[index].file.getFullPathName()] = index;
+    }
+
+    entries.pop_back();
+    dirty = true;
+}
+
+
+// Returns all indexed entries
+const std::vector<LibraryEntry>& LibraryIndex::getEntries() const
+{
+    return entries;
+}
+
+
+// Returns the index file in the user's application data folder
+juce::File LibraryIndex::getDefaultIndexFile()
+{
+    return juce::File::getSpecialLocation (juce::File::userApplicationDataDirectory)
+               .getChildFile ("OtoDecks")
+               .getChildFile ("library.index");
+}
+
+
+/*
+    Opens an audio file to read the metadata stored in the index.
+
+    @param formatManager   The format manager used to open the file.
+    @param file            The audio file to probe.
+    @param result          Receives the file's entry.
+
+    @return                True if the file could be opened as audio.
+*/
+bool LibraryIndex::probeFile (juce::AudioFormatManager& formatManager, const juce::File& file, LibraryEntry& result)
+{
+    result.file             = file;
+    result.fileSize         = file.getSize();
+    result.modificationTime = file.getLastModificationTime().toMilliseconds();
+
+    // Headers alone are enough for most files, decoders are only opened when they are not
+    AudioFileProbe::Result probed;
+
+    if (AudioFileProbe::probe (file, probed))
+    {
+        result.lengthInSeconds = static_cast<double> (probed.lengthInSamples) / probed.sampleRate;
+        result.sampleRate      = probed.sampleRate;
+        result.title           = probed.title;
+        result.artist          = probed.artist;
+        result.album           = probed.album;
+    }
+    else
+    {
+        std::unique_ptr<juce::AudioFormatReader> reader (formatManager.createReaderFor (file));
+
+        if (reader == nullptr || reader -> sampleRate <= 0.0)
+            return false;
+
+        auto& metadata = reader -> metadataValues;
+
+        result.lengthInSeconds = static_cast<double> (reader -> lengthInSamples) / reader -> sampleRate;
+        result.sampleRate      = reader -> sampleRate;
+        result.title           = findTag (metadata, { "title", "INAM", "id3title" });
+        result.artist          = findTag (metadata, { "artist", "IART", "id3artist" });
+        result.album           = findTag (metadata, { "album", "IPRD", "id3album" });
+    }
+
+    // Untagged files are listed under their file name
+    if (result.title.isEmpty())
+        result.title = file.getFileNameWithoutExtension();
+
+    return true;
+}
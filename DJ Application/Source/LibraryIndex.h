@@ -0,0 +1,91 @@
+/*
+  ==============================================================================
+
+    LibraryIndex.h
+    Created: 19 Oct 2026 6:03:27pm
+    Author:  Justin  Lim
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/** Everything the library knows about one audio file */
+struct LibraryEntry
+{
+    juce::File file;
+    juce::int64 fileSize = 0;
+    juce::int64 modificationTime = 0;   // milliseconds since 1970
+    double lengthInSeconds = 0.0;
+    double sampleRate = 0.0;
+    juce::String title;
+    juce::String artist;
+    juce::String album;
+    juce::int64 dateAdded = 0;          // milliseconds since 1970, set when the song is first indexed
+    double bpm = 0.0;                   // beat grid, 0 bpm if no tempo was found
+    double firstBeatSeconds = 0.0;
+    double loudness = -70.0;            // integrated loudness in LUFS, -70 if silent or not analysed
+    double truePeak = -70.0;            // dBTP
+    int key = -1;                       // MusicalKey index, -1 if unknown or not analysed
+    std::vector<float> timbre;          // TimbreAnalyser features, empty if not analysed
+    std::vector<juce::uint32> fingerprint;  // FingerprintAnalyser hashes, empty if not analysed
+    int analysisVersion = 0;            // version of the analysis that filled in the analysed fields, 0 if not analysed
+
+    /** Returns true if the file on disk still has the size and modification time recorded here */
+    bool matchesFileOnDisk() const;
+
+    /** Returns true if a size and modification time, as listed by a directory walk, match this entry */
+    bool matches (juce::int64 size, juce::Time modified) const;
+};
+
+
+/**
+    On-disk index of the library's metadata.
+
+    Startup reads the index instead of opening every audio file. A file is only
+    probed again when its size or modification time no longer matches its entry.
+*/
+class LibraryIndex
+{
+public:
+    LibraryIndex (const juce::File& indexFileToUse);
+
+    /** Reads the index file, returns false if it is missing or unreadable */
+    bool load();
+
+    /** Writes the index file if anything changed since it was loaded or saved */
+    bool save();
+
+    /** Returns true if there are changes that have not been saved */
+    bool isDirty() const;
+
+    /** Returns the entry for a file, or nullptr if it is not indexed */
+    const LibraryEntry* find (const juce::File& file) const;
+
+    /** Adds an entry, or replaces the existing entry for the same file */
+    void update (const LibraryEntry& entry);
+
+    /** Removes the entry for a file */
+    void remove (const juce::File& file);
+
+    /** Returns all indexed entries */
+    const std::vector<LibraryEntry>& getEntries() const;
+
+    /** Returns the index file in the user's application data folder */
+    static juce::File getDefaultIndexFile();
+
+    /** Reads a file's duration, sample rate and tags from its headers, or a full reader if needed, returns false if it is not readable audio */
+    static bool probeFile (juce::AudioFormatManager& formatManager, const juce::File& file, LibraryEntry& result);
+
+private:
+    juce::File indexFile;
+
+    std::vector<LibraryEntry> entries;
+    std::unordered_map<juce::String, size_t> entryIndexByPath;
+
+    bool dirty = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LibraryIndex)
+};
@@ -0,0 +1,162 @@
+/*
+  ==============================================================================
+
+    LibraryScanner.cpp
+    Created: 19 Oct 2026 7:14:52pm
+    Author:  Justin  Lim
+
+  ==============================================================================
+*/
+
+#include "LibraryScanner.h"
+
+LibraryScanner::LibraryScanner (juce::AudioFormatManager& formatManagerToUse) : formatManager (formatManagerToUse) {}
+
+LibraryScanner::~LibraryScanner()
+{
+    cancel();
+}
+
+
+// Starts probing a list of files, cancelling any scan in progress
+void LibraryScanner::scan (const juce::Array<juce::File>& files)
+{
+    cancel();
+
+    numFilesToScan = 0;
+    numFilesDelivered = 0;
+    addFiles (files);
+
+    if (numFilesToScan == 0)
+        triggerAsyncUpdate();
+}
+
+
+// Splits the files into small jobs and queues them on the pool
+void LibraryScanner::addFiles (const juce::Array<juce::File>& files)
+{
+    if (! isScanning())
+    {
+        numFilesToScan = 0;
+        numFilesDelivered = 0;
+        numFilesScanned = 0;
+        scanStartTime = juce::Time::getMillisecondCounter();
+    }
+
+    numFilesToScan += files.size();
+
+    auto scanId = currentScanId.load();
+
+    for (int start = 0; start < files.size(); start += filesPerJob)
+    {
+        juce::Array<juce::File> slice;
+        slice.addArray (files, start, filesPerJob);
+
+        pool.addJob ([this, slice, scanId] { probeFiles (slice, scanId); });
+    }
+}
+
+
+// Stops the current scan, results that have not been delivered are dropped
+void LibraryScanner::cancel()
+{
+    ++currentScanId;
+    pool.removeAllJobs (true, 10000);
+    cancelPendingUpdate();
+
+    const juce::ScopedLock sl (lock);
+    pendingEntries.clear();
+    pendingUnreadableFiles.clear();
+}
+
+
+// Returns true while a scan has files left to probe
+bool LibraryScanner::isScanning() const
+{
+    return numFilesDelivered < numFilesToScan;
+}
+
+
+// Returns the number of files in the current scan
+int LibraryScanner::getNumFilesToScan() const
+{
+    return numFilesToScan;
+}
+
+
+// Returns the number of files probed so far in the current scan
+int LibraryScanner::getNumFilesScanned() const
+{
+    return numFilesScanned.load();
+}
+
+
+// Returns the probing throughput of the current scan
+double LibraryScanner::getFilesPerSecond() const
+{
+    auto elapsedSeconds = (juce::Time::getMillisecondCounter() - scanStartTime) / 1000.0;
+    return elapsedSeconds > 0.0 ? numFilesScanned.load() / elapsedSeconds : 0.0;
+}
+
+
+// Probes a slice of the scan's files on a worker thread
+void LibraryScanner::probeFiles (juce::Array<juce::File> files, int scanId)
+{
+    std::vector<LibraryEntry> entries;
+    juce::Array<juce::File> unreadableFiles;
+
+    for (auto& file : files)
+    {
+        if (scanId != currentScanId.load())
+            return;
+
+        LibraryEntry entry;
+
+        if (LibraryIndex::probeFile (formatManager, file, entry))
+            entries.push_back (std::move (entry));
+        else
+            unreadableFiles.add (file);
+
+        ++numFilesScanned;
+    }
+
+    {
+        const juce::ScopedLock sl (lock);
+
+        if (scanId != currentScanId.load())
+            return;
+
+        std::move (entries.begin(), entries.end(), std::back_inserter (pendingEntries));
+        pendingUnreadableFiles.addArray (unreadableFiles);
+    }
+
+    triggerAsyncUpdate();
+}
+
+
+// Delivers everything that finished since the last update as one batch
+void LibraryScanner::handleAsyncUpdate()
+{
+    std::vector<LibraryEntry> entries;
+    juce::Array<juce::File> unreadableFiles;
+
+    {
+        const juce::ScopedLock sl (lock);
+        entries.swap (pendingEntries);
+        unreadableFiles.swapWith (pendingUnreadableFiles);
+    }
+
+    auto numInBatch = static_cast<int> (entries.size()) + unreadableFiles.size();
+
+    // Several workers can trigger an update for results that were already delivered
+    if (numInBatch == 0 && numFilesToScan > 0)
+        return;
+
+    numFilesDelivered += numInBatch;
+
+    if (numInBatch > 0 && onBatchReady != nullptr)
+        onBatchReady (entries, unreadableFiles);
+
+    if (! isScanning() && onScanFinished != nullptr)
+        onScanFinished();
+}
@@ -0,0 +1,80 @@
+/*
+  ==============================================================================
+
+    LibraryScanner.h
+    Created: 19 Oct 2026 7:14:52pm
+    Author:  Justin  Lim
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "LibraryIndex.h"
+
+/**
+    Probes audio files for the library on a pool of worker threads.
+
+    The pool has one thread per core. Results are collected as they finish and
+    handed to onBatchReady on the message thread, coalesced into batches, so the
+    table can fill in progressively while a large folder is being scanned.
+*/
+class LibraryScanner : private juce::AsyncUpdater
+{
+public:
+    LibraryScanner (juce::AudioFormatManager& formatManagerToUse);
+    ~LibraryScanner() override;
+
+    /** Starts probing a list of files, cancelling any scan in progress */
+    void scan (const juce::Array<juce::File>& files);
+
+    /** Adds files to the scan in progress, or starts a new scan if there is none */
+    void addFiles (const juce::Array<juce::File>& files);
+
+    /** Stops the current scan, results that have not been delivered are dropped */
+    void cancel();
+
+    /** Returns true while a scan has files left to probe */
+    bool isScanning() const;
+
+    /** Returns the number of files in the current scan */
+    int getNumFilesToScan() const;
+
+    /** Returns the number of files probed so far in the current scan */
+    int getNumFilesScanned() const;
+
+    /** Returns the probing throughput of the current scan */
+    double getFilesPerSecond() const;
+
+    /** Called on the message thread with entries for readable files and a list of unreadable ones */
+    std::function<void (std::vector<LibraryEntry>& entries, juce::Array<juce::File>& unreadableFiles)> onBatchReady;
+
+    /** Called on the message thread once every file of the scan has been delivered */
+    std::function<void()> onScanFinished;
+
+private:
+    void handleAsyncUpdate() override;
+
+    /** Probes a slice of the scan's files on a worker thread */
+    void probeFiles (juce::Array<juce::File> files, int scanId);
+
+    // Number of files each pool job probes before publishing its results
+    static constexpr int filesPerJob = 16;
+
+    juce::AudioFormatManager& formatManager;
+    juce::ThreadPool pool { juce::SystemStats::getNumCpus() };
+
+    // Results waiting to be delivered, guarded by lock
+    juce::CriticalSection lock;
+    std::vector<LibraryEntry> pendingEntries;
+    juce::Array<juce::File> pendingUnreadableFiles;
+
+    std::atomic<int> currentScanId { 0 };
+    std::atomic<int> numFilesScanned { 0 };
+    int numFilesToScan = 0;
+    int numFilesDelivered = 0;
+    juce::uint32 scanStartTime = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LibraryScanner)
+};
@@ -0,0 +1,283 @@
+/*
+  ==============================================================================
+
+    LibraryWatcher.cpp
+    Created: 19 Oct 2026 9:40:18pm
+    Author:  Justin  Lim
+
+  ==============================================================================
+*/
+
+#include "LibraryWatcher.h"
+
+#if JUCE_LINUX
+ #include <poll.h>
+ #include <unistd.h>
+ #include <sys/inotify.h>
+
+namespace
+{
+    constexpr juce::uint32 directoryWatchMask = IN_CLOSE_WRITE | IN_CREATE | IN_DELETE
+                                              | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR;
+
+    // How long the first half of a move waits for the second before it counts as a move out of the tree
+    constexpr double movePairingTimeoutMs = 250.0;
+}
+#endif
+
+LibraryWatcher::LibraryWatcher() : juce::Thread ("Library watcher") {}
+
+LibraryWatcher::~LibraryWatcher()
+{
+    stopThread (2000);
+    cancelPendingUpdate();
+
+   #if JUCE_LINUX
+    if (inotifyFd >= 0)
+        ::close (inotifyFd);
+   #endif
+}
+
+
+/*
+    Starts watching a folder and everything below it.
+
+    Each directory is watched before it is listed, so a file added during the
+    walk is either found by the walk or reported as an event, never missed.
+
+    @param folder        The root of the tree to watch.
+    @param onFileFound   Called on this thread with every file found while the tree is walked, may be nullptr.
+*/
+void LibraryWatcher::watch (const juce::File& folder, const FileCallback& onFileFound)
+{
+   #if JUCE_LINUX
+    jassert (! isThreadRunning());
+
+    inotifyFd = ::inotify_init1 (IN_NONBLOCK | IN_CLOEXEC);
+
+    if (inotifyFd >= 0)
+    {
+        addWatchRecursively (folder, false, onFileFound);
+        startThread();
+        return;
+    }
+   #endif
+
+    // Nothing can be watched, the caller still gets the files in one walk
+    if (onFileFound != nullptr)
+        for (const auto& entry : juce::RangedDirectoryIterator (folder, true, "*", juce::File::findFiles))
+            onFileFound (entry);
+}
+
+
+// Waits for inotify events and turns them into library events
+void LibraryWatcher::run()
+{
+   #if JUCE_LINUX
+    alignas (inotify_event) char buffer[64 * 1024];
+
+    while (! threadShouldExit())
+    {
+        // Time out regularly so stopThread() is noticed and unpaired moves are flushed
+        pollfd pfd { inotifyFd, POLLIN, 0 };
+
+        if (::poll (&pfd, 1, 100) > 0)
+        {
+            auto length = ::read (inotifyFd, buffer, sizeof (buffer));
+
+            for (auto* p = buffer; p < buffer + length;)
+            {
+                auto* event = reinterpret_cast<const inotify_event*> (p);
+                auto name = event -> len > 0 ? juce::String::fromUTF8 (event -> name) : juce::String();
+
+                handleNotification (event -> wd, event -> mask, event -> cookie, name);
+
+                p += sizeof (inotify_event) + event -> len;
+            }
+        }
+
+        // The two halves of a move can be split across reads, so a move only counts as leaving the tree after a while
+        flushUnpairedMoves (false);
+    }
+   #endif
+}
+
+
+// Queues an event for delivery on the message thread
+void LibraryWatcher::addEvent (Event::Type type, const juce::File& file, const juce::File& newFile)
+{
+    {
+        const juce::ScopedLock sl (lock);
+        pendingEvents.push_back ({ type, file, newFile });
+    }
+
+    triggerAsyncUpdate();
+}
+
+
+// Delivers the events collected since the last update
+void LibraryWatcher::handleAsyncUpdate()
+{
+    std::vector<Event> events;
+
+    {
+        const juce::ScopedLock sl (lock);
+        events.swap (pendingEvents);
+    }
+
+    if (! events.empty() && onEvents != nullptr)
+        onEvents (events);
+}
+
+
+#if JUCE_LINUX
+// Watches a directory and all of its sub-directories
+// A directory that cannot be watched is still walked, so the caller hears about every file in it
+void LibraryWatcher::addWatchRecursively (const juce::File& directory, bool reportExistingFiles, const FileCallback& onFileFound)
+{
+    auto wd = ::inotify_add_watch (inotifyFd, directory.getFullPathName().toRawUTF8(), directoryWatchMask);
+
+    if (wd >= 0)
+        watchedDirectories[wd] = directory;
+    else if (onFileFound == nullptr)
+        return;
+
+    for (const auto& entry : juce::RangedDirectoryIterator (directory, false, "*", juce::File::findFilesAndDirectories))
+    {
+        if (entry.isDirectory())
+            addWatchRecursively (entry.getFile(), reportExistingFiles, onFileFound);
+        else if (reportExistingFiles)
+            addEvent (Event::Type::added, entry.getFile());
+        else if (onFileFound != nullptr)
+            onFileFound (entry);
+    }
+}
+
+
+// Stops watching a directory and all of its sub-directories
+void LibraryWatcher::removeWatchRecursively (const juce::File& directory)
+{
+    for (auto it = watchedDirectories.begin(); it != watchedDirectories.end();)
+    {
+        if (it -> second == directory || it -> second.isAChildOf (directory))
+        {
+            ::inotify_rm_watch (inotifyFd, it -> first);
+            it = watchedDirectories.erase (it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+
+// Updates the watched paths after a directory was moved within the tree
+void LibraryWatcher::renameWatchedDirectory (const juce::File& oldDirectory, const juce::File& newDirectory)
+{
+    for (auto& watched : watchedDirectories)
+    {
+        if (watched.second == oldDirectory)
+            watched.second = newDirectory;
+        else if (watched.second.isAChildOf (oldDirectory))
+            watched.second = newDirectory.getChildFile (watched.second.getRelativePathFrom (oldDirectory));
+    }
+}
+
+
+/*
+    Turns a single inotify event into library events.
+
+    @param watchDescriptor   The watch of the directory the event happened in.
+    @param mask              The inotify event flags.
+    @param cookie            Links the two halves of a move.
+    @param name              The name of the file or directory inside the watched directory.
+*/
+void LibraryWatcher::handleNotification (int watchDescriptor, juce::uint32 mask, juce::uint32 cookie, const juce::String& name)
+{
+    // The kernel queue filled up and events were dropped, nothing short of a rescan can tell what changed
+    if ((mask & IN_Q_OVERFLOW) != 0)
+    {
+        flushUnpairedMoves (true);
+        addEvent (Event::Type::overflowed, {});
+        return;
+    }
+
+    if ((mask & IN_IGNORED) != 0)
+    {
+        watchedDirectories.erase (watchDescriptor);
+        return;
+    }
+
+    auto directory = watchedDirectories.find (watchDescriptor);
+
+    if (directory == watchedDirectories.end() || name.isEmpty())
+        return;
+
+    auto file = directory -> second.getChildFile (name);
+    auto isDirectory = (mask & IN_ISDIR) != 0;
+
+    if ((mask & IN_MOVED_FROM) != 0)
+    {
+        pendingMoves[cookie] = { file, isDirectory, juce::Time::getMillisecondCounterHiRes() };
+    }
+    else if ((mask & IN_MOVED_TO) != 0)
+    {
+        auto move = pendingMoves.find (cookie);
+
+        if (move != pendingMoves.end())
+        {
+            if (isDirectory)
+                renameWatchedDirectory (move -> second.source, file);
+
+            addEvent (Event::Type::renamed, move -> second.source, file);
+            pendingMoves.erase (move);
+        }
+        else if (isDirectory)
+        {
+            // Moved in from outside the tree
+            addWatchRecursively (file, true);
+        }
+        else
+        {
+            addEvent (Event::Type::added, file);
+        }
+    }
+    else if ((mask & IN_CREATE) != 0)
+    {
+        // Files are reported once they are closed after writing, new directories straight away
+        if (isDirectory)
+            addWatchRecursively (file, true);
+    }
+    else if ((mask & IN_CLOSE_WRITE) != 0)
+    {
+        addEvent (Event::Type::added, file);
+    }
+    else if ((mask & IN_DELETE) != 0)
+    {
+        addEvent (Event::Type::removed, file);
+    }
+}
+
+
+// Reports moves whose other half has not arrived within the timeout, or all of them, as moves out of the tree
+void LibraryWatcher::flushUnpairedMoves (bool flushAll)
+{
+    auto now = juce::Time::getMillisecondCounterHiRes();
+
+    for (auto it = pendingMoves.begin(); it != pendingMoves.end();)
+    {
+        if (! flushAll && now - it -> second.timeMs < movePairingTimeoutMs)
+        {
+            ++it;
+            continue;
+        }
+
+        if (it -> second.isDirectory)
+            removeWatchRecursively (it -> second.source);
+
+        addEvent (Event::Type::removed, it -> second.source);
+        it = pendingMoves.erase (it);
+    }
+}
+#endif
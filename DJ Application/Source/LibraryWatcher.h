@@ -0,0 +1,100 @@
+/*
+  ==============================================================================
+
+    LibraryWatcher.h
+    Created: 19 Oct 2026 9:40:18pm
+    Author:  Justin  Lim
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/**
+    Watches the music folder tree and reports changes as they happen.
+
+    On Linux this uses inotify with one watch per directory, so the library can apply
+    adds, removes and renames incrementally instead of rescanning. Files inside a
+    directory that appears are reported as added. On other platforms nothing is
+    watched and changes are picked up by the next startup scan.
+
+    Setting up the watches walks the whole tree, so watch() hands every file it
+    finds to the caller, who then does not need to walk the tree again.
+*/
+class LibraryWatcher : private juce::Thread,
+                       private juce::AsyncUpdater
+{
+public:
+    struct Event
+    {
+        enum class Type
+        {
+            added,      // A file appeared or finished being written
+            removed,    // A file or directory was deleted or moved out of the tree
+            renamed,    // A file or directory was moved within the tree
+            overflowed  // Events were lost, the whole tree has to be compared with the library again
+        };
+
+        Type type;
+        juce::File file;
+        juce::File newFile;   // Only used by renamed events
+    };
+
+    /** Receives each file already in the tree while watch() walks it */
+    using FileCallback = std::function<void (const juce::DirectoryEntry& entry)>;
+
+    LibraryWatcher();
+    ~LibraryWatcher() override;
+
+    /** Starts watching a folder and everything below it, passing each file already there to onFileFound */
+    void watch (const juce::File& folder, const FileCallback& onFileFound = nullptr);
+
+    /** Called on the message thread with the events collected since the last call */
+    std::function<void (const std::vector<Event>& events)> onEvents;
+
+private:
+    void run() override;
+    void handleAsyncUpdate() override;
+
+    /** Queues an event for delivery on the message thread */
+    void addEvent (Event::Type type, const juce::File& file, const juce::File& newFile = {});
+
+   #if JUCE_LINUX
+    /** Watches a directory and all of its sub-directories, reporting the files already inside as added events or to onFileFound */
+    void addWatchRecursively (const juce::File& directory, bool reportExistingFiles, const FileCallback& onFileFound = nullptr);
+
+    /** Stops watching a directory and all of its sub-directories */
+    void removeWatchRecursively (const juce::File& directory);
+
+    /** Updates the watched paths after a directory was moved within the tree */
+    void renameWatchedDirectory (const juce::File& oldDirectory, const juce::File& newDirectory);
+
+    /** Handles a single inotify event */
+    void handleNotification (int watchDescriptor, juce::uint32 mask, juce::uint32 cookie, const juce::String& name);
+
+    /** Reports moves whose other half has not arrived in time as removals */
+    void flushUnpairedMoves (bool flushAll);
+
+    int inotifyFd = -1;
+
+    // Only touched by the watcher thread once it has started
+    std::unordered_map<int, juce::File> watchedDirectories;
+    struct PendingMove
+    {
+        juce::File source;
+        bool isDirectory = false;
+        double timeMs = 0.0;
+    };
+
+    // Moves waiting for their destination half, by cookie, which can arrive in a later read
+    std::unordered_map<juce::uint32, PendingMove> pendingMoves;
+   #endif
+
+    // Events waiting to be delivered, guarded by lock
+    juce::CriticalSection lock;
+    std::vector<Event> pendingEvents;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LibraryWatcher)
+};
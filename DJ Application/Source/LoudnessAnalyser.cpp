@@ -0,0 +1,360 @@
+/*
+  ==============================================================================
+
+    LoudnessAnalyser.cpp
+    Created: 21 Oct 2026 2:36:41pm
+    Author:  Justin  Lim
+
+  ==============================================================================
+*/
+
+#include "LoudnessAnalyser.h"
+
+namespace
+{
+    // Gating of the 400 ms blocks, in LUFS and in LU below the ungated loudness
+    constexpr double absoluteGate = -70.0;
+    constexpr double relativeGate = -10.0;
+
+    // Limits of the normalisation gain in decibels
+    constexpr double maxCut = -24.0;
+    constexpr double maxBoost = 12.0;
+
+    // Returns the loudness of a mean square summed over channels
+    double toLoudness (double power)
+    {
+        return power > 0.0 ? -0.691 + 10.0 * std::log10 (power) : -std::numeric_limits<double>::infinity();
+    }
+
+    // Windowed sinc used to interpolate between samples, zero beyond halfWidth samples
+    double interpolationKernel (double t, int halfWidth)
+    {
+        if (std::abs (t) >= halfWidth)
+            return 0.0;
+
+        auto window = 0.5 * (1.0 + std::cos (juce::MathConstants<double>::pi * t / halfWidth));
+        auto sinc = t == 0.0 ? 1.0 : std::sin (juce::MathConstants<double>::pi * t) / (juce::MathConstants<double>::pi * t);
+
+        return sinc * window;
+    }
+}
+
+//==============================================================================
+// Returns true if the track was measured and is not silent
+bool LoudnessMeasurement::isValid() const
+{
+    return integratedLoudness > silence;
+}
+
+
+// Returns the gain that brings the track to the reference loudness, held back so its peaks stay under the ceiling
+double LoudnessMeasurement::getNormalisationGainInDecibels() const
+{
+    if (! isValid())
+        return 0.0;
+
+    auto gain = referenceLoudness - integratedLoudness;
+
+    if (gain > 0.0)
+        gain = juce::jmax (0.0, juce::jmin (gain, peakCeiling - truePeak));
+
+    return juce::jlimit (maxCut, maxBoost, gain);
+}
+
+
+//==============================================================================
+/*
+    Sets up the K-weighting filter for the track's sample rate.
+
+    The high shelf and high pass are designed from their analogue prototypes
+    rather than taken from the 48 kHz coefficients in BS.1770, so they match the
+    standard at any sample rate.
+
+    A mono track plays through both speakers, so its one channel is counted twice
+    as BS.1770 does for dual mono; otherwise it measures 3 dB quieter than it
+    sounds and normalisation pushes it that much louder than stereo tracks.
+
+    @param sampleRate         Sample rate of the track.
+    @param numChannelsToUse   Number of channels that will be passed to process().
+*/
+LoudnessAnalyser::LoudnessAnalyser (double sampleRate, int numChannelsToUse)
+    : numChannels (juce::jmax (1, numChannelsToUse)),
+      channelWeight (numChannels == 1 ? 2.0 : 1.0),
+      shelfStates ((size_t) numChannels),
+      highPassStates ((size_t) numChannels),
+      samplesPerStep (juce::jmax (1, juce::roundToInt (sampleRate * 0.1))),
+      peakHistory ((size_t) numChannels, std::vector<float> (interpolationLength - 1, 0.0f))
+{
+    // Stage 1, a high shelf of about +4 dB above 1.5 kHz modelling the head
+    {
+        constexpr double f0 = 1681.974450955533;
+        constexpr double gainDb = 3.999843853973347;
+        constexpr double q = 0.7071752369554196;
+
+        auto k = std::tan (juce::MathConstants<double>::pi * f0 / sampleRate);
+        auto vh = std::pow (10.0, gainDb / 20.0);
+        auto vb = std::pow (vh, 0.4996667741545416);
+        auto a0 = 1.0 + k / q + k * k;
+
+        shelf.b0 = (vh + vb * k / q + k * k) / a0;
+        shelf.b1 = 2.0 * (k * k - vh) / a0;
+        shelf.b2 = (vh - vb * k / q + k * k) / a0;
+        shelf.a1 = 2.0 * (k * k - 1.0) / a0;
+        shelf.a2 = (1.0 - k / q + k * k) / a0;
+    }
+
+    // Stage 2, the RLB high pass at about 38 Hz
+    {
+        constexpr double f0 = 38.13547087602444;
+        constexpr double q = 0.5003270373238773;
+
+        auto k = std::tan (juce::MathConstants<double>::pi * f0 / sampleRate);
+        auto a0 = 1.0 + k / q + k * k;
+
+        highPass.b0 = 1.0;
+        highPass.b1 = -2.0;
+        highPass.b2 = 1.0;
+        highPass.a1 = 2.0 * (k * k - 1.0) / a0;
+        highPass.a2 = (1.0 - k / q + k * k) / a0;
+    }
+
+    // Interpolation taps for the three points between each pair of samples
+    for (int phase = 1; phase < oversampling; ++phase)
+    {
+        auto fraction = static_cast<double> (phase) / oversampling;
+        float gain = 0.0f;
+
+        for (int tap = 0; tap < interpolationLength; ++tap)
+        {
+            auto value = static_cast<float> (interpolationKernel (fraction - (tap - (interpolationHalfWidth - 1)), interpolationHalfWidth));
+            phaseTaps[(size_t) phase - 1][(size_t) tap] = value;
+            gain += std::abs (value);
+        }
+
+        maxInterpolationGain = juce::jmax (maxInterpolationGain, gain);
+    }
+}
+
+
+// Weights each channel, adds its mean square to the 100 ms steps and looks for its true peak
+void LoudnessAnalyser::process (const juce::AudioBuffer<float>& buffer, int numSamples)
+{
+    if (numSamples <= 0)
+        return;
+
+    auto channelsToUse = juce::jmin (numChannels, buffer.getNumChannels());
+    filtered.resize ((size_t) numSamples * (size_t) channelsToUse);
+
+    for (int ch = 0; ch < channelsToUse; ++ch)
+    {
+        auto* data = filtered.data() + (size_t) ch * (size_t) numSamples;
+        juce::FloatVectorOperations::copy (data, buffer.getReadPointer (ch), numSamples);
+
+        findTruePeak (ch, data, numSamples);
+
+        filter (shelf, shelfStates[(size_t) ch], data, numSamples);
+        filter (highPass, highPassStates[(size_t) ch], data, numSamples);
+    }
+
+    // Split the block at the step boundaries, the channels are summed with a weight of one each, or two for mono
+    for (int start = 0; start < numSamples;)
+    {
+        auto length = juce::jmin (numSamples - start, samplesPerStep - samplesInStep);
+
+        for (int ch = 0; ch < channelsToUse; ++ch)
+        {
+            auto* data = filtered.data() + (size_t) ch * (size_t) numSamples + start;
+            double sum = 0.0;
+
+            for (int i = 0; i < length; ++i)
+                sum += data[i] * data[i];
+
+            stepSum += channelWeight * sum;
+        }
+
+        samplesInStep += length;
+        start += length;
+
+        if (samplesInStep == samplesPerStep)
+        {
+            stepPowers.push_back (stepSum / samplesPerStep);
+            stepSum = 0.0;
+            samplesInStep = 0;
+        }
+    }
+}
+
+
+/*
+    Runs one biquad over a block.
+
+    The feed-forward sum b0 x[n] + b1 x[n-1] + b2 x[n-2] does not depend on earlier
+    outputs, so it is done for the whole block with three vector multiply-adds over
+    shifted copies of the input. Only the feedback is left to run per sample, in
+    double precision as the high pass has its poles close to the unit circle.
+
+    @param biquad      Coefficients, normalised so a0 is one.
+    @param state       Previous inputs and outputs of the channel.
+    @param data        Block to filter in place.
+    @param numSamples  Length of the block.
+*/
+void LoudnessAnalyser::filter (const Biquad& biquad, BiquadState& state, float* data, int numSamples)
+{
+    feedForward.resize ((size_t) numSamples + 2);
+
+    auto* input = feedForward.data() + 2;
+    feedForward[0] = state.x2;
+    feedForward[1] = state.x1;
+    juce::FloatVectorOperations::copy (input, data, numSamples);
+
+    state.x2 = numSamples > 1 ? input[numSamples - 2] : state.x1;
+    state.x1 = input[numSamples - 1];
+
+    juce::FloatVectorOperations::copyWithMultiply (data, input, static_cast<float> (biquad.b0), numSamples);
+    juce::FloatVectorOperations::addWithMultiply  (data, input - 1, static_cast<float> (biquad.b1), numSamples);
+    juce::FloatVectorOperations::addWithMultiply  (data, input - 2, static_cast<float> (biquad.b2), numSamples);
+
+    auto y1 = state.y1, y2 = state.y2;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        auto y = data[i] - biquad.a1 * y1 - biquad.a2 * y2;
+        y2 = y1;
+        y1 = y;
+        data[i] = static_cast<float> (y);
+    }
+
+    state.y1 = y1;
+    state.y2 = y2;
+}
+
+
+/*
+    Raises the true peak with one channel's block.
+
+    The block is appended to the channel's last samples so the points between
+    samples can be interpolated right up to the block boundary. Points are
+    interpolated in runs of 64: a run is skipped when even the loudest of the
+    samples it depends on could not reach the current peak through the kernel.
+
+    @param channel      Channel the block belongs to.
+    @param data         Unweighted samples of the block.
+    @param numSamples   Length of the block.
+*/
+void LoudnessAnalyser::findTruePeak (int channel, const float* data, int numSamples)
+{
+    constexpr int runLength = 64;
+
+    auto& history = peakHistory[(size_t) channel];
+    auto historyLength = static_cast<int> (history.size());
+    auto length = historyLength + numSamples;
+
+    peakScratch.resize ((size_t) length);
+    std::copy (history.begin(), history.end(), peakScratch.begin());
+    juce::FloatVectorOperations::copy (peakScratch.data() + historyLength, data, numSamples);
+
+    auto samplePeak = juce::FloatVectorOperations::findMinAndMax (data, numSamples);
+    peak = juce::jmax (peak, -samplePeak.getStart(), samplePeak.getEnd());
+
+    // The point after sample i needs samples i - halfWidth + 1 to i + halfWidth
+    auto first = interpolationHalfWidth - 1;
+    auto last = length - interpolationHalfWidth;
+
+    for (int runStart = first; runStart < last; runStart += runLength)
+    {
+        auto runEnd = juce::jmin (last, runStart + runLength);
+        auto* window = peakScratch.data() + runStart - first;
+
+        auto range = juce::FloatVectorOperations::findMinAndMax (window, runEnd - runStart + interpolationLength - 1);
+
+        if (juce::jmax (-range.getStart(), range.getEnd()) * maxInterpolationGain <= peak)
+            continue;
+
+        for (int i = runStart; i < runEnd; ++i)
+        {
+            auto* samples = peakScratch.data() + i - first;
+
+            for (auto& taps : phaseTaps)
+            {
+                float value = 0.0f;
+
+                for (int tap = 0; tap < interpolationLength; ++tap)
+                    value += samples[tap] * taps[(size_t) tap];
+
+                peak = juce::jmax (peak, std::abs (value));
+            }
+        }
+    }
+
+    std::copy (peakScratch.end() - historyLength, peakScratch.end(), history.begin());
+}
+
+
+/*
+    Gates the 400 ms blocks and returns the integrated loudness and true peak.
+
+    Each block is four consecutive 100 ms steps. Blocks under -70 LUFS are dropped,
+    then blocks more than 10 LU under the loudness of those left.
+
+    @return     The measurement, invalid if the track is silent or shorter than a block.
+*/
+LoudnessMeasurement LoudnessAnalyser::getMeasurement() const
+{
+    constexpr size_t stepsPerBlock = 4;
+
+    LoudnessMeasurement measurement;
+
+    if (peak > 0.0f)
+        measurement.truePeak = juce::Decibels::gainToDecibels (static_cast<double> (peak), LoudnessMeasurement::silence);
+
+    if (stepPowers.size() < stepsPerBlock)
+        return measurement;
+
+    std::vector<double> blockPowers;
+    blockPowers.reserve (stepPowers.size());
+
+    double windowSum = 0.0;
+
+    for (size_t i = 0; i < stepPowers.size(); ++i)
+    {
+        windowSum += stepPowers[i];
+
+        if (i >= stepsPerBlock)
+            windowSum -= stepPowers[i - stepsPerBlock];
+
+        if (i + 1 >= stepsPerBlock)
+            blockPowers.push_back (juce::jmax (0.0, windowSum / stepsPerBlock));
+    }
+
+    // Mean power of the blocks louder than a gate
+    auto gatedMean = [&blockPowers] (double gate, int& numBlocks)
+    {
+        double sum = 0.0;
+        numBlocks = 0;
+
+        for (auto power : blockPowers)
+        {
+            if (toLoudness (power) > gate)
+            {
+                sum += power;
+                ++numBlocks;
+            }
+        }
+
+        return numBlocks > 0 ? sum / numBlocks : 0.0;
+    };
+
+    int numBlocks = 0;
+    auto ungated = gatedMean (absoluteGate, numBlocks);
+
+    if (numBlocks == 0)
+        return measurement;
+
+    auto gate = juce::jmax (absoluteGate, toLoudness (ungated) + relativeGate);
+    auto integrated = gatedMean (gate, numBlocks);
+
+    if (numBlocks > 0)
+        measurement.integratedLoudness = toLoudness (integrated);
+
+    return measurement;
+}
@@ -0,0 +1,119 @@
+/*
+  ==============================================================================
+
+    LoudnessAnalyser.h
+    Created: 21 Oct 2026 2:36:41pm
+    Author:  Justin  Lim
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/**
+    Integrated loudness and true peak of a track, and the gain that brings it to the
+    level every deck plays at.
+*/
+struct LoudnessMeasurement
+{
+    /** Loudness of silence, and of tracks that have not been measured */
+    static constexpr double silence = -70.0;
+
+    /** Level, in LUFS, every track is brought to */
+    static constexpr double referenceLoudness = -14.0;
+
+    /** Highest true peak, in dBTP, the gain may push a track to */
+    static constexpr double peakCeiling = -1.0;
+
+    /** Returns true if the track was measured and is not silent */
+    bool isValid() const;
+
+    /** Returns the gain in decibels that brings the track to the reference loudness without pushing its peaks over the ceiling */
+    double getNormalisationGainInDecibels() const;
+
+    double integratedLoudness = silence;   // LUFS
+    double truePeak = silence;             // dBTP
+};
+
+
+/**
+    Measures the integrated loudness and true peak of a track as in EBU R128 and
+    ITU-R BS.1770.
+
+    Each channel goes through the K-weighting filter, a high shelf followed by a
+    high pass. The feed-forward half of each biquad is computed for the whole
+    block with vector operations, leaving only the two-tap recursion per sample.
+    The mean square is taken over 400 ms blocks overlapping by 75% and gated at
+    -70 LUFS and then 10 LU below the ungated mean.
+
+    The true peak is the highest sample of the signal upsampled four times with a
+    windowed sinc. Stretches whose samples are too quiet to beat the highest peak
+    so far, whatever falls between them, are skipped without being upsampled.
+
+    Feed the track in order with process(), then call getMeasurement().
+*/
+class LoudnessAnalyser
+{
+public:
+    LoudnessAnalyser (double sampleRate, int numChannelsToUse);
+
+    /** Adds the next block of the track */
+    void process (const juce::AudioBuffer<float>& buffer, int numSamples);
+
+    /** Returns the loudness and true peak of everything processed so far */
+    LoudnessMeasurement getMeasurement() const;
+
+private:
+    struct Biquad
+    {
+        double b0 = 1.0, b1 = 0.0, b2 = 0.0, a1 = 0.0, a2 = 0.0;
+    };
+
+    struct BiquadState
+    {
+        float x1 = 0.0f, x2 = 0.0f;
+        double y1 = 0.0, y2 = 0.0;
+    };
+
+    // Filters a block in place through one biquad
+    void filter (const Biquad& biquad, BiquadState& state, float* data, int numSamples);
+
+    // Raises the true peak with the upsampled values of one channel's block
+    void findTruePeak (int channel, const float* data, int numSamples);
+
+    static constexpr int oversampling = 4;
+    static constexpr int interpolationHalfWidth = 6;
+    static constexpr int interpolationLength = 2 * interpolationHalfWidth;
+
+    int numChannels = 0;
+
+    // Weight of each channel in the sum, two for a mono track played on both speakers
+    double channelWeight = 1.0;
+
+    // K-weighting stages and the state of each per channel
+    Biquad shelf, highPass;
+    std::vector<BiquadState> shelfStates, highPassStates;
+
+    // Scratch space for the filters
+    std::vector<float> filtered;
+    std::vector<float> feedForward;
+
+    // Mean square of each 100 ms step, summed over the channels
+    int samplesPerStep = 0;
+    int samplesInStep = 0;
+    double stepSum = 0.0;
+    std::vector<double> stepPowers;
+
+    // Interpolation taps of each fractional phase, and the most any phase can amplify a sample
+    std::array<std::array<float, interpolationLength>, oversampling - 1> phaseTaps;
+    float maxInterpolationGain = 0.0f;
+
+    // Last samples of each channel, so interpolation runs across block boundaries
+    std::vector<std::vector<float>> peakHistory;
+    std::vector<float> peakScratch;
+    float peak = 0.0f;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LoudnessAnalyser)
+};
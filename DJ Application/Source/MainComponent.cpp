@@ -1,77 +1,161 @@
-#include "MainComponent.h"
-
-MainComponent::MainComponent()
-{
-    // Set the size of the component
-    setSize(800, 600);
-
-    // Request audio recording permissions if required
-    if (juce::RuntimePermissions::isRequired(juce::RuntimePermissions::recordAudio)
-        && !juce::RuntimePermissions::isGranted(juce::RuntimePermissions::recordAudio))
-    {
-        juce::RuntimePermissions::request(juce::RuntimePermissions::recordAudio,
-            [this](bool granted) { if (granted) setAudioChannels(2, 2); });
-    }
-    else
-    {
-        // Specify the number of input and output channels
-        setAudioChannels(0, 2);
-    }
-
-    // Add child components and make them visible
-    addAndMakeVisible(deckGUI1);
-    addAndMakeVisible(deckGUI2);
-    addAndMakeVisible(playlistComponent);
-}
-
-MainComponent::~MainComponent()
-{
-    // Shutdown the audio device and clear the audio sources
-    shutdownAudio();
-}
-
-void MainComponent::prepareToPlay(int samplesPerBlockExpected, double sampleRate)
-{
-    // Add input sources to the mixer
-    mixerSource.addInputSource(&player1, false);
-    mixerSource.addInputSource(&player2, false);
-
-    // Prepare individual players
-    player1.prepareToPlay(samplesPerBlockExpected, sampleRate);
-    player2.prepareToPlay(samplesPerBlockExpected, sampleRate);
-}
-
-void MainComponent::getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill)
-{
-    // Get the next audio block from the mixer source
-    mixerSource.getNextAudioBlock(bufferToFill);
-}
-
-void MainComponent::releaseResources()
-{
-    // Remove all inputs from the mixer and release resources
-    mixerSource.removeAllInputs();
-    mixerSource.releaseResources();
-
-    // Release resources for individual players
-    player1.releaseResources();
-    player2.releaseResources();
-}
-
-void MainComponent::paint(juce::Graphics& g)
-{
-    // Fill the component background with the window's background color
-    g.fillAll(getLookAndFeel().findColour(juce::ResizableWindow::backgroundColourId));
-}
-
-void MainComponent::resized()
-{
-    // Calculate dimensions for child components based on the component size
-    double columnW = getWidth() / 2;
-    double rowH = getHeight() / 3;
-
-    // Set bounds for child components
-    deckGUI1.setBounds(0, 0, columnW, rowH * 2);
-    deckGUI2.setBounds(columnW, 0, columnW, rowH * 2);
-    playlistComponent.setBounds(0, rowH * 2, columnW * 2, rowH);
-}
+#include "MainComponent.h"
+
+MainComponent::MainComponent()
+{
+    // Set the size of the component
+    setSize(800, 600);
+
+    // Request audio recording permissions if required
+    if (juce::RuntimePermissions::isRequired(juce::RuntimePermissions::recordAudio)
+        && !juce::RuntimePermissions::isGranted(juce::RuntimePermissions::recordAudio))
+    {
+        juce::RuntimePermissions::request(juce::RuntimePermissions::recordAudio,
+            [this](bool granted) { if (granted) setAudioChannels(2, 2); });
+    }
+    else
+    {
+        // Specify the number of input and output channels
+        setAudioChannels(0, 2);
+    }
+
+    // Each deck's sync button follows the other deck
+    deckGUI1.setSyncPartner(&player2);
+    deckGUI2.setSyncPartner(&player1);
+
+    // Left deck on side A of the crossfader, right deck on side B, the automixer unaffected by it
+    auto deck1Channel = masterMixer.addChannel(&player1, MasterMixer::Side::a);
+    auto deck2Channel = masterMixer.addChannel(&player2, MasterMixer::Side::b);
+    masterMixer.addChannel(&autoMixer, MasterMixer::Side::thru);
+
+    // Each deck's volume slider is its channel fader
+    deckGUI1.onVolumeChanged = [this, deck1Channel](double gain) { masterMixer.setChannelGain(deck1Channel, static_cast<float>(gain)); };
+    deckGUI2.onVolumeChanged = [this, deck2Channel](double gain) { masterMixer.setChannelGain(deck2Channel, static_cast<float>(gain)); };
+
+    // Crossfader properties
+    crossfaderSlider.setSliderStyle(juce::Slider::LinearHorizontal);
+    crossfaderSlider.setTextBoxStyle(juce::Slider::NoTextBox, false, 0, 0);
+    crossfaderSlider.setRange(0.0, 1.0);
+    crossfaderSlider.setValue(0.5, juce::dontSendNotification);
+    crossfaderSlider.setDoubleClickReturnValue(true, 0.5);
+    crossfaderSlider.onValueChange = [this] { masterMixer.setCrossfaderPosition(static_cast<float>(crossfaderSlider.getValue())); };
+
+    crossfaderCurveBox.addItem("Linear", 1);
+    crossfaderCurveBox.addItem("Constant power", 2);
+    crossfaderCurveBox.addItem("Sharp cut", 3);
+    crossfaderCurveBox.setSelectedId(2, juce::dontSendNotification);
+    crossfaderCurveBox.onChange = [this]
+    {
+        masterMixer.setCrossfaderCurve(static_cast<MasterMixer::Curve>(crossfaderCurveBox.getSelectedId() - 1));
+    };
+
+    // Add child components and make them visible
+    addAndMakeVisible(deckGUI1);
+    addAndMakeVisible(deckGUI2);
+    addAndMakeVisible(playlistComponent);
+    addAndMakeVisible(crossfaderSlider);
+    addAndMakeVisible(crossfaderCurveBox);
+    addChildComponent(profilerOverlay);
+
+    // Key presses the children do not use reach the profiler shortcuts
+    setWantsKeyboardFocus(true);
+}
+
+MainComponent::~MainComponent()
+{
+    if (keyListenerWindow != nullptr)
+        keyListenerWindow->removeKeyListener(this);
+
+    // Shutdown the audio device and clear the audio sources
+    shutdownAudio();
+}
+
+void MainComponent::prepareToPlay(int samplesPerBlockExpected, double sampleRate)
+{
+    // Size the mixer's buffers for the device's blocks
+    masterMixer.prepareToPlay(samplesPerBlockExpected, sampleRate);
+
+    // Prepare individual players
+    player1.prepareToPlay(samplesPerBlockExpected, sampleRate);
+    player2.prepareToPlay(samplesPerBlockExpected, sampleRate);
+    autoMixer.prepareToPlay(samplesPerBlockExpected, sampleRate);
+}
+
+void MainComponent::getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill)
+{
+    // Get the next audio block from the master mixer
+    masterMixer.getNextAudioBlock(bufferToFill);
+}
+
+void MainComponent::releaseResources()
+{
+    // Release the mixer's resources, its channels stay connected for the next device
+    masterMixer.releaseResources();
+
+    // Release resources for individual players
+    player1.releaseResources();
+    player2.releaseResources();
+    autoMixer.releaseResources();
+}
+
+void MainComponent::paint(juce::Graphics& g)
+{
+    // Fill the component background with the window's background color
+    g.fillAll(getLookAndFeel().findColour(juce::ResizableWindow::backgroundColourId));
+}
+
+void MainComponent::resized()
+{
+    // Calculate dimensions for child components based on the component size
+    double columnW = getWidth() / 2;
+    double rowH = getHeight() / 3;
+    int crossfaderH = 24;
+    int curveBoxW = 130;
+
+    // Set bounds for child components, the crossfader strip sits at the bottom of the decks
+    deckGUI1.setBounds(0, 0, columnW, rowH * 2 - crossfaderH);
+    deckGUI2.setBounds(columnW, 0, columnW, rowH * 2 - crossfaderH);
+    crossfaderSlider.setBounds(columnW / 2, rowH * 2 - crossfaderH, columnW, crossfaderH);
+    crossfaderCurveBox.setBounds(columnW * 2 - curveBoxW - 5, rowH * 2 - crossfaderH + 2, curveBoxW, crossfaderH - 4);
+    playlistComponent.setBounds(0, rowH * 2, columnW * 2, rowH);
+    profilerOverlay.setBounds(getWidth() - 430, 0, 430, profilerOverlay.getPreferredHeight());
+}
+
+bool MainComponent::keyPressed(const juce::KeyPress& key)
+{
+    if (key.getKeyCode() != juce::KeyPress::F12Key)
+        return false;
+
+    // Shift+F12 starts or stops a trace, F12 on its own shows or hides the overlay
+    if (key.getModifiers().isShiftDown())
+        profilerOverlay.toggleTrace();
+    else
+        profilerOverlay.setProfiling(!profilerOverlay.isVisible());
+
+    return true;
+}
+
+// Keys only reach this component while something inside it has focus, which nothing has until it is clicked
+// Listening on the window as well makes F12 work as soon as the window opens
+void MainComponent::parentHierarchyChanged()
+{
+    auto* window = getTopLevelComponent();
+
+    if (window == this)
+        window = nullptr;
+
+    if (window == keyListenerWindow.getComponent())
+        return;
+
+    if (keyListenerWindow != nullptr)
+        keyListenerWindow->removeKeyListener(this);
+
+    keyListenerWindow = window;
+
+    if (window != nullptr)
+        window->addKeyListener(this);
+}
+
+bool MainComponent::keyPressed(const juce::KeyPress& key, juce::Component*)
+{
+    return keyPressed(key);
+}
@@ -1,43 +1,76 @@
-#pragma once
-
-#include <JuceHeader.h>
-#include "DJAudioPlayer.h"
-#include "DeckGUI.h"
-#include "PlaylistComponent.h"
-
-//==============================================================================
-class MainComponent : public juce::AudioAppComponent
-{
-public:
-    MainComponent();
-    ~MainComponent() override;
-    void prepareToPlay(int samplesPerBlockExpected, double sampleRate) override;
-    void getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill) override;
-    void releaseResources() override;
-    void paint(juce::Graphics& g) override;
-    void resized() override;
-
-private:
-    // Format manager for handling audio formats
-    juce::AudioFormatManager formatManager;
-
-    // Audio thumbnail cache managing other audio thumbnail objects
-    juce::AudioThumbnailCache thumbCache{ 100 };
-
-    // Mixer source for handling the output mixing of other AudioSources
-    juce::MixerAudioSource mixerSource;
-
-    // DJAudioPlayer instances
-    DJAudioPlayer player1{ formatManager };
-    DJAudioPlayer player2{ formatManager };
-    DJAudioPlayer player{ formatManager };
-
-    // DeckGUI instances
-    DeckGUI deckGUI1{ &player1, formatManager, thumbCache };
-    DeckGUI deckGUI2{ &player2, formatManager, thumbCache };
-
-    // PlaylistComponent instance
-    PlaylistComponent playlistComponent{ formatManager, &player, &deckGUI1, &deckGUI2 };
-
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MainComponent)
-};
+#pragma once
+
+#include <JuceHeader.h>
+#include "DJAudioPlayer.h"
+#include "DeckGUI.h"
+#include "PlaylistComponent.h"
+#include "MasterMixer.h"
+#include "RefreshScheduler.h"
+#include "FrameProfilerOverlay.h"
+
+//==============================================================================
+class MainComponent : public juce::AudioAppComponent,
+                      private juce::KeyListener
+{
+public:
+    MainComponent();
+    ~MainComponent() override;
+    void prepareToPlay(int samplesPerBlockExpected, double sampleRate) override;
+    void getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill) override;
+    void releaseResources() override;
+    void paint(juce::Graphics& g) override;
+    void resized() override;
+
+    /** F12 shows the frame profiler, Shift+F12 records a trace */
+    bool keyPressed(const juce::KeyPress& key) override;
+
+    /** Listens for the profiler shortcuts on the window once the component is placed in one */
+    void parentHierarchyChanged() override;
+
+private:
+    // Receives the keys the window gets while nothing inside it has focus
+    bool keyPressed(const juce::KeyPress& key, juce::Component* originatingComponent) override;
+
+    // Format manager for handling audio formats
+    juce::AudioFormatManager formatManager;
+
+    // Audio thumbnail cache managing other audio thumbnail objects
+    juce::AudioThumbnailCache thumbCache{ 100 };
+
+    // Mixes the decks and the automixer to the output through the crossfader
+    MasterMixer masterMixer;
+
+    // DJAudioPlayer instances
+    DJAudioPlayer player1{ formatManager };
+    DJAudioPlayer player2{ formatManager };
+    DJAudioPlayer player{ formatManager };
+
+    // Decodes the next song of each deck and the automixer's songs into memory, all within one memory budget
+    static constexpr size_t preloadMemoryBudget = (size_t) 768 << 20;
+    TrackPreloader trackPreloader{ formatManager, preloadMemoryBudget };
+
+    // Mixes the playlist unattended, alongside the decks
+    AutoMixer autoMixer{ trackPreloader };
+
+    // Refreshes the decks once per screen refresh, in place of a timer per display
+    RefreshScheduler refreshScheduler{ *this };
+
+    // DeckGUI instances
+    DeckGUI deckGUI1{ &player1, formatManager, thumbCache, refreshScheduler };
+    DeckGUI deckGUI2{ &player2, formatManager, thumbCache, refreshScheduler };
+
+    // PlaylistComponent instance
+    PlaylistComponent playlistComponent{ formatManager, &player, &deckGUI1, &deckGUI2, &autoMixer, &trackPreloader };
+
+    // Crossfader between the left and right decks, and the curve it follows
+    juce::Slider crossfaderSlider;
+    juce::ComboBox crossfaderCurveBox;
+
+    // Debug overlay with the paint times of the UI, hidden until F12 is pressed
+    FrameProfilerOverlay profilerOverlay{ refreshScheduler };
+
+    // Window the profiler shortcuts are listened for on
+    juce::Component::SafePointer<juce::Component> keyListenerWindow;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MainComponent)
+};
@@ -0,0 +1,220 @@
+/*
+  ==============================================================================
+
+    MasterMixer.cpp
+    Created: 22 Oct 2026 5:12:26pm
+    Author:  Justin  Lim
+
+  ==============================================================================
+*/
+
+#include "MasterMixer.h"
+
+namespace
+{
+    // Part of the sharp cut curve's travel over which a side actually fades
+    constexpr float sharpCutLength = 0.05f;
+}
+
+//==============================================================================
+MasterMixer::MasterMixer() {}
+
+MasterMixer::~MasterMixer() {}
+
+
+// Sizes the scratch buffers for the largest block the device announced, the sources are prepared by their owners
+void MasterMixer::prepareToPlay (int samplesPerBlockExpected, double newSampleRate)
+{
+    const juce::ScopedLock sl (lock);
+
+    sampleRate = newSampleRate;
+    maxBlockSize = juce::jmax (1, samplesPerBlockExpected);
+    registersPerChannel = (maxBlockSize + (int) Register::SIMDNumElements - 1) / (int) Register::SIMDNumElements;
+
+    mixBuffer.assign ((size_t) (numMixChannels * registersPerChannel), Register::expand (0.0f));
+
+    for (auto& channel : channels)
+        allocateChannelBuffer (*channel);
+}
+
+
+/*
+    Mixes every channel into the block.
+
+    Blocks longer than the device announced are mixed in stretches that fit the
+    scratch buffers, so they are never reallocated here. Nothing here waits for
+    another thread: if a channel is being added or removed, the block is left
+    silent.
+*/
+void MasterMixer::getNextAudioBlock (const juce::AudioSourceChannelInfo& bufferToFill)
+{
+    const juce::ScopedTryLock sl (lock);
+
+    auto& output = *bufferToFill.buffer;
+
+    if (! sl.isLocked() || maxBlockSize == 0 || channels.empty())
+    {
+        bufferToFill.clearActiveBufferRegion();
+        return;
+    }
+
+    for (int done = 0; done < bufferToFill.numSamples;)
+    {
+        auto numSamples = juce::jmin (bufferToFill.numSamples - done, maxBlockSize);
+        mixStretch (output, bufferToFill.startSample + done, numSamples);
+        done += numSamples;
+    }
+
+    for (int ch = numMixChannels; ch < output.getNumChannels(); ++ch)
+        output.clear (ch, bufferToFill.startSample, bufferToFill.numSamples);
+}
+
+
+void MasterMixer::releaseResources()
+{
+}
+
+
+/*
+    Renders every channel, then mixes them in one pass over the output.
+
+    Each channel's gain ramps linearly from where the last stretch left it to the
+    gain its fader and the crossfader now ask for, so moving either never clicks.
+    The kernel keeps the ramps in registers, one lane per sample, and adds the
+    channels into both sides of the mix before moving on to the next register.
+
+    @param output            Buffer to write the mix to.
+    @param startSample       Where the stretch starts in the buffer.
+    @param numSamples        Length of the stretch, at most maxBlockSize.
+*/
+void MasterMixer::mixStretch (juce::AudioBuffer<float>& output, int startSample, int numSamples)
+{
+    constexpr auto lanes = Register::SIMDNumElements;
+
+    auto numRegisters = (numSamples + (int) lanes - 1) / (int) lanes;
+    auto paddedLength = numRegisters * (int) lanes;
+    auto position = crossfaderPosition.load();
+    auto curve = crossfaderCurve.load();
+
+    for (size_t index = 0; index < channels.size(); ++index)
+    {
+        auto& channel = *channels[index];
+
+        juce::AudioBuffer<float> channelBuffer (channel.channelPointers.data(), numMixChannels, numSamples);
+        channel.source -> getNextAudioBlock (juce::AudioSourceChannelInfo (&channelBuffer, 0, numSamples));
+
+        // The kernel works in whole registers, so the samples past the stretch must be silent
+        for (auto* samples : channel.channelPointers)
+            std::fill (samples + numSamples, samples + paddedLength, 0.0f);
+
+        auto targetGain = channel.fader.load() * getCrossfaderGain (channel.side, position, curve);
+        auto step = (targetGain - channel.lastGain) / (float) numSamples;
+
+        alignas (Register::SIMDRegisterSize) float ramp[lanes];
+
+        for (size_t lane = 0; lane < lanes; ++lane)
+            ramp[lane] = channel.lastGain + step * (float) (lane + 1);
+
+        gains[index] = Register::fromRawArray (ramp);
+        gainSteps[index] = Register::expand (step * (float) lanes);
+        channel.lastGain = targetGain;
+    }
+
+    auto* left  = mixBuffer.data();
+    auto* right = mixBuffer.data() + registersPerChannel;
+
+    for (int r = 0; r < numRegisters; ++r)
+    {
+        auto leftSum  = Register::expand (0.0f);
+        auto rightSum = Register::expand (0.0f);
+
+        for (size_t index = 0; index < channels.size(); ++index)
+        {
+            auto* samples = channels[index] -> samples.data();
+            auto gain = gains[index];
+
+            leftSum  += samples[r] * gain;
+            rightSum += samples[registersPerChannel + r] * gain;
+            gains[index] = gain + gainSteps[index];
+        }
+
+        left[r]  = leftSum;
+        right[r] = rightSum;
+    }
+
+    for (int ch = 0; ch < juce::jmin (numMixChannels, output.getNumChannels()); ++ch)
+        juce::FloatVectorOperations::copy (output.getWritePointer (ch, startSample),
+                                           reinterpret_cast<const float*> (mixBuffer.data() + ch * registersPerChannel), numSamples);
+}
+
+
+//==============================================================================
+// Adds a source as a new channel, its buffers are allocated here rather than on the audio thread
+int MasterMixer::addChannel (juce::AudioSource* source, Side side)
+{
+    auto channel = std::make_unique<Channel>();
+    channel -> source = source;
+    channel -> side = side;
+
+    const juce::ScopedLock sl (lock);
+
+    allocateChannelBuffer (*channel);
+    channels.push_back (std::move (channel));
+
+    gains.resize (channels.size());
+    gainSteps.resize (channels.size());
+
+    return static_cast<int> (channels.size()) - 1;
+}
+
+
+// Set a channel's fader gain
+// The list only changes on the message thread, so it is read here without the lock and the fader is an atomic
+void MasterMixer::setChannelGain (int channelIndex, float gain)
+{
+    if (juce::isPositiveAndBelow (channelIndex, (int) channels.size()))
+        channels[(size_t) channelIndex] -> fader = juce::jmax (0.0f, gain);
+}
+
+
+// Set the crossfader, 0 is fully on side A and 1 fully on side B
+void MasterMixer::setCrossfaderPosition (float position)
+{
+    crossfaderPosition = juce::jlimit (0.0f, 1.0f, position);
+}
+
+
+// Set the curve the crossfader follows
+void MasterMixer::setCrossfaderCurve (Curve curve)
+{
+    crossfaderCurve = curve;
+}
+
+
+// Returns the gain the crossfader gives a side, measured by how far the fader has moved away from it
+float MasterMixer::getCrossfaderGain (Side side, float position, Curve curve)
+{
+    if (side == Side::thru)
+        return 1.0f;
+
+    auto distance = juce::jlimit (0.0f, 1.0f, side == Side::a ? position : 1.0f - position);
+
+    switch (curve)
+    {
+        case Curve::linear:         return 1.0f - distance;
+        case Curve::constantPower:  return std::cos (distance * juce::MathConstants<float>::halfPi);
+        case Curve::sharpCut:       return juce::jmin (1.0f, (1.0f - distance) / sharpCutLength);
+    }
+
+    return 1.0f;
+}
+
+
+// Sizes a channel's scratch buffer, one row of registers per mixed channel
+void MasterMixer::allocateChannelBuffer (Channel& channel)
+{
+    channel.samples.assign ((size_t) (numMixChannels * juce::jmax (1, registersPerChannel)), Register::expand (0.0f));
+
+    for (int ch = 0; ch < numMixChannels; ++ch)
+        channel.channelPointers[(size_t) ch] = reinterpret_cast<float*> (channel.samples.data() + ch * registersPerChannel);
+}
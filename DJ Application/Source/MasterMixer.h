@@ -0,0 +1,113 @@
+/*
+  ==============================================================================
+
+    MasterMixer.h
+    Created: 22 Oct 2026 5:12:26pm
+    Author:  Justin  Lim
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/**
+    Mixes the decks to the output through channel faders and a crossfader.
+
+    Each channel is rendered into its own scratch buffer, then one SIMD kernel
+    walks the output once, ramping every channel's gain from its value in the last
+    block to its new value and summing the channels as it goes. All buffers are
+    sized when a channel is added or the device is prepared, so the audio thread
+    never allocates. It never waits for a lock either, and skips the odd block
+    while a channel is added or removed. The cost of a block grows by one
+    multiply-add per sample for each added channel.
+
+    Channels on side A fade out as the crossfader moves towards B and the other
+    way round; channels that are not assigned to a side are unaffected by it.
+*/
+class MasterMixer : public juce::AudioSource
+{
+public:
+    /** Which side of the crossfader a channel is on */
+    enum class Side
+    {
+        a,
+        b,
+        thru
+    };
+
+    /** How the two sides' gains follow the crossfader */
+    enum class Curve
+    {
+        linear,         // gains fall in a straight line, the mix dips in the middle
+        constantPower,  // sin and cos curves, the mix stays level across the fader
+        sharpCut        // both sides at full gain until the last few percent, for cutting between decks
+    };
+
+    MasterMixer();
+    ~MasterMixer() override;
+
+    //==============================================================================
+    void prepareToPlay (int samplesPerBlockExpected, double sampleRate) override;
+    void getNextAudioBlock (const juce::AudioSourceChannelInfo& bufferToFill) override;
+    void releaseResources() override;
+
+    //==============================================================================
+    /** Adds a source as a new channel and returns its index, the mixer does not own the source; call on the message thread */
+    int addChannel (juce::AudioSource* source, Side side);
+
+    /** Set a channel's fader gain, from 0 upwards; call on the message thread */
+    void setChannelGain (int channelIndex, float gain);
+
+    /** Set the crossfader, 0 is fully on side A and 1 fully on side B */
+    void setCrossfaderPosition (float position);
+
+    /** Set the curve the crossfader follows */
+    void setCrossfaderCurve (Curve curve);
+
+    /** Returns the gain the crossfader gives a side at a position */
+    static float getCrossfaderGain (Side side, float position, Curve curve);
+
+private:
+    using Register = juce::dsp::SIMDRegister<float>;
+
+    // Output channels rendered, outputs beyond these are left silent
+    static constexpr int numMixChannels = 2;
+
+    struct Channel
+    {
+        juce::AudioSource* source = nullptr;
+        Side side = Side::thru;
+        std::atomic<float> fader { 1.0f };
+
+        // Audio thread only: the gain reached at the end of the last block, and this channel's rendered audio
+        float lastGain = 0.0f;
+        std::vector<Register> samples;
+        std::array<float*, numMixChannels> channelPointers {};
+    };
+
+    // Sizes a channel's scratch buffer for the current block size
+    void allocateChannelBuffer (Channel& channel);
+
+    // Renders and mixes one stretch of the output, at most maxBlockSize samples long
+    void mixStretch (juce::AudioBuffer<float>& output, int startSample, int numSamples);
+
+    // Held while the channel list or buffers change, the audio thread only tries it and skips the block if it is taken
+    juce::CriticalSection lock;
+    std::vector<std::unique_ptr<Channel>> channels;
+
+    std::atomic<float> crossfaderPosition { 0.5f };
+    std::atomic<Curve> crossfaderCurve { Curve::constantPower };
+
+    double sampleRate = 0.0;
+    int maxBlockSize = 0;
+    int registersPerChannel = 0;
+
+    // Audio thread scratch space for the mixed output, and each channel's gain ramp for the stretch
+    std::vector<Register> mixBuffer;
+    std::vector<Register> gains;
+    std::vector<Register> gainSteps;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MasterMixer)
+};
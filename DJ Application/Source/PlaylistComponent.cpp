@@ -1,418 +1,1273 @@
-/*
-  ==============================================================================
-
-    PlaylistComponent.cpp
-    Created: 4 Mar 2024 7:37:49pm
-    Author:  Justin  Lim
-
-  ==============================================================================
-*/
-
-// Start of Added Code file "PlaylistComponent", everything in the code below is added on top of starter code
-#include <JuceHeader.h>
-#include <juce_gui_basics/juce_gui_basics.h>
-#include "PlaylistComponent.h"
-
-PlaylistComponent::PlaylistComponent(juce::AudioFormatManager& _formatManager,
-                                     DJAudioPlayer*      _player,
-                                     DeckGUI*            _deckGUI1,
-                                     DeckGUI*            _deckGUI2
-                                     ): formatManager(_formatManager),
-                                        player(_player),
-                                        deckGUI1(_deckGUI1),
-                                        deckGUI2(_deckGUI2)
-{
-    formatManager.registerBasicFormats();
-    
-    // Create a new directory and store the music files if it does not exist
-    musicFolder.createDirectory();
-    
-    // Load songs into the library
-    loadExistingSongsToLibrary();
-    
-    // Making the table element visible
-    addAndMakeVisible (tableComponent);
-    addAndMakeVisible (addButton);
-    addAndMakeVisible (searchBar);
-    
-    // Registers a listener to receive events when this button's state changes
-    addButton.addListener (this);
-    searchBar.addListener (this);
-    
-    // Add song button properties
-    addButton.setLookAndFeel(&customisation);
-    
-    // Provide a pretext for the search bar (placeholder)
-    searchBar.setText ("Search song...");
-    
-    // Adding column title to the table
-    tableComponent.getHeader().addColumn ("Left", 1, 50);
-    tableComponent.getHeader().addColumn ("Right", 2, 50);
-    tableComponent.getHeader().addColumn ("Title", 3, 500);
-    tableComponent.getHeader().addColumn ("Duration", 4, 100);
-    tableComponent.getHeader().addColumn ("Remove", 5, 50);
-    
-    // Register the PlaylistComponent with the TableListBox as a TableListBoxModel
-    tableComponent.setModel (this);
-}
-
-PlaylistComponent::~PlaylistComponent() {}
-
-
-void PlaylistComponent::paint (juce::Graphics& g)
-{
-    g.fillAll (getLookAndFeel().findColour (juce::ResizableWindow::backgroundColourId));
-
-    g.setColour (juce::Colours::white);
-    g.setFont (16.0f);
-    g.drawText ("PlaylistComponent", getLocalBounds(), juce::Justification::centred, true);   // placeholder text
-}
-
-
-// Adjusts the positions and sizes of UI elements in PlaylistComponent based on its dimensions.
-void PlaylistComponent::resized()
-{
-    double rowH = getHeight() / 10;
-    double columnW = getWidth() / 10;
-    
-    searchBar.setBounds      (0, 0, columnW * 5, rowH);
-    
-    addButton.setBounds      (columnW * 9, 0, columnW, rowH);
-    
-    tableComponent.setBounds (0, rowH, columnW * 10, rowH * 9);
-}
-
-
-// Returns the number of rows in the table
-int PlaylistComponent::getNumRows()
-{
-    return static_cast<int>(audioFileNames.size());
-}
-
-
-// Graphics code for drawing of the background of a row in the table
-void PlaylistComponent::paintRowBackground(juce::Graphics& g, int rowNumber, int width, int height, bool rowIsSelected)
-{
-    if (rowIsSelected)
-    {
-        // Background color for selected row
-        g.fillAll(juce::Colours::darkblue);
-    }
-    else
-    {
-        // Alternate background colors for even and odd rows
-        g.fillAll(rowNumber % 2 == 0 ? juce::Colours::grey : juce::Colours::darkgrey);
-    }
-}
-
-
-
-// Graphic code that draws the contents of each cells
-void PlaylistComponent::paintCell(juce::Graphics &g, int rowNumber, int columnId, int width, int height, bool rowIsSelected)
-{
-    g.setColour(juce::Colours::white);
-    g.setFont(16.0f);
-
-    // Show information based on column ID set
-    switch (columnId)
-    {
-        case 3: // Show the name of inserted trackon clumn
-            g.drawText(audioFileNames[rowNumber], 5, 0, width, height, juce::Justification::left, true);
-            break;
-
-        case 4: // Show the track duration on column
-            g.drawText(audioFileDurations[rowNumber], 5, 0, width, height, juce::Justification::left, true);
-            break;
-
-        default:
-            break;
-    }
-}
-
-
-/*
-    Refreshes the component for a given table cell, creating or updating buttons based on columnId.
-    
-    @param rowNumber             The row number of the cell.
-    @param columnId              The column ID of the cell.
-    @param isRowSelected         Indicates whether the row is selected.
-    @param existingComponentToUpdate   The existing component to update or nullptr if creating a new one.
-    
-    @return                      The updated or new component for the specified cell.
-*/
-juce::Component* PlaylistComponent::refreshComponentForCell (int rowNumber, int columnId, bool isRowSelected, Component *existingComponentToUpdate)
-{
-    juce::String id {std::to_string (rowNumber)};
-    
-    if (columnId == 1)
-    {
-        if (existingComponentToUpdate == nullptr)
-        {
-            juce::TextButton* loadToDeckGUI1Button = new juce::TextButton ("<");
-            existingComponentToUpdate = loadToDeckGUI1Button;
-
-            loadToDeckGUI1Button -> addListener (this);
-            loadToDeckGUI1Button -> setComponentID (id);
-            loadToDeckGUI1Button -> setLookAndFeel (&customisation);
-            
-            if (rowNumber % 2 == 0)
-                loadToDeckGUI1Button -> setColour (juce::TextButton::buttonColourId, lightGrey);
-            else
-                loadToDeckGUI1Button -> setColour (juce::TextButton::buttonColourId, darkGrey);
-        }
-    }
-    else if (columnId == 2)
-    {
-        if (existingComponentToUpdate == nullptr)
-        {
-            juce::TextButton* loadToDeckGUI2Button = new juce::TextButton (">");
-            existingComponentToUpdate = loadToDeckGUI2Button;
-
-            loadToDeckGUI2Button -> addListener (this);
-            loadToDeckGUI2Button -> setComponentID (id);
-            loadToDeckGUI2Button -> setLookAndFeel (&customisation);
-            
-            if (rowNumber % 2 == 0)
-                loadToDeckGUI2Button -> setColour (juce::TextButton::buttonColourId, lightGrey);
-            else
-                loadToDeckGUI2Button -> setColour (juce::TextButton::buttonColourId, darkGrey);
-        }
-    }
-    else if (columnId == 5)
-    {
-        if (existingComponentToUpdate == nullptr)
-        {
-            juce::TextButton* removeButton = new juce::TextButton ("X");
-            existingComponentToUpdate = removeButton;
-
-            removeButton -> addListener (this);
-            removeButton -> setComponentID (id);
-            removeButton -> setLookAndFeel (&customisation);
-            
-            if (rowNumber % 2 == 0)
-                removeButton -> setColour (juce::TextButton::buttonColourId, lightGrey);
-            else
-                removeButton -> setColour (juce::TextButton::buttonColourId, darkGrey);
-        }
-    }
-    
-    return existingComponentToUpdate;
-}
-
-
-// Retrieve the audio duration of a song from the meta data
-void PlaylistComponent::retrieveAudioDurationData()
-{
-    for (auto s: audioFileArray)
-    {
-        if (auto reader = formatManager.createReaderFor (s))
-        {
-            auto lengthInSeconds = reader -> lengthInSamples / reader -> sampleRate;
-            
-            juce::String duration = computeAudioDuration (lengthInSeconds);
-            
-            audioFileDurations.push_back (duration);
-            
-            delete reader;
-        }
-    }
-}
-
-
-// Computing raw audio duration data to mins and secs
-juce::String PlaylistComponent::computeAudioDuration (double lengthInSeconds)
-{
-    // Round to integers
-    int roundedSeconds = std::round(lengthInSeconds);
-    
-    // Convert time to min and sec
-    juce::String minutes = std::to_string (roundedSeconds / 60);
-    juce::String seconds = std::to_string (roundedSeconds % 60);
-    
-    // Display the duration in format of (minutes:seconds)
-    juce::String duration = minutes + " : " + seconds;
-    
-    return duration;
-}
-
-
-// Load songs from the music folder to the library folder
-void PlaylistComponent::loadExistingSongsToLibrary()
-{
-    int numOfSongs;
-    juce::String songName;
-    juce::String songDuration;
-    juce::URL audioURL;
-
-    // Checks if the song library is a folder
-    if (musicFolder.isDirectory())
-    {
-        // Find all mp3 files from music folder
-        musicFolder.findChildFiles(audioFileArray, juce::File::findFiles, false, "*.mp3");
-        
-        // Find the number of audio files inside the music folder
-        numOfSongs = musicFolder.getNumberOfChildFiles(juce::File::findFiles, "*.mp3");
-
-        // Iterate through each file in audioFilesArray and get their file name
-        for (int i = 0; i < numOfSongs; i++)
-        {
-            // Retrieve the song name and push it into a vector
-            songName = audioFileArray[i].getFileNameWithoutExtension();
-            audioFileNames.push_back (songName);
-        }
-        
-        // Retrieve audio duration
-        retrieveAudioDurationData();
-    }
-    else
-    {
-        std::cout << "No music folder found!" << std::endl;
-    }
-}
-
-
-// Adds new songs to the library and saves them in the music folder
-void PlaylistComponent::addNewSongsToLibrary()
-{
-    juce::String songTitle;
-
-    // Create a file chooser dialog for selecting multiple audio files
-    juce::FileChooser chooser{"Choose files to add into the music folder"};
-
-    // Opens the file system dialog and allows the user to select multiple files
-    // Added JUCE_MODAL_LOOPS_PERMITTED=1 into Proprocessors Definitions
-    if (chooser.browseForMultipleFilesToOpen())
-    {
-        for (juce::File &audioFile : chooser.getResults())
-        {
-            juce::File sourceFile(audioFile.getFullPathName());
-            juce::File destinationFile(musicFolder.getFullPathName() + "/" + sourceFile.getFileName());
-
-            // Copy the file to the music folder to persist across app resets
-            if (sourceFile.copyFileTo(destinationFile))
-            {
-                DBG("File copied successfully");
-            }
-            else
-            {
-                DBG("Failed to copy file");
-            }
-            // Set song title for current audio
-            songTitle = audioFile.getFileNameWithoutExtension();
-            // Add song title to vector
-            audioFileNames.push_back(songTitle);
-            // Add audioFile to array
-            audioFileArray.add(audioFile);
-            // Retrieve and process data
-            retrieveAudioDurationData();
-        }
-    }
-}
-
-
-
-// Searches the library for songs based on the search input
-void PlaylistComponent::searchLibrary()
-{
-    juce::String searchInput = searchBar.getText();
-
-    // Check if the song exists in the library
-    bool doesSongExist = std::find(audioFileNames.begin(), audioFileNames.end(), searchInput) != audioFileNames.end();
-
-    // Check for the location of the song
-    auto songLocation = std::find(audioFileNames.begin(), audioFileNames.end(), searchInput);
-
-    // When song exists
-    if (doesSongExist)
-    {
-        std::cout << "searchInput: " << searchInput << ". Song found!" << std::endl;
-
-        // Use std::distance to get the index
-        int index = static_cast<int>(std::distance(audioFileNames.begin(), songLocation));
-
-        tableComponent.selectRow(index);
-
-        repaint();
-    }
-    else
-    {
-        std::cout << "searchInput: " << searchInput << ". No matching songs found." << std::endl;
-    }
-}
-
-
-
-// Search the library when the return key is pressed
-void PlaylistComponent::textEditorReturnKeyPressed (juce::TextEditor& searchBar)
-{
-    searchLibrary();
-}
-
-
-// Return the text editor to its default state when user clicks away
-void PlaylistComponent::textEditorFocusLost (juce::TextEditor& searchBar)
-{
-    searchBar.setText ("Search song...");
-}
-
-
-// Parsing of song URL
-void PlaylistComponent::loadSongToDeck(DeckGUI* deckGUI, int id)
-{
-    juce::URL path = juce::URL (audioFileArray[id]);
-    deckGUI -> loadAudio (path);
-    
-    juce::String songSelected = audioFileNames[id];
-    deckGUI -> updateSongNameLabel (songSelected);
-    
-    juce::String songDuration = audioFileDurations[id];
-    deckGUI -> updateSongDurationLabel (songDuration);
-}
-
-
-// Delete song from library and music folder
-void PlaylistComponent::deleteSongFromLibrary(int id)
-{
-    audioFileArray[id].moveToTrash();
-    
-    audioFileArray.remove (id);
-    audioFileNames.erase (audioFileNames.begin() + id);
-    audioFileDurations.erase (audioFileDurations.begin() + id);
-}
-
-
-// Button listener to handle button clicks
-void PlaylistComponent::buttonClicked(juce::Button* button)
-{
-    // If the "Add" button is clicked
-    if (button == &addButton)
-    {
-        addNewSongsToLibrary();
-        tableComponent.updateContent();
-    }
-    
-    // If the "Load to Left GUI" button is clicked
-    if (button->getButtonText() == "<")
-    {
-        int id = std::stoi(button->getComponentID().toStdString());
-        loadSongToDeck(deckGUI1, id);
-    }
-    
-    // If the "Load to Right GUI" button is clicked
-    if (button->getButtonText() == ">")
-    {
-        int id = std::stoi(button->getComponentID().toStdString());
-        loadSongToDeck(deckGUI2, id);
-    }
-    
-    // If the "Remove" button is clicked
-    if (button->getButtonText() == "X")
-    {
-        int id = std::stoi(button->getComponentID().toStdString());
-        deleteSongFromLibrary(id);
-        tableComponent.updateContent();
-        DBG("PlaylistComponent::removeButton clicked " << id);
-    }
-}
-
-// End of Added Code
+/*
+  ==============================================================================
+
+    PlaylistComponent.cpp
+    Created: 4 Mar 2024 7:37:49pm
+    Author:  Justin  Lim
+
+  ==============================================================================
+*/
+
+// Start of Added Code file "PlaylistComponent", everything in the code below is added on top of starter code
+#include <JuceHeader.h>
+#include <juce_gui_basics/juce_gui_basics.h>
+#include "PlaylistComponent.h"
+#include "FrameProfiler.h"
+
+PlaylistComponent::PlaylistComponent(juce::AudioFormatManager& _formatManager,
+                                     DJAudioPlayer*      _player,
+                                     DeckGUI*            _deckGUI1,
+                                     DeckGUI*            _deckGUI2,
+                                     AutoMixer*          _autoMixer,
+                                     TrackPreloader*     _trackPreloader
+                                     ): formatManager(_formatManager),
+                                        player(_player),
+                                        deckGUI1(_deckGUI1),
+                                        deckGUI2(_deckGUI2),
+                                        autoMixer(_autoMixer),
+                                        trackPreloader(_trackPreloader)
+{
+    formatManager.registerBasicFormats();
+    
+    // Create a new directory and store the music files if it does not exist
+    musicFolder.createDirectory();
+    
+    // Songs probed in the background are streamed into the table in batches
+    libraryScanner.onBatchReady = [this] (std::vector<LibraryEntry>& entries, juce::Array<juce::File>& unreadableFiles)
+    {
+        libraryScanBatchReady (entries, unreadableFiles);
+    };
+    libraryScanner.onScanFinished = [this] { libraryScanFinished(); };
+    
+    // Imported songs are added to the table as they finish
+    libraryImporter.onBatchReady = [this] (std::vector<LibraryEntry>& entries) { importBatchReady (entries); };
+    libraryImporter.onImportFinished = [this] { importFinished(); };
+    libraryImporter.onProgress = [this] { updateImportProgress(); };
+    
+    // Beat grids are stored as they are found, and the index saved once the queue is empty
+    trackAnalysisPool.onResultsReady = [this] (std::vector<TrackAnalysis>& results) { trackAnalysisReady (results); };
+    trackAnalysisPool.onAnalysisFinished = [this] { libraryIndex.save(); };
+    
+    // Keep the library in step with the music folder while the app is running
+    libraryWatcher.onEvents = [this] (const std::vector<LibraryWatcher::Event>& events) { libraryFilesChanged (events); };
+    
+    // Load songs into the library, the folder is walked once both to list them and to start watching it
+    loadExistingSongsToLibrary();
+    
+    // Making the table element visible
+    addAndMakeVisible (tableComponent);
+    addAndMakeVisible (similarTracksPanel);
+    addChildComponent (duplicatesPanel);
+    addAndMakeVisible (addButton);
+    addAndMakeVisible (duplicatesButton);
+    addAndMakeVisible (automixButton);
+    addAndMakeVisible (importModeBox);
+    addAndMakeVisible (matchModeBox);
+    addAndMakeVisible (searchBar);
+    addAndMakeVisible (scanStatusLabel);
+    addChildComponent (importProgressBar);
+    
+    // Registers a listener to receive events when this button's state changes
+    addButton.addListener (this);
+    duplicatesButton.addListener (this);
+    automixButton.addListener (this);
+    searchBar.addListener (this);
+    
+    // Add song button properties
+    addButton.setLookAndFeel(&customisation);
+    
+    // Duplicates button properties, it swaps the similar tracks panel for the groups of duplicates
+    duplicatesButton.setLookAndFeel (&customisation);
+    duplicatesButton.setClickingTogglesState (true);
+    
+    // Automix button properties, it mixes through the table while it is on
+    automixButton.setLookAndFeel (&customisation);
+    automixButton.setClickingTogglesState (true);
+    
+    // Import mode properties, linking into the music folder avoids copying wherever the filesystem allows
+    importModeBox.addItem ("Link into folder", 1);
+    importModeBox.addItem ("Copy into folder", 2);
+    importModeBox.addItem ("Reference in place", 3);
+    importModeBox.setSelectedId (1, juce::dontSendNotification);
+    importModeBox.onChange = [this]
+    {
+        switch (importModeBox.getSelectedId())
+        {
+            case 2:  libraryImporter.setImportMode (LibraryImporter::ImportMode::copy);             break;
+            case 3:  libraryImporter.setImportMode (LibraryImporter::ImportMode::referenceInPlace); break;
+            default: libraryImporter.setImportMode (LibraryImporter::ImportMode::linkOrCopy);       break;
+        }
+    };
+    
+    // Match mode properties, the table can be narrowed to the songs that mix harmonically with a deck
+    matchModeBox.addItem ("All keys", 1);
+    matchModeBox.addItem ("Mix with left", 2);
+    matchModeBox.addItem ("Mix with right", 3);
+    matchModeBox.setSelectedId (1, juce::dontSendNotification);
+    matchModeBox.onChange = [this] { searchLibrary(); };
+    
+    // Provide a pretext for the search bar (placeholder)
+    searchBar.setTextToShowWhenEmpty ("Search song...", juce::Colours::grey);
+    
+    // Scan status label properties
+    scanStatusLabel.setFont              (juce::Font (12.0f));
+    scanStatusLabel.setJustificationType (juce::Justification::centred);
+    scanStatusLabel.setColour            (juce::Label::textColourId, juce::Colours::white);
+    
+    // Adding column title to the table, the action columns cannot be sorted
+    auto actionColumnFlags = juce::TableHeaderComponent::notSortable;
+    
+    tableComponent.getHeader().addColumn ("Left", 1, 50, 30, -1, actionColumnFlags);
+    tableComponent.getHeader().addColumn ("Right", 2, 50, 30, -1, actionColumnFlags);
+    tableComponent.getHeader().addColumn ("Title", 3, 400);
+    tableComponent.getHeader().addColumn ("Duration", 4, 100);
+    tableComponent.getHeader().addColumn ("BPM", 7, 70);
+    tableComponent.getHeader().addColumn ("Key", 8, 60);
+    tableComponent.getHeader().addColumn ("Added", 6, 100);
+    tableComponent.getHeader().addColumn ("Remove", 5, 50, 30, -1, actionColumnFlags);
+    
+    // Songs in the similar tracks panel load onto the decks like songs in the table
+    similarTracksPanel.onLoadToDeck = [this] (juce::uint32 id, bool leftDeck)
+    {
+        if (trackStore.contains (id))
+            loadSongToDeck (leftDeck ? deckGUI1 : deckGUI2, id);
+    };
+    
+    // Copies found by fingerprint are merged into one or deleted one by one
+    duplicatesPanel.onMerge = [this] (juce::uint32 keptId, const std::vector<juce::uint32>& otherIds) { mergeDuplicates (keptId, otherIds); };
+    duplicatesPanel.onDelete = [this] (juce::uint32 id)
+    {
+        if (trackStore.contains (id))
+        {
+            deleteSongFromLibrary (id);
+            searchLibrary();
+        }
+    };
+    
+    // The next queued song of a deck is decoded as soon as the deck starts playing
+    deckGUI1 -> onPlaybackStarted = [this] { preloadNextSong (deckGUI1); };
+    deckGUI2 -> onPlaybackStarted = [this] { preloadNextSong (deckGUI2); };
+    
+    // The automix button turns itself off when the automixer gives up on the playlist
+    autoMixer -> onMixingStopped = [this] { automixButton.setToggleState (false, juce::dontSendNotification); };
+    
+    // Register the PlaylistComponent with the TableListBox as a TableListBoxModel
+    tableComponent.setModel (this);
+}
+
+PlaylistComponent::~PlaylistComponent()
+{
+    deckGUI1 -> onPlaybackStarted = nullptr;
+    deckGUI2 -> onPlaybackStarted = nullptr;
+    autoMixer -> onMixingStopped = nullptr;
+    
+    // Keep the beat grids found so far, the rest are analysed on the next run
+    trackAnalysisPool.cancel();
+    libraryIndex.save();
+}
+
+
+void PlaylistComponent::paint (juce::Graphics& g)
+{
+    g.fillAll (getLookAndFeel().findColour (juce::ResizableWindow::backgroundColourId));
+
+    g.setColour (juce::Colours::white);
+    g.setFont (16.0f);
+    g.drawText ("PlaylistComponent", getLocalBounds(), juce::Justification::centred, true);   // placeholder text
+}
+
+
+// Adjusts the positions and sizes of UI elements in PlaylistComponent based on its dimensions.
+void PlaylistComponent::resized()
+{
+    double rowH = getHeight() / 10;
+    double columnW = getWidth() / 10;
+    
+    searchBar.setBounds      (0, 0, columnW * 3, rowH);
+    
+    duplicatesButton.setBounds (columnW * 3, 0, columnW, rowH);
+    
+    matchModeBox.setBounds   (columnW * 4, 0, columnW, rowH);
+    
+    scanStatusLabel.setBounds (columnW * 5, 0, columnW * 2, rowH);
+    
+    importProgressBar.setBounds (columnW * 5, 0, columnW * 2, rowH);
+    
+    importModeBox.setBounds  (columnW * 7, 0, columnW, rowH);
+    
+    automixButton.setBounds  (columnW * 8, 0, columnW, rowH);
+    
+    addButton.setBounds      (columnW * 9, 0, columnW, rowH);
+    
+    tableComponent.setBounds (0, rowH, columnW * 7.5, rowH * 9);
+    
+    similarTracksPanel.setBounds (columnW * 7.5, rowH, columnW * 2.5, rowH * 9);
+    
+    duplicatesPanel.setBounds (columnW * 7.5, rowH, columnW * 2.5, rowH * 9);
+}
+
+
+// Returns the number of rows in the table
+int PlaylistComponent::getNumRows()
+{
+    return static_cast<int>(isFiltering ? visibleTrackIds.size() : tableOrder.size());
+}
+
+
+// Graphics code for drawing of the background of a row in the table
+void PlaylistComponent::paintRowBackground(juce::Graphics& g, int rowNumber, int width, int height, bool rowIsSelected)
+{
+    FrameProfiler::ScopedSection section ("PlaylistComponent::paintRowBackground");
+
+    if (rowIsSelected)
+    {
+        // Background color for selected row
+        g.fillAll(juce::Colours::darkblue);
+    }
+    else
+    {
+        // Alternate background colors for even and odd rows
+        g.fillAll(rowNumber % 2 == 0 ? juce::Colours::grey : juce::Colours::darkgrey);
+    }
+}
+
+
+
+// Graphic code that draws the contents of each cells
+// The load and remove actions are painted here too, so scrolling creates no components
+void PlaylistComponent::paintCell(juce::Graphics &g, int rowNumber, int columnId, int width, int height, bool rowIsSelected)
+{
+    FrameProfiler::ScopedSection section ("PlaylistComponent::paintCell");
+
+    g.setColour(juce::Colours::white);
+    g.setFont(16.0f);
+    
+    auto id = getTrackIdForRow (rowNumber);
+    
+    juce::Rectangle<float> cellArea (0.0f, 0.0f, static_cast<float> (width), static_cast<float> (height));
+    auto actionColour = rowNumber % 2 == 0 ? lightGrey : darkGrey;
+
+    // Show information based on column ID set
+    switch (columnId)
+    {
+        case 1: // Load to the left deck, a song queued on the deck shows its place in the queue
+        case 2: // Load to the right deck
+        {
+            auto& queue = getQueue (columnId == 1 ? deckGUI1 : deckGUI2);
+            auto queued = std::find (queue.begin(), queue.end(), id);
+            auto arrow = juce::String (columnId == 1 ? "<" : ">");
+            
+            if (queued != queue.end())
+                customisation.drawTableActionCell (g, cellArea, arrow + juce::String (queued - queue.begin() + 1), green);
+            else
+                customisation.drawTableActionCell (g, cellArea, arrow, actionColour);
+            
+            break;
+        }
+            
+        case 3: // Show the name of inserted trackon clumn
+            g.drawText(trackStore.getTitle (id), 5, 0, width, height, juce::Justification::left, true);
+            break;
+
+        case 4: // Show the track duration on column
+            g.drawText(computeAudioDuration (trackStore.getLengthInSeconds (id)), 5, 0, width, height, juce::Justification::left, true);
+            break;
+            
+        case 7: // Show the track tempo once it has been analysed
+            if (trackStore.getBpm (id) > 0.0)
+                g.drawText(juce::String (trackStore.getBpm (id), 1), 5, 0, width, height, juce::Justification::left, true);
+            break;
+            
+        case 8: // Show the track key in Camelot notation once it has been analysed
+            g.drawText(trackStore.getKey (id).getCamelotCode(), 5, 0, width, height, juce::Justification::left, true);
+            break;
+            
+        case 6: // Show the date the track was added to the library
+            g.drawText(trackStore.getDateAdded (id).formatted ("%d %b %Y"), 5, 0, width, height, juce::Justification::left, true);
+            break;
+            
+        case 5: // Remove the song
+            customisation.drawTableActionCell (g, cellArea, "X", actionColour);
+            break;
+
+        default:
+            break;
+    }
+}
+
+
+/*
+    Re-sorts the table by the clicked column.
+    
+    The clicked column becomes the primary sort key and the columns clicked before
+    it break ties, so sorting by duration then by title lists same-length songs
+    alphabetically. Only the list of track ids is permuted.
+    
+    @param newSortColumnId       The column ID of the clicked header.
+    @param isForwards            True for ascending order.
+*/
+void PlaylistComponent::sortOrderChanged (int newSortColumnId, bool isForwards)
+{
+    constexpr size_t maxSortKeys = 3;
+    
+    TrackStore::SortKey key;
+    key.ascending = isForwards;
+    
+    switch (newSortColumnId)
+    {
+        case 3:  key.column = TrackStore::SortColumn::title;     break;
+        case 4:  key.column = TrackStore::SortColumn::duration;  break;
+        case 6:  key.column = TrackStore::SortColumn::dateAdded; break;
+        case 7:  key.column = TrackStore::SortColumn::bpm;       break;
+        case 8:  key.column = TrackStore::SortColumn::key;       break;
+        default: return;
+    }
+    
+    sortKeys.erase (std::remove_if (sortKeys.begin(), sortKeys.end(), [&key] (auto& existing) { return existing.column == key.column; }),
+                    sortKeys.end());
+    sortKeys.insert (sortKeys.begin(), key);
+    
+    if (sortKeys.size() > maxSortKeys)
+        sortKeys.resize (maxSortKeys);
+    
+    {
+        FrameProfiler::ScopedSection section ("PlaylistComponent::sortOrderChanged");
+        trackStore.sort (tableOrder, sortKeys);
+    }
+    
+    // The filtered view follows the table order
+    searchLibrary();
+}
+
+
+// Shows the songs similar to the selected song
+void PlaylistComponent::selectedRowsChanged (int lastRowSelected)
+{
+    if (juce::isPositiveAndBelow (lastRowSelected, getNumRows()))
+        showSimilarTracks (getTrackIdForRow (lastRowSelected));
+}
+
+
+/*
+    Handles a click on one of the painted action cells.
+    
+    The row is resolved to its song at the time of the click, so it always acts on
+    the song currently shown, however the table has been filtered or edited since.
+    
+    @param rowNumber             The row number of the cell.
+    @param columnId              The column ID of the cell.
+*/
+void PlaylistComponent::cellClicked (int rowNumber, int columnId, const juce::MouseEvent& event)
+{
+    if (! juce::isPositiveAndBelow (rowNumber, getNumRows()))
+        return;
+    
+    auto id = getTrackIdForRow (rowNumber);
+    
+    // Shift-clicking a load action queues the song on that deck instead
+    switch (columnId)
+    {
+        case 1:
+            if (event.mods.isShiftDown())
+                queueSongOnDeck (deckGUI1, id);
+            else
+                loadSongToDeck (deckGUI1, id);
+            break;
+            
+        case 2:
+            if (event.mods.isShiftDown())
+                queueSongOnDeck (deckGUI2, id);
+            else
+                loadSongToDeck (deckGUI2, id);
+            break;
+            
+        case 5:
+            deleteSongFromLibrary (id);
+            searchLibrary();
+            break;
+            
+        default:
+            break;
+    }
+}
+
+
+// Computing raw audio duration data to mins and secs
+juce::String PlaylistComponent::computeAudioDuration (double lengthInSeconds)
+{
+    // Round to integers
+    int roundedSeconds = std::round(lengthInSeconds);
+    
+    // Convert time to min and sec
+    juce::String minutes = std::to_string (roundedSeconds / 60);
+    juce::String seconds = std::to_string (roundedSeconds % 60);
+    
+    // Display the duration in format of (minutes:seconds)
+    juce::String duration = minutes + " : " + seconds;
+    
+    return duration;
+}
+
+
+// Load songs from the music folder to the library folder
+// Metadata comes from the library index, only new or modified files are opened
+void PlaylistComponent::loadExistingSongsToLibrary()
+{
+    // Checks if the song library is a folder
+    if (! musicFolder.isDirectory())
+    {
+        std::cout << "No music folder found!" << std::endl;
+        return;
+    }
+    
+    libraryIndex.load();
+    
+    juce::Array<juce::File> filesToProbe;
+    std::unordered_set<juce::String> foundPaths;
+    
+    // Find every file of a registered format anywhere below the music folder in the same walk that sets up the watches
+    // Each directory is watched before it is listed, so a file added during the walk is reported rather than missed
+    libraryWatcher.watch (musicFolder, [&] (const juce::DirectoryEntry& found)
+    {
+        auto file = found.getFile();
+        
+        if (! isAudioFile (file))
+            return;
+        
+        auto* entry = libraryIndex.find (file);
+        
+        foundPaths.insert (file.getFullPathName());
+        
+        // Up to date songs come straight from the index, the rest are probed in the background
+        if (entry != nullptr && entry -> matches (found.getFileSize(), found.getModificationTime()))
+            addSongToTable (*entry);
+        else
+            filesToProbe.add (file);
+    });
+    
+    juce::Array<juce::File> staleFiles;
+    
+    for (auto& entry : libraryIndex.getEntries())
+    {
+        if (entry.file.isAChildOf (musicFolder))
+        {
+            // Gone from the folder since the last run
+            if (foundPaths.count (entry.file.getFullPathName()) == 0)
+                staleFiles.add (entry.file);
+        }
+        else if (entry.matchesFileOnDisk())
+        {
+            // Songs that were referenced in place live outside the music folder
+            addSongToTable (entry);
+        }
+        else
+        {
+            filesToProbe.add (entry.file);
+        }
+    }
+    
+    // The index only keeps songs that are listed in the table, the probed ones are added back as they finish
+    staleFiles.addArray (filesToProbe);
+    
+    for (auto& file : staleFiles)
+        libraryIndex.remove (file);
+    
+    libraryScanner.scan (filesToProbe);
+    
+    // Songs listed from the index are analysed now, probed songs as they are added
+    juce::Array<juce::File> listedFiles;
+    
+    for (auto id : trackStore.getIds())
+        listedFiles.add (trackStore.getFile (id));
+    
+    analyseSongsIfNeeded (listedFiles);
+}
+
+
+// Add an indexed song to the table, in its sorted position if the table is sorted
+void PlaylistComponent::addSongToTable (const LibraryEntry& entry)
+{
+    auto id = trackStore.add (entry);
+    
+    insertIntoTableOrder (id);
+    searchIndex.add (id, entry.title, entry.artist, entry.album);
+    harmonicMixIndex.update (id, trackStore.getKey (id), entry.bpm);
+    similarityIndex.update (id, entry.timbre);
+    fingerprintIndex.update (id, entry.fingerprint);
+}
+
+
+// Insert a song after the songs that sort before or with it, or at the end of an unsorted table
+void PlaylistComponent::insertIntoTableOrder (TrackStore::TrackId id)
+{
+    if (sortKeys.empty())
+    {
+        tableOrder.push_back (id);
+        return;
+    }
+    
+    tableOrder.insert (std::upper_bound (tableOrder.begin(), tableOrder.end(), id, [this] (auto newId, auto listedId)
+    {
+        return trackStore.isBefore (newId, listedId, sortKeys);
+    }), id);
+}
+
+
+// Add a newly probed song, or refresh the row of a song that is already listed
+void PlaylistComponent::addOrUpdateSong (const LibraryEntry& entry)
+{
+    libraryIndex.update (entry);
+    
+    // The index fills in the date the song was added
+    auto& indexed = *libraryIndex.find (entry.file);
+    auto id = trackStore.find (entry.file);
+    
+    if (id == TrackStore::invalidId)
+    {
+        addSongToTable (indexed);
+        return;
+    }
+    
+    trackStore.update (id, indexed);
+    searchIndex.update (id, indexed.title, indexed.artist, indexed.album);
+    harmonicMixIndex.update (id, trackStore.getKey (id), indexed.bpm);
+    similarityIndex.update (id, indexed.timbre);
+    fingerprintIndex.update (id, indexed.fingerprint);
+    
+    // A changed title or duration can move the song in a sorted table
+    if (! sortKeys.empty())
+    {
+        tableOrder.erase (std::find (tableOrder.begin(), tableOrder.end(), id));
+        insertIntoTableOrder (id);
+    }
+}
+
+
+// Remove a song from the table without touching the file
+void PlaylistComponent::removeSongFromTable (TrackStore::TrackId id)
+{
+    libraryIndex.remove (trackStore.getFile (id));
+    searchIndex.remove (id);
+    harmonicMixIndex.remove (id);
+    similarityIndex.remove (id);
+    fingerprintIndex.remove (id);
+    trackStore.remove (id);
+    
+    tableOrder.erase (std::find (tableOrder.begin(), tableOrder.end(), id));
+}
+
+
+// Apply changes reported by the library watcher without rescanning
+void PlaylistComponent::libraryFilesChanged (const std::vector<LibraryWatcher::Event>& events)
+{
+    juce::Array<juce::File> filesToProbe;
+    
+    for (auto& event : events)
+    {
+        switch (event.type)
+        {
+            case LibraryWatcher::Event::Type::added:
+            {
+                auto* entry = libraryIndex.find (event.file);
+                
+                if (isAudioFile (event.file) && (entry == nullptr || ! entry -> matchesFileOnDisk()))
+                    filesToProbe.add (event.file);
+                
+                break;
+            }
+                
+            case LibraryWatcher::Event::Type::removed:
+                removeSongsAt (event.file);
+                break;
+                
+            case LibraryWatcher::Event::Type::renamed:
+                renameSongs (event.file, event.newFile);
+                break;
+                
+            case LibraryWatcher::Event::Type::overflowed:
+                rescanMusicFolder (filesToProbe);
+                break;
+        }
+    }
+    
+    libraryScanner.addFiles (filesToProbe);
+    libraryIndex.save();
+    searchLibrary();
+}
+
+
+// Compare the music folder with the table after the watcher lost events
+// Changed or unlisted files are added to the files to probe, songs whose files are gone are removed
+void PlaylistComponent::rescanMusicFolder (juce::Array<juce::File>& filesToProbe)
+{
+    std::unordered_set<juce::String> foundPaths;
+    
+    for (const auto& found : juce::RangedDirectoryIterator (musicFolder, true, formatManager.getWildcardForAllFormats(), juce::File::findFiles))
+    {
+        auto file = found.getFile();
+        auto* entry = libraryIndex.find (file);
+        
+        foundPaths.insert (file.getFullPathName());
+        
+        if (entry == nullptr || trackStore.find (file) == TrackStore::invalidId
+            || ! entry -> matches (found.getFileSize(), found.getModificationTime()))
+            filesToProbe.addIfNotAlreadyThere (file);
+    }
+    
+    juce::Array<juce::File> goneFiles;
+    
+    for (auto id : trackStore.getIds())
+    {
+        auto file = trackStore.getFile (id);
+        
+        if (file.isAChildOf (musicFolder) && foundPaths.count (file.getFullPathName()) == 0)
+            goneFiles.add (file);
+    }
+    
+    for (auto& file : goneFiles)
+        removeSongsAt (file);
+}
+
+
+// Remove the song at a path, or every song below it if it was a directory
+void PlaylistComponent::removeSongsAt (const juce::File& fileOrDirectory)
+{
+    std::vector<TrackStore::TrackId> removedIds;
+    
+    for (auto id : trackStore.getIds())
+    {
+        auto file = trackStore.getFile (id);
+        
+        if (file == fileOrDirectory || file.isAChildOf (fileOrDirectory))
+            removedIds.push_back (id);
+    }
+    
+    if (removedIds.empty())
+        return;
+    
+    for (auto id : removedIds)
+    {
+        libraryIndex.remove (trackStore.getFile (id));
+        searchIndex.remove (id);
+        harmonicMixIndex.remove (id);
+        similarityIndex.remove (id);
+        fingerprintIndex.remove (id);
+        trackStore.remove (id);
+    }
+    
+    // Drop every removed row in a single pass
+    tableOrder.erase (std::remove_if (tableOrder.begin(), tableOrder.end(),
+                                      [this] (TrackStore::TrackId id) { return ! trackStore.contains (id); }),
+                      tableOrder.end());
+}
+
+
+// Move the songs at a path to a new path, keeping their metadata and track ids
+void PlaylistComponent::renameSongs (const juce::File& oldFile, const juce::File& newFile)
+{
+    // A song renamed to something that is not audio is treated as removed
+    if (! newFile.isDirectory() && ! isAudioFile (newFile))
+    {
+        removeSongsAt (oldFile);
+        return;
+    }
+    
+    for (auto id : trackStore.getIds())
+    {
+        auto file = trackStore.getFile (id);
+        
+        if (file != oldFile && ! file.isAChildOf (oldFile))
+            continue;
+        
+        auto* entry = libraryIndex.find (file);
+        
+        if (entry == nullptr)
+            continue;
+        
+        auto renamed = *entry;
+        renamed.file = file == oldFile ? newFile : newFile.getChildFile (file.getRelativePathFrom (oldFile));
+        
+        // Untagged songs are listed under their file name, which has just changed
+        if (renamed.title == file.getFileNameWithoutExtension())
+            renamed.title = renamed.file.getFileNameWithoutExtension();
+        
+        libraryIndex.remove (file);
+        libraryIndex.update (renamed);
+        
+        trackStore.update (id, renamed);
+        searchIndex.update (id, renamed.title, renamed.artist, renamed.album);
+    }
+}
+
+
+// Returns true if the file has an extension of one of the registered formats
+bool PlaylistComponent::isAudioFile (const juce::File& file)
+{
+    return formatManager.findFormatForFileExtension (file.getFileExtension()) != nullptr;
+}
+
+
+// Receive a batch of probed songs from the library scanner
+void PlaylistComponent::libraryScanBatchReady (std::vector<LibraryEntry>& entries, juce::Array<juce::File>& unreadableFiles)
+{
+    juce::Array<juce::File> files;
+    
+    for (auto& entry : entries)
+    {
+        addOrUpdateSong (entry);
+        files.add (entry.file);
+    }
+    
+    // Files that cannot be read as audio are left out of the table
+    for (auto& file : unreadableFiles)
+        removeSongsAt (file);
+    
+    analyseSongsIfNeeded (files);
+    
+    searchLibrary();
+    
+    scanStatusLabel.setText ("Scanning " + juce::String (libraryScanner.getNumFilesScanned())
+                             + " / " + juce::String (libraryScanner.getNumFilesToScan())
+                             + " (" + juce::String (libraryScanner.getFilesPerSecond(), 0) + " files/s)",
+                             juce::dontSendNotification);
+}
+
+
+// Save the index and show the size of the library once the library scan is done
+void PlaylistComponent::libraryScanFinished()
+{
+    libraryIndex.save();
+    
+    scanStatusLabel.setText (juce::String (trackStore.size()) + " songs", juce::dontSendNotification);
+}
+
+
+// Adds new songs to the library and saves them in the music folder
+// The files are copied, probed and analysed in the background by the library importer
+void PlaylistComponent::addNewSongsToLibrary()
+{
+    // Create a file chooser dialog for selecting multiple audio files
+    chooser = std::make_unique<juce::FileChooser> ("Choose files to add into the music folder",
+                                                   juce::File(),
+                                                   formatManager.getWildcardForAllFormats());
+    
+    auto chooserFlags = juce::FileBrowserComponent::openMode
+                      | juce::FileBrowserComponent::canSelectFiles
+                      | juce::FileBrowserComponent::canSelectMultipleItems;
+    
+    chooser -> launchAsync (chooserFlags, [this] (const juce::FileChooser& fileChooser)
+    {
+        auto results = fileChooser.getResults();
+        
+        if (results.isEmpty())
+            return;
+        
+        libraryImporter.import (results);
+        
+        scanStatusLabel.setVisible (false);
+        importProgressBar.setVisible (true);
+        updateImportProgress();
+    });
+}
+
+
+// Receive a batch of imported songs from the library importer
+void PlaylistComponent::importBatchReady (std::vector<LibraryEntry>& entries)
+{
+    juce::Array<juce::File> files;
+    
+    // Re-importing a song that is already listed only refreshes its row
+    for (auto& entry : entries)
+    {
+        addOrUpdateSong (entry);
+        files.add (entry.file);
+    }
+    
+    analyseSongsIfNeeded (files);
+    searchLibrary();
+}
+
+
+// Show the import progress and copy throughput
+void PlaylistComponent::updateImportProgress()
+{
+    importProgress = libraryImporter.getProgress();
+    
+    auto megabytesPerSecond = libraryImporter.getBytesPerSecond() / (1024.0 * 1024.0);
+    
+    importProgressBar.setTextToDisplay ("Importing " + juce::String (libraryImporter.getNumFilesImported())
+                                        + " / " + juce::String (libraryImporter.getNumFilesQueued())
+                                        + " (" + juce::String (megabytesPerSecond, 1) + " MB/s)");
+}
+
+
+// Save the index and hide the progress bar once an import is done
+void PlaylistComponent::importFinished()
+{
+    libraryIndex.save();
+    
+    importProgressBar.setVisible (false);
+    scanStatusLabel.setText (juce::String (trackStore.size()) + " songs", juce::dontSendNotification);
+    scanStatusLabel.setVisible (true);
+}
+
+
+// Queue the songs whose index entries have no beat grid from the current analysis version
+void PlaylistComponent::analyseSongsIfNeeded (const juce::Array<juce::File>& files)
+{
+    juce::Array<juce::File> filesToAnalyse;
+    
+    for (auto& file : files)
+        if (auto* entry = libraryIndex.find (file))
+            if (TrackAnalysisPool::needsAnalysis (*entry))
+                filesToAnalyse.add (file);
+    
+    if (! filesToAnalyse.isEmpty())
+        trackAnalysisPool.analyse (filesToAnalyse);
+}
+
+
+// Store a batch of beat grids in the index and the table
+// Results for songs that were removed are dropped, songs that changed while they were analysed are analysed again
+void PlaylistComponent::trackAnalysisReady (std::vector<TrackAnalysis>& results)
+{
+    juce::Array<juce::File> changedFiles;
+    auto tableNeedsSorting = false;
+    auto timbresChanged = false;
+    
+    for (auto& result : results)
+    {
+        auto* indexed = libraryIndex.find (result.file);
+        
+        if (indexed == nullptr)
+            continue;
+        
+        if (! result.matches (*indexed))
+        {
+            changedFiles.add (result.file);
+            continue;
+        }
+        
+        auto entry = *indexed;
+        result.applyTo (entry);
+        libraryIndex.update (entry);
+        
+        auto id = trackStore.find (entry.file);
+        
+        if (id == TrackStore::invalidId)
+            continue;
+        
+        trackStore.update (id, entry);
+        harmonicMixIndex.update (id, trackStore.getKey (id), entry.bpm);
+        similarityIndex.update (id, entry.timbre);
+        fingerprintIndex.update (id, entry.fingerprint);
+        timbresChanged = timbresChanged || ! entry.timbre.empty();
+        
+        // A song analysed after it was loaded gets its analysis on the deck straight away
+        if (id == leftDeckTrackId)
+            sendAnalysisToDeck (deckGUI1, id);
+        
+        if (id == rightDeckTrackId)
+            sendAnalysisToDeck (deckGUI2, id);
+        
+        tableNeedsSorting = true;
+    }
+    
+    // A new tempo or key can move songs in a sorted table, the whole batch is placed with one sort
+    if (tableNeedsSorting && ! sortKeys.empty())
+        trackStore.sort (tableOrder, sortKeys);
+    
+    // Newly analysed songs can be closer to the song in the similar tracks panel, or be that song
+    auto sourceId = trackStore.find (similarTracksSource);
+    
+    if (timbresChanged && sourceId != TrackStore::invalidId)
+        showSimilarTracks (sourceId);
+    
+    analyseSongsIfNeeded (changedFiles);
+    searchLibrary();
+}
+
+
+
+// Filters the table to the songs whose title, artist or album match the search input
+// Every word has to match as a substring, close spellings are accepted when nothing matches exactly
+// When the table is matched to a deck, only songs that mix harmonically with the deck's song are listed
+void PlaylistComponent::searchLibrary()
+{
+    juce::String searchInput = searchBar.getText();
+    
+    auto hasQuery = searchInput.trim().isNotEmpty();
+    auto isMatchingDeck = matchModeBox.getSelectedId() != 1;
+    
+    isFiltering = hasQuery || isMatchingDeck;
+    visibleTrackIds.clear();
+    
+    if (isFiltering)
+    {
+        // Number of active filters each song passes
+        std::vector<juce::uint8> numFiltersPassed (trackStore.getIdLimit(), 0);
+        juce::uint8 numFilters = 0;
+        
+        if (hasQuery)
+        {
+            ++numFilters;
+            
+            for (auto id : searchIndex.search (searchInput))
+                ++numFiltersPassed[id];
+        }
+        
+        if (isMatchingDeck)
+        {
+            ++numFilters;
+            auto deckTrackId = getTrackIdToMatch();
+            
+            if (deckTrackId != TrackStore::invalidId)
+                for (auto id : harmonicMixIndex.findCompatible (trackStore.getKey (deckTrackId), trackStore.getBpm (deckTrackId)))
+                    if (id != deckTrackId)
+                        ++numFiltersPassed[id];
+        }
+        
+        // Keep the songs in table order
+        for (auto id : tableOrder)
+            if (numFiltersPassed[id] == numFilters)
+                visibleTrackIds.push_back (id);
+    }
+    
+    tableComponent.updateContent();
+    repaint();
+}
+
+
+/*
+    Lists the songs that sound most like a song.
+    
+    A linear SIMD scan of the similarity index answers in a few milliseconds up to
+    about a hundred thousand songs. Larger libraries are searched in slices on a
+    pool of threads, which is created the first time one is needed.
+    
+    @param id                    The selected song.
+*/
+void PlaylistComponent::showSimilarTracks (TrackStore::TrackId id)
+{
+    constexpr int numSimilarTracks = 25;
+    constexpr int parallelSearchThreshold = 200000;
+    
+    auto title = trackStore.getTitle (id);
+    similarTracksSource = trackStore.getFile (id);
+    
+    if (similarityIndex.size() < 2)
+    {
+        similarTracksPanel.clearResults ("Similar songs appear once the library is analysed");
+        return;
+    }
+    
+    if (similarityIndex.size() >= parallelSearchThreshold && similaritySearchPool == nullptr)
+        similaritySearchPool = std::make_unique<juce::ThreadPool> (juce::SystemStats::getNumCpus());
+    
+    auto matches = similarityIndex.findSimilar (id, numSimilarTracks, similaritySearchPool.get());
+    
+    if (matches.empty())
+    {
+        similarTracksPanel.clearResults (title + " has not been analysed yet");
+        return;
+    }
+    
+    std::vector<SimilarTracksPanel::Item> items;
+    
+    for (auto& match : matches)
+        items.push_back ({ match.key, trackStore.getTitle (match.key) });
+    
+    similarTracksPanel.setResults (title, std::move (items));
+}
+
+
+// Swap the similar tracks panel for the groups of songs that are copies of each other
+// The groups are found afresh each time on a background thread, from a snapshot of the fingerprint index
+void PlaylistComponent::showDuplicates (bool shouldShow)
+{
+    duplicatesPanel.setVisible (shouldShow);
+    similarTracksPanel.setVisible (! shouldShow);
+    
+    // Any search still running is for an earlier opening of the panel
+    auto searchId = ++duplicateSearchId;
+    
+    if (! shouldShow)
+        return;
+    
+    duplicatesPanel.clearGroups ("Looking for duplicates...");
+    
+    auto snapshot = fingerprintIndex.createSnapshot();
+    juce::Component::SafePointer<PlaylistComponent> safeThis (this);
+    
+    duplicateSearchPool.addJob ([snapshot, safeThis, searchId]
+    {
+        auto groups = snapshot -> findDuplicates();
+        
+        juce::MessageManager::callAsync ([safeThis, searchId, groups = std::move (groups)]
+        {
+            if (safeThis != nullptr)
+                safeThis -> duplicatesFound (groups, searchId);
+        });
+    });
+}
+
+
+// List the groups found by a duplicate search, dropping the results of a search that was superseded
+// Songs removed during the search are left out, songs that have not been fingerprinted yet are counted but not checked
+void PlaylistComponent::duplicatesFound (const std::vector<std::vector<juce::uint32>>& groups, int searchId)
+{
+    if (searchId != duplicateSearchId)
+        return;
+    
+    std::vector<std::vector<DuplicatesPanel::Song>> songGroups;
+    
+    for (auto& group : groups)
+    {
+        std::vector<DuplicatesPanel::Song> songs;
+        
+        for (auto id : group)
+        {
+            if (! trackStore.contains (id))
+                continue;
+            
+            auto file = trackStore.getFile (id);
+            auto details = computeAudioDuration (trackStore.getLengthInSeconds (id)) + "  "
+                         + file.getParentDirectory().getFileName() + "/" + file.getFileName();
+            
+            songs.push_back ({ id, trackStore.getTitle (id), details });
+        }
+        
+        songGroups.push_back (std::move (songs));
+    }
+    
+    auto numNotAnalysed = trackStore.size() - fingerprintIndex.size();
+    duplicatesPanel.setGroups (std::move (songGroups), juce::jmax (0, numNotAnalysed));
+}
+
+
+// Keep one copy of a song and delete the others
+// The kept copy takes the earliest date added among the copies, so the song keeps its place in the library's history
+void PlaylistComponent::mergeDuplicates (TrackStore::TrackId keptId, const std::vector<juce::uint32>& otherIds)
+{
+    auto* kept = trackStore.contains (keptId) ? libraryIndex.find (trackStore.getFile (keptId)) : nullptr;
+    
+    if (kept == nullptr)
+        return;
+    
+    auto entry = *kept;
+    
+    for (auto id : otherIds)
+    {
+        if (! trackStore.contains (id))
+            continue;
+        
+        entry.dateAdded = juce::jmin (entry.dateAdded, trackStore.getDateAdded (id).toMilliseconds());
+        deleteSongFromLibrary (id);
+    }
+    
+    libraryIndex.update (entry);
+    trackStore.update (keptId, entry);
+    
+    // An earlier date added can move the song in a sorted table
+    if (! sortKeys.empty())
+    {
+        tableOrder.erase (std::find (tableOrder.begin(), tableOrder.end(), keptId));
+        insertIntoTableOrder (keptId);
+    }
+    
+    libraryIndex.save();
+    searchLibrary();
+}
+
+
+// Returns the song on the deck the table is matched to, or invalidId
+TrackStore::TrackId PlaylistComponent::getTrackIdToMatch() const
+{
+    auto id = TrackStore::invalidId;
+    
+    switch (matchModeBox.getSelectedId())
+    {
+        case 2:  id = leftDeckTrackId;  break;
+        case 3:  id = rightDeckTrackId; break;
+        default: break;
+    }
+    
+    return trackStore.contains (id) ? id : TrackStore::invalidId;
+}
+
+
+// Returns the song shown on a row of the table, which may be filtered
+TrackStore::TrackId PlaylistComponent::getTrackIdForRow (int rowNumber) const
+{
+    return isFiltering ? visibleTrackIds[(size_t) rowNumber] : tableOrder[(size_t) rowNumber];
+}
+
+
+// Search the library on every keystroke
+void PlaylistComponent::textEditorTextChanged (juce::TextEditor& searchBar)
+{
+    searchLibrary();
+}
+
+
+// Select the first matching song when the return key is pressed
+void PlaylistComponent::textEditorReturnKeyPressed (juce::TextEditor& searchBar)
+{
+    if (getNumRows() > 0)
+        tableComponent.selectRow (0);
+}
+
+
+// Parsing of song URL
+// A song that was preloaded is swapped in from memory, any other song is opened from disk
+void PlaylistComponent::loadSongToDeck(DeckGUI* deckGUI, TrackStore::TrackId id)
+{
+    auto file = trackStore.getFile (id);
+    
+    if (auto preloaded = trackPreloader -> take (file))
+    {
+        deckGUI -> loadPreloadedAudio (std::move (preloaded));
+    }
+    else
+    {
+        trackPreloader -> discard (file);
+        
+        juce::URL path = juce::URL (file);
+        deckGUI -> loadAudio (path);
+    }
+    
+    // A queued song leaves the queue once it is loaded
+    auto& queue = getQueue (deckGUI);
+    queue.erase (std::remove (queue.begin(), queue.end(), id), queue.end());
+    tableComponent.repaint();
+    
+    juce::String songSelected = trackStore.getTitle (id);
+    deckGUI -> updateSongNameLabel (songSelected);
+    
+    juce::String songDuration = computeAudioDuration (trackStore.getLengthInSeconds (id));
+    deckGUI -> updateSongDurationLabel (songDuration);
+    
+    sendAnalysisToDeck (deckGUI, id);
+    
+    // A table matched to this deck now lists the songs that mix with the new song
+    (deckGUI == deckGUI1 ? leftDeckTrackId : rightDeckTrackId) = id;
+    
+    if (matchModeBox.getSelectedId() != 1)
+        searchLibrary();
+}
+
+
+// Start mixing the songs in the order the table lists them, filtered or sorted as it is, or stop
+// Once started the mix runs on its own, so later changes to the table do not affect it
+void PlaylistComponent::setAutomixEnabled (bool shouldBeEnabled)
+{
+    if (! shouldBeEnabled)
+    {
+        autoMixer -> stop();
+        return;
+    }
+    
+    juce::Array<juce::File> songs;
+    
+    for (int row = 0; row < getNumRows(); ++row)
+        songs.add (trackStore.getFile (getTrackIdForRow (row)));
+    
+    autoMixer -> start (songs);
+    automixButton.setToggleState (autoMixer -> isMixing(), juce::dontSendNotification);
+}
+
+
+// Add a song to the end of a deck's up next queue
+// A deck that is already playing starts preloading the song straight away if it is next
+void PlaylistComponent::queueSongOnDeck (DeckGUI* deckGUI, TrackStore::TrackId id)
+{
+    auto& queue = getQueue (deckGUI);
+    
+    if (std::find (queue.begin(), queue.end(), id) == queue.end())
+        queue.push_back (id);
+    
+    if (deckGUI -> isPlaying())
+        preloadNextSong (deckGUI);
+    
+    tableComponent.repaint();
+}
+
+
+// Decode the next queued song of a deck, dropping songs that have left the library since they were queued
+void PlaylistComponent::preloadNextSong (DeckGUI* deckGUI)
+{
+    auto& queue = getQueue (deckGUI);
+    
+    while (! queue.empty() && ! trackStore.contains (queue.front()))
+        queue.pop_front();
+    
+    if (! queue.empty())
+        trackPreloader -> preload (trackStore.getFile (queue.front()));
+}
+
+
+// Returns the up next queue of a deck
+std::deque<TrackStore::TrackId>& PlaylistComponent::getQueue (DeckGUI* deckGUI)
+{
+    return deckGUI == deckGUI1 ? leftDeckQueue : rightDeckQueue;
+}
+
+
+// Give a deck the beat grid, loudness and key of its song
+// The beat grid lets the deck sync to the other one, the loudness sets its trim gain
+void PlaylistComponent::sendAnalysisToDeck (DeckGUI* deckGUI, TrackStore::TrackId id)
+{
+    BeatGrid grid;
+    LoudnessMeasurement loudness;
+    
+    if (auto* entry = libraryIndex.find (trackStore.getFile (id)))
+    {
+        grid.bpm = entry -> bpm;
+        grid.firstBeatSeconds = entry -> firstBeatSeconds;
+        loudness.integratedLoudness = entry -> loudness;
+        loudness.truePeak = entry -> truePeak;
+    }
+    
+    deckGUI -> setBeatGrid (grid);
+    deckGUI -> setLoudness (loudness);
+    deckGUI -> setKey (trackStore.getKey (id));
+}
+
+
+// Delete song from library and music folder
+void PlaylistComponent::deleteSongFromLibrary(TrackStore::TrackId id)
+{
+    auto file = trackStore.getFile (id);
+    
+    // Songs referenced in place belong to the user, so they are only removed from the library
+    if (file.isAChildOf (musicFolder))
+        file.moveToTrash();
+    
+    removeSongFromTable (id);
+    libraryIndex.save();
+}
+
+
+// Button listener to handle button clicks
+void PlaylistComponent::buttonClicked(juce::Button* button)
+{
+    // If the "Add" button is clicked
+    if (button == &addButton)
+    {
+        addNewSongsToLibrary();
+    }
+    
+    // If the "Automix" button is toggled
+    if (button == &automixButton)
+    {
+        setAutomixEnabled (automixButton.getToggleState());
+    }
+    
+    // If the "Duplicates" button is toggled
+    if (button == &duplicatesButton)
+    {
+        showDuplicates (duplicatesButton.getToggleState());
+    }
+}
+
+// End of Added Code
@@ -1,119 +1,293 @@
-/*
-  ==============================================================================
-
-    PlaylistComponent.h
-    Created: 4 Mar 2024 7:37:49pm
-    Author:  Justin  Lim
-
-  ==============================================================================
-*/
-
-// Start of Added Code file "PlaylistComponent", everything in the code below is added on top of starter code
-#pragma once
-
-#include <JuceHeader.h>
-#include "DJAudioPlayer.h"
-#include "DeckGUI.h"
-#include "WaveformDisplay.h"
-#include "Customisation.h"
-
-class PlaylistComponent :   public juce::Component,
-public juce::TableListBoxModel,
-public juce::Button::Listener,
-public juce::TextEditor::Listener
-{
-public:
-    PlaylistComponent(juce::AudioFormatManager& _formatManager,
-                      DJAudioPlayer*      _player,
-                      DeckGUI*            _deckGUI1,
-                      DeckGUI*            _deckGUI2);
-    ~PlaylistComponent() override;
-    
-    void paint(juce::Graphics&) override;
-    void resized() override;
-    /** Returns the number of rows in the table */
-    int getNumRows() override;
-    
-    /** Provides graphic code that draws the background of a row in the table */
-    void paintRowBackground (juce::Graphics &,
-                             int rowNumber,
-                             int width,
-                             int height,
-                             bool rowIsSelected) override;
-    
-    /**  Graphical code which draws the contents of individual cells */
-    void paintCell (juce::Graphics&,
-                    int rowNumber,
-                    int columnId,
-                    int width,
-                    int height,
-                    bool rowIsSelected) override;
-    
-    /** To create or update a custom component to go in a cell */
-    Component* refreshComponentForCell (int rowNumber,
-                                        int columnId,
-                                        bool isRowSelected,
-                                        Component* existingComponentToUpdate) override;
-    
-    /** Retrieve the audio duration of a song */
-    void retrieveAudioDurationData();
-    
-    /** Compute the raw audio duration data to minutes and seconds */
-    juce::String computeAudioDuration (double lengthInSeconds);
-    
-    /** Load existing songs*/
-    void loadExistingSongsToLibrary();
-    
-    /** Add songs */
-    void addNewSongsToLibrary();
-    
-    /** Search songs */
-    void searchLibrary();
-    
-    /** Search the library when the return key is pressed */
-    void textEditorReturnKeyPressed (juce::TextEditor &) override;
-    
-    /** Returns the text editor to its default state when user clicks away */
-    void textEditorFocusLost (juce::TextEditor &) override;
-    
-    /** Parse the song URL to the deckGUI component */
-    void loadSongToDeck (DeckGUI* deckGUI, int id);
-    
-    /** Delete sonr */
-    void deleteSongFromLibrary (int id);
-    
-    /** Button listener to check if a button is clicked */
-    void buttonClicked (juce::Button* button) override;
-    
-private:
-    // A formatManager objects that handles audio formats and decide which one to use to open a file
-    juce::AudioFormatManager& formatManager;
-    
-    // A player object that points to the DJAudioPlayer
-    DJAudioPlayer* player;
-    
-    // Two deckGUI objects that points to the DeckGUI
-    DeckGUI* deckGUI1;
-    DeckGUI* deckGUI2;
-    
-    // A customLookAndFeel object to manage visual UI elements
-    Customisation customisation;
-    juce::TextButton addButton {"Add song +"};
-    juce::TextEditor searchBar;
-    juce::TableListBox tableComponent;
-    
-    // Storing of files/folders/songs
-    juce::File musicFolder = juce::File::getSpecialLocation (juce::File::userDesktopDirectory).getFullPathName() + "/music-folder";
-        juce::Array<juce::File> audioFileArray;
-    std::vector<juce::String> audioFileNames;
-    std::vector<juce::String> audioFileDurations;
-    juce::String songSelected;
-    
-    // Colours
-    juce::Colour lightGrey = juce::Colour (61, 61, 61);
-    juce::Colour darkGrey  = juce::Colour (39, 39, 39);
-    juce::Colour green     = juce::Colour (0, 179, 0);
-    
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PlaylistComponent)
-};
-// End of Added Code
+/*
+  ==============================================================================
+
+    PlaylistComponent.h
+    Created: 4 Mar 2024 7:37:49pm
+    Author:  Justin  Lim
+
+  ==============================================================================
+*/
+
+// Start of Added Code file "PlaylistComponent", everything in the code below is added on top of starter code
+#pragma once
+
+#include <JuceHeader.h>
+#include "DJAudioPlayer.h"
+#include "DeckGUI.h"
+#include "WaveformDisplay.h"
+#include "Customisation.h"
+#include "LibraryIndex.h"
+#include "LibraryScanner.h"
+#include "LibraryImporter.h"
+#include "LibraryWatcher.h"
+#include "SearchIndex.h"
+#include "TrackStore.h"
+#include "TrackAnalysisPool.h"
+#include "TrackPreloader.h"
+#include "AutoMixer.h"
+#include "HarmonicMixIndex.h"
+#include "SimilarityIndex.h"
+#include "SimilarTracksPanel.h"
+#include "FingerprintIndex.h"
+#include "DuplicatesPanel.h"
+
+class PlaylistComponent :   public juce::Component,
+public juce::TableListBoxModel,
+public juce::Button::Listener,
+public juce::TextEditor::Listener
+{
+public:
+    PlaylistComponent(juce::AudioFormatManager& _formatManager,
+                      DJAudioPlayer*      _player,
+                      DeckGUI*            _deckGUI1,
+                      DeckGUI*            _deckGUI2,
+                      AutoMixer*          _autoMixer,
+                      TrackPreloader*     _trackPreloader);
+    ~PlaylistComponent() override;
+    
+    void paint(juce::Graphics&) override;
+    void resized() override;
+    /** Returns the number of rows in the table */
+    int getNumRows() override;
+    
+    /** Provides graphic code that draws the background of a row in the table */
+    void paintRowBackground (juce::Graphics &,
+                             int rowNumber,
+                             int width,
+                             int height,
+                             bool rowIsSelected) override;
+    
+    /**  Graphical code which draws the contents of individual cells */
+    void paintCell (juce::Graphics&,
+                    int rowNumber,
+                    int columnId,
+                    int width,
+                    int height,
+                    bool rowIsSelected) override;
+    
+    /** Re-sorts the table when a column header is clicked, the previous sort breaks ties */
+    void sortOrderChanged (int newSortColumnId, bool isForwards) override;
+    
+    /** Shows the songs similar to the selected song */
+    void selectedRowsChanged (int lastRowSelected) override;
+    
+    /** Loads or removes the song of a row when one of its action cells is clicked */
+    void cellClicked (int rowNumber,
+                      int columnId,
+                      const juce::MouseEvent&) override;
+    
+    /** Compute the raw audio duration data to minutes and seconds */
+    juce::String computeAudioDuration (double lengthInSeconds);
+    
+    /** Load existing songs*/
+    void loadExistingSongsToLibrary();
+    
+    /** Add an indexed song to the end of the table */
+    void addSongToTable (const LibraryEntry& entry);
+    
+    /** Insert a song into the table order, keeping the table sorted */
+    void insertIntoTableOrder (TrackStore::TrackId id);
+    
+    /** Add a newly probed song, or refresh the row of a song that is already listed */
+    void addOrUpdateSong (const LibraryEntry& entry);
+    
+    /** Remove a song from the table and the index without touching the file */
+    void removeSongFromTable (TrackStore::TrackId id);
+    
+    /** Apply changes reported by the library watcher without rescanning */
+    void libraryFilesChanged (const std::vector<LibraryWatcher::Event>& events);
+    
+    /** Remove the song at a path, or every song below it if it was a directory */
+    void removeSongsAt (const juce::File& fileOrDirectory);
+    
+    /** Compare the music folder with the table, for when the watcher lost track of changes */
+    void rescanMusicFolder (juce::Array<juce::File>& filesToProbe);
+    
+    /** Move the songs at a path to a new path, keeping their metadata */
+    void renameSongs (const juce::File& oldFile, const juce::File& newFile);
+    
+    /** Returns true if the file has an extension of one of the registered formats */
+    bool isAudioFile (const juce::File& file);
+    
+    /** Receive a batch of probed songs from the library scanner */
+    void libraryScanBatchReady (std::vector<LibraryEntry>& entries, juce::Array<juce::File>& unreadableFiles);
+    
+    /** Save the index and show the size of the library once the library scan is done */
+    void libraryScanFinished();
+    
+    /** Add songs */
+    void addNewSongsToLibrary();
+    
+    /** Receive a batch of imported songs from the library importer */
+    void importBatchReady (std::vector<LibraryEntry>& entries);
+    
+    /** Save the index and hide the progress bar once an import is done */
+    void importFinished();
+    
+    /** Queue songs whose tempo has not been analysed yet */
+    void analyseSongsIfNeeded (const juce::Array<juce::File>& files);
+    
+    /** Store a batch of beat grids from the track analysis pool */
+    void trackAnalysisReady (std::vector<TrackAnalysis>& results);
+    
+    /** Show the import progress and copy throughput */
+    void updateImportProgress();
+    
+    /** Filter the table to the songs matching the search bar */
+    void searchLibrary();
+    
+    /** List the songs that sound most like a song in the similar tracks panel */
+    void showSimilarTracks (TrackStore::TrackId id);
+    
+    /** Toggle between the similar tracks panel and the groups of duplicate songs */
+    void showDuplicates (bool shouldShow);
+    
+    /** List the groups of copies found by a background duplicate search */
+    void duplicatesFound (const std::vector<std::vector<juce::uint32>>& groups, int searchId);
+    
+    /** Keep one copy of a duplicated song, giving it the earliest date added, and delete the others */
+    void mergeDuplicates (TrackStore::TrackId keptId, const std::vector<juce::uint32>& otherIds);
+    
+    /** Returns the song to find harmonic mixes for, or invalidId when the table is not matched to a deck */
+    TrackStore::TrackId getTrackIdToMatch() const;
+    
+    /** Returns the song shown on a row of the table, which may be filtered */
+    TrackStore::TrackId getTrackIdForRow (int rowNumber) const;
+    
+    /** Search the library on every keystroke */
+    void textEditorTextChanged (juce::TextEditor &) override;
+    
+    /** Select the first matching song when the return key is pressed */
+    void textEditorReturnKeyPressed (juce::TextEditor &) override;
+    
+    /** Parse the song URL to the deckGUI component */
+    void loadSongToDeck (DeckGUI* deckGUI, TrackStore::TrackId id);
+    
+    /** Start mixing the songs in the order the table lists them, or stop */
+    void setAutomixEnabled (bool shouldBeEnabled);
+    
+    /** Add a song to the end of a deck's up next queue */
+    void queueSongOnDeck (DeckGUI* deckGUI, TrackStore::TrackId id);
+    
+    /** Decode the next queued song of a deck in the background, so loading it is instant */
+    void preloadNextSong (DeckGUI* deckGUI);
+    
+    /** Returns the up next queue of a deck */
+    std::deque<TrackStore::TrackId>& getQueue (DeckGUI* deckGUI);
+    
+    /** Give a deck the beat grid, loudness and key of its song */
+    void sendAnalysisToDeck (DeckGUI* deckGUI, TrackStore::TrackId id);
+    
+    /** Delete sonr */
+    void deleteSongFromLibrary (TrackStore::TrackId id);
+    
+    /** Button listener to check if a button is clicked */
+    void buttonClicked (juce::Button* button) override;
+    
+private:
+    // A formatManager objects that handles audio formats and decide which one to use to open a file
+    juce::AudioFormatManager& formatManager;
+    
+    // A player object that points to the DJAudioPlayer
+    DJAudioPlayer* player;
+    
+    // Two deckGUI objects that points to the DeckGUI
+    DeckGUI* deckGUI1;
+    DeckGUI* deckGUI2;
+    
+    // Mixes the table's songs unattended when the automix button is on
+    AutoMixer* autoMixer;
+    
+    // Decodes the next song of each deck into memory, sharing its budget with the automixer
+    TrackPreloader* trackPreloader;
+    
+    // A customLookAndFeel object to manage visual UI elements
+    Customisation customisation;
+    juce::TextButton addButton {"Add song +"};
+    juce::TextButton duplicatesButton {"Duplicates"};
+    juce::TextButton automixButton {"Automix"};
+    juce::ComboBox importModeBox;
+    juce::ComboBox matchModeBox;
+    juce::TextEditor searchBar;
+    juce::Label scanStatusLabel;
+    
+    // Fraction of the current import that is done, polled by the progress bar
+    double importProgress = 0.0;
+    juce::ProgressBar importProgressBar { importProgress };
+    
+    juce::TableListBox tableComponent;
+    SimilarTracksPanel similarTracksPanel;
+    DuplicatesPanel duplicatesPanel;
+    
+    // Storing of files/folders/songs
+    juce::File musicFolder = juce::File::getSpecialLocation (juce::File::userDesktopDirectory).getFullPathName() + "/music-folder";
+    juce::String songSelected;
+    std::unique_ptr<juce::FileChooser> chooser;
+    
+    // On-disk metadata cache, so startup does not have to open every audio file
+    LibraryIndex libraryIndex { LibraryIndex::getDefaultIndexFile() };
+    
+    // Probes new and modified files on a worker pool
+    LibraryScanner libraryScanner { formatManager };
+    
+    // Copies, probes and analyses newly added songs in the background
+    LibraryImporter libraryImporter { formatManager, musicFolder };
+    
+    // Reports files added, removed or renamed in the music folder
+    LibraryWatcher libraryWatcher;
+    
+    // Finds the tempo and beat grid of every song in the background
+    TrackAnalysisPool trackAnalysisPool { formatManager };
+    
+    
+    // Songs queued to play next on each deck, front first
+    std::deque<TrackStore::TrackId> leftDeckQueue;
+    std::deque<TrackStore::TrackId> rightDeckQueue;
+    
+    // Metadata of every listed song, addressed by stable track ids
+    TrackStore trackStore;
+    
+    // Songs in the order they are listed in the table
+    std::vector<TrackStore::TrackId> tableOrder;
+    
+    // Active sort, most recently clicked column first
+    std::vector<TrackStore::SortKey> sortKeys;
+    
+    // Title, artist and album text of every song, keyed by track id and searched on each keystroke
+    SearchIndex searchIndex;
+    
+    // Songs by key and tempo, for listing the songs that mix with a deck's song
+    HarmonicMixIndex harmonicMixIndex;
+    
+    // Timbre of every analysed song, searched for the similar tracks panel
+    SimilarityIndex similarityIndex;
+    
+    // Threads to search the similarity index on, only created once the library is large enough to need them
+    std::unique_ptr<juce::ThreadPool> similaritySearchPool;
+    
+    // Song the similar tracks panel lists matches for, by file as track ids are reused
+    juce::File similarTracksSource;
+    
+    // Fingerprints of every analysed song, for finding copies of the same song
+    FingerprintIndex fingerprintIndex;
+    
+    // Runs duplicate searches off the message thread, and the number of the latest search
+    juce::ThreadPool duplicateSearchPool { 1 };
+    int duplicateSearchId = 0;
+    
+    // Song last loaded onto each deck, or invalidId
+    TrackStore::TrackId leftDeckTrackId = TrackStore::invalidId;
+    TrackStore::TrackId rightDeckTrackId = TrackStore::invalidId;
+    
+    // Songs shown in the table while the search bar holds a query or the table is matched to a deck
+    std::vector<TrackStore::TrackId> visibleTrackIds;
+    bool isFiltering = false;
+    
+    // Colours
+    juce::Colour lightGrey = juce::Colour (61, 61, 61);
+    juce::Colour darkGrey  = juce::Colour (39, 39, 39);
+    juce::Colour green     = juce::Colour (0, 179, 0);
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PlaylistComponent)
+};
+// End of Added Code
@@ -0,0 +1,144 @@
+/*
+  ==============================================================================
+
+    RefreshScheduler.cpp
+    Created: 22 Oct 2026 7:36:52pm
+    Author:  Justin  Lim
+
+  ==============================================================================
+*/
+
+#include "RefreshScheduler.h"
+#include "FrameProfiler.h"
+
+RefreshScheduler::RefreshScheduler (juce::Component& host)
+    : vBlankAttachment (&host, [this] { refreshClients(); })
+{
+}
+
+RefreshScheduler::~RefreshScheduler() {}
+
+
+// Subscribes a client, subscribing it again only changes its rate
+void RefreshScheduler::addClient (Client* client, int framesPerRefresh)
+{
+    jassert (client != nullptr);
+
+    framesPerRefresh = juce::jmax (1, framesPerRefresh);
+
+    for (auto& subscription : subscriptions)
+    {
+        if (subscription.client == client)
+        {
+            subscription.framesPerRefresh = framesPerRefresh;
+            return;
+        }
+    }
+
+    subscriptions.push_back ({ client, framesPerRefresh, frameCount - framesPerRefresh });
+}
+
+
+// Unsubscribes a client, it is safe to call while clients are being refreshed
+void RefreshScheduler::removeClient (Client* client)
+{
+    for (auto& subscription : subscriptions)
+        if (subscription.client == client)
+            subscription.client = nullptr;
+}
+
+
+// Set how long a frame may spend refreshing clients, in milliseconds
+void RefreshScheduler::setFrameBudget (double milliseconds)
+{
+    frameBudget = juce::jmax (0.1, milliseconds);
+}
+
+
+// Returns how long a frame may spend refreshing clients, in milliseconds
+double RefreshScheduler::getFrameBudget() const
+{
+    return frameBudget;
+}
+
+
+// Returns the time the last frame spent refreshing clients, in milliseconds
+double RefreshScheduler::getLastFrameTime() const
+{
+    return lastFrameTime;
+}
+
+
+// Returns the number of clients the last frame ran out of budget before refreshing
+int RefreshScheduler::getNumDeferredClients() const
+{
+    return numDeferredClients;
+}
+
+
+/*
+    Refreshes the clients that are due on this frame.
+
+    Clients are visited round-robin from the first one the last frame had to leave
+    out, and a client that is due but skipped for the budget stays due, so it is
+    refreshed early in the next frame. At least one client is refreshed each frame
+    so a single slow client cannot stall the rest forever.
+*/
+void RefreshScheduler::refreshClients()
+{
+    FrameProfiler::ScopedSection section ("RefreshScheduler::refreshClients");
+
+    ++frameCount;
+
+    // Drop clients that unsubscribed, possibly from inside a refresh
+    subscriptions.erase (std::remove_if (subscriptions.begin(), subscriptions.end(),
+                                         [] (const Subscription& s) { return s.client == nullptr; }),
+                         subscriptions.end());
+
+    numDeferredClients = 0;
+
+    if (subscriptions.empty())
+    {
+        lastFrameTime = 0.0;
+        return;
+    }
+
+    auto frameStart = juce::Time::getMillisecondCounterHiRes();
+    auto numClients = subscriptions.size();
+    auto first = nextClient % numClients;
+    auto numRefreshed = 0;
+
+    nextClient = first;
+
+    for (size_t i = 0; i < numClients; ++i)
+    {
+        auto index = (first + i) % numClients;
+        auto& subscription = subscriptions[index];
+
+        if (subscription.client == nullptr || frameCount - subscription.lastRefreshFrame < subscription.framesPerRefresh)
+            continue;
+
+        // Components that are not on screen have nothing to show
+        if (auto* component = dynamic_cast<juce::Component*> (subscription.client))
+            if (! component -> isShowing())
+                continue;
+
+        if (! subscription.client -> needsRefresh())
+            continue;
+
+        if (numRefreshed > 0 && juce::Time::getMillisecondCounterHiRes() - frameStart > frameBudget)
+        {
+            // Out of budget, the rest wait for the next frame and it starts with this one
+            if (numDeferredClients++ == 0)
+                nextClient = index;
+
+            continue;
+        }
+
+        subscription.lastRefreshFrame = frameCount;
+        subscription.client -> refreshDisplay();
+        ++numRefreshed;
+    }
+
+    lastFrameTime = juce::Time::getMillisecondCounterHiRes() - frameStart;
+}
@@ -0,0 +1,86 @@
+/*
+  ==============================================================================
+
+    RefreshScheduler.h
+    Created: 22 Oct 2026 7:36:52pm
+    Author:  Justin  Lim
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/**
+    Drives every display that follows playback from one callback per screen refresh.
+
+    Clients subscribe instead of running timers of their own, so the whole UI
+    wakes up once per frame in step with the display. Clients that are hidden or
+    report they have nothing new to show are skipped. The frame has a time budget:
+    once it is spent the remaining clients wait for the next frame, and the next
+    frame starts with them so no client is starved.
+*/
+class RefreshScheduler
+{
+public:
+    /** Something that redraws once per frame while it has something new to show */
+    class Client
+    {
+    public:
+        virtual ~Client() = default;
+
+        /** Returns true if the client has something new to show, clients that return false are skipped */
+        virtual bool needsRefresh() { return true; }
+
+        /** Updates the client's display, called on the message thread */
+        virtual void refreshDisplay() = 0;
+    };
+
+    /** Attaches to the screen refreshes of the window the host component is in */
+    explicit RefreshScheduler (juce::Component& host);
+    ~RefreshScheduler();
+
+    /** Subscribes a client, refreshed at most once every framesPerRefresh frames */
+    void addClient (Client* client, int framesPerRefresh = 1);
+
+    /** Unsubscribes a client */
+    void removeClient (Client* client);
+
+    /** Set how long a frame may spend refreshing clients, in milliseconds */
+    void setFrameBudget (double milliseconds);
+
+    /** Returns how long a frame may spend refreshing clients, in milliseconds */
+    double getFrameBudget() const;
+
+    /** Returns the time the last frame spent refreshing clients, in milliseconds */
+    double getLastFrameTime() const;
+
+    /** Returns the number of clients the last frame ran out of budget before refreshing */
+    int getNumDeferredClients() const;
+
+private:
+    struct Subscription
+    {
+        Client* client = nullptr;
+        int framesPerRefresh = 1;
+        juce::int64 lastRefreshFrame = 0;
+    };
+
+    // Refreshes the clients that are due, starting where the last frame ran out of budget
+    void refreshClients();
+
+    std::vector<Subscription> subscriptions;
+
+    // Index of the first client to refresh next frame
+    size_t nextClient = 0;
+
+    juce::int64 frameCount = 0;
+    double frameBudget = 4.0;
+    double lastFrameTime = 0.0;
+    int numDeferredClients = 0;
+
+    juce::VBlankAttachment vBlankAttachment;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (RefreshScheduler)
+};
@@ -0,0 +1,379 @@
+/*
+  ==============================================================================
+
+    SearchIndex.cpp
+    Created: 20 Oct 2026 2:26:48pm
+    Author:  Justin  Lim
+
+  ==============================================================================
+*/
+
+#include "SearchIndex.h"
+
+namespace
+{
+    // Words shorter than this are only ever matched exactly
+    constexpr size_t minFuzzyWordLength = 5;
+
+    // Longest word that fuzzy matching is attempted on
+    constexpr size_t maxFuzzyWordLength = 32;
+
+    juce::uint32 trigramAt (const std::string& text, size_t pos)
+    {
+        return (juce::uint32) (juce::uint8) text[pos] << 16
+             | (juce::uint32) (juce::uint8) text[pos + 1] << 8
+             | (juce::uint32) (juce::uint8) text[pos + 2];
+    }
+
+    // Returns the distinct trigrams of a piece of text in ascending order
+    std::vector<juce::uint32> getTrigrams (const std::string& text)
+    {
+        std::vector<juce::uint32> trigrams;
+
+        for (size_t i = 0; i + 3 <= text.size(); ++i)
+            trigrams.push_back (trigramAt (text, i));
+
+        std::sort (trigrams.begin(), trigrams.end());
+        trigrams.erase (std::unique (trigrams.begin(), trigrams.end()), trigrams.end());
+        return trigrams;
+    }
+
+    // Splits normalised text into its words
+    std::vector<std::string> getWords (const std::string& text)
+    {
+        std::vector<std::string> words;
+        size_t start = 0;
+
+        while (start < text.size())
+        {
+            auto end = text.find (' ', start);
+
+            if (end == std::string::npos)
+                end = text.size();
+
+            if (end > start)
+                words.push_back (text.substr (start, end - start));
+
+            start = end + 1;
+        }
+
+        return words;
+    }
+
+    // Number of edits a word may be away from the text it matches
+    int getMaxEdits (const std::string& word)
+    {
+        return word.size() >= 8 ? 2 : 1;
+    }
+
+    // Returns true if some substring of the text is within maxEdits of the word (Sellers' algorithm)
+    bool containsApproximately (const std::string& word, const std::string& text, int maxEdits)
+    {
+        std::array<int, maxFuzzyWordLength + 1> column;
+        auto length = word.size();
+
+        for (size_t i = 0; i <= length; ++i)
+            column[i] = static_cast<int> (i);
+
+        for (auto c : text)
+        {
+            // A match may start anywhere in the text, so the top row is always free
+            auto diagonal = column[0];
+            column[0] = 0;
+
+            for (size_t i = 1; i <= length; ++i)
+            {
+                auto above = column[i];
+                column[i] = juce::jmin (above + 1, column[i - 1] + 1, diagonal + (word[i - 1] == c ? 0 : 1));
+                diagonal = above;
+            }
+
+            if (column[length] <= maxEdits)
+                return true;
+        }
+
+        return false;
+    }
+
+    // Returns true if the text contains the word, or something close to it when fuzzy
+    bool matchesWord (const std::string& text, const std::string& word, bool fuzzy)
+    {
+        if (text.find (word) != std::string::npos)
+            return true;
+
+        return fuzzy && word.size() >= minFuzzyWordLength && word.size() <= maxFuzzyWordLength
+            && containsApproximately (word, text, getMaxEdits (word));
+    }
+}
+
+//==============================================================================
+// Adds a song as a new document
+void SearchIndex::add (juce::uint32 key, const juce::String& title, const juce::String& artist, const juce::String& album)
+{
+    jassert (documentOfKey.count (key) == 0);
+
+    auto documentId = static_cast<int> (documents.size());
+
+    Document document;
+    document.text = normalise (title + " " + artist + " " + album);
+    document.key = key;
+
+    // Ids only ever grow, so every list stays sorted
+    for (auto trigram : getTrigrams (document.text))
+        trigramDocuments[trigram].push_back (documentId);
+
+    documents.push_back (std::move (document));
+    documentOfKey[key] = documentId;
+    ++numAlive;
+    lastResultsAreValid = false;
+}
+
+
+// Replaces the text of a song with a new document
+void SearchIndex::update (juce::uint32 key, const juce::String& title, const juce::String& artist, const juce::String& album)
+{
+    remove (key);
+    add (key, title, artist, album);
+}
+
+
+// Tombstones the document of a song, purging the trigram lists once most of their ids are dead
+void SearchIndex::remove (juce::uint32 key)
+{
+    auto found = documentOfKey.find (key);
+
+    if (found == documentOfKey.end())
+        return;
+
+    auto& document = documents[(size_t) found -> second];
+    documentOfKey.erase (found);
+
+    document.isAlive = false;
+    document.text = {};
+
+    --numAlive;
+    ++numRemovedInLists;
+    lastResultsAreValid = false;
+
+    if (numRemovedInLists > 4096 && numRemovedInLists > numAlive)
+        purgeRemovedDocuments();
+}
+
+
+// Removes every song
+void SearchIndex::clear()
+{
+    documents.clear();
+    documentOfKey.clear();
+    trigramDocuments.clear();
+    numRemovedInLists = 0;
+    numAlive = 0;
+    lastResultsAreValid = false;
+}
+
+
+/*
+    Finds the songs that match every word of a query.
+
+    Words are matched as substrings of the title, artist and album. If no song
+    matches them all, the search is repeated allowing one edit in words of five
+    to seven characters and two edits in longer words.
+
+    @param query   Text typed into the search bar.
+
+    @return        Keys of the matching songs in ascending order.
+*/
+std::vector<juce::uint32> SearchIndex::search (const juce::String& query)
+{
+    auto normalised = normalise (query);
+    auto words = getWords (normalised);
+
+    std::vector<int> candidates;
+
+    // Each word of a query typed after the previous one contains a word of that query,
+    // so its exact matches are a subset of the previous ones
+    if (lastResultsAreValid && ! lastQuery.empty() && normalised.compare (0, lastQuery.size(), lastQuery) == 0)
+        candidates = lastResults;
+    else
+        candidates = findExactCandidates (words);
+
+    std::vector<int> results;
+
+    for (auto documentId : candidates)
+    {
+        auto& document = documents[(size_t) documentId];
+
+        if (document.isAlive && std::all_of (words.begin(), words.end(), [&document] (const std::string& word)
+                                             { return matchesWord (document.text, word, false); }))
+            results.push_back (documentId);
+    }
+
+    lastQuery = normalised;
+    lastResults = results;
+    lastResultsAreValid = true;
+
+    if (results.empty())
+    {
+        // Fuzzy results are not a subset of anything, so the next query starts afresh
+        results = findFuzzyMatches (words);
+        lastResultsAreValid = false;
+    }
+
+    std::vector<juce::uint32> keys;
+    keys.reserve (results.size());
+
+    for (auto documentId : results)
+        keys.push_back (documents[(size_t) documentId].key);
+
+    std::sort (keys.begin(), keys.end());
+    return keys;
+}
+
+
+// Lower cases text and turns everything but letters and digits into single spaces
+std::string SearchIndex::normalise (const juce::String& text)
+{
+    juce::String result;
+    result.preallocateBytes (text.getNumBytesAsUTF8());
+
+    auto lastWasSpace = true;
+
+    for (auto c : text.toLowerCase())
+    {
+        if (juce::CharacterFunctions::isLetterOrDigit (c))
+        {
+            result += c;
+            lastWasSpace = false;
+        }
+        else if (! lastWasSpace)
+        {
+            result += ' ';
+            lastWasSpace = true;
+        }
+    }
+
+    return result.trimEnd().toStdString();
+}
+
+
+// Intersects the trigram lists of the words, shortest list first
+std::vector<int> SearchIndex::findExactCandidates (const std::vector<std::string>& words) const
+{
+    std::vector<const std::vector<int>*> lists;
+
+    for (auto& word : words)
+    {
+        for (auto trigram : getTrigrams (word))
+        {
+            auto found = trigramDocuments.find (trigram);
+
+            // A trigram that is in no song means no song can match
+            if (found == trigramDocuments.end())
+                return {};
+
+            lists.push_back (&found -> second);
+        }
+    }
+
+    std::vector<int> candidates;
+
+    // Words shorter than a trigram have to be checked against every song
+    if (lists.empty())
+    {
+        for (int documentId = 0; documentId < static_cast<int> (documents.size()); ++documentId)
+            if (documents[(size_t) documentId].isAlive)
+                candidates.push_back (documentId);
+
+        return candidates;
+    }
+
+    std::sort (lists.begin(), lists.end(), [] (auto* a, auto* b) { return a -> size() < b -> size(); });
+
+    candidates = *lists.front();
+    std::vector<int> intersection;
+
+    for (size_t i = 1; i < lists.size() && ! candidates.empty(); ++i)
+    {
+        intersection.clear();
+        std::set_intersection (candidates.begin(), candidates.end(), lists[i] -> begin(), lists[i] -> end(),
+                               std::back_inserter (intersection));
+        std::swap (candidates, intersection);
+    }
+
+    return candidates;
+}
+
+
+/*
+    Matches every word of a query allowing a few edits in the longer words.
+
+    Candidates are the songs sharing enough trigrams with the longest word: a
+    substring within k edits of a word with T trigrams shares at least T - 3k of
+    them. Each candidate is then verified word by word.
+*/
+std::vector<int> SearchIndex::findFuzzyMatches (const std::vector<std::string>& words)
+{
+    auto longest = std::max_element (words.begin(), words.end(), [] (auto& a, auto& b) { return a.size() < b.size(); });
+
+    if (longest == words.end() || longest -> size() < minFuzzyWordLength || longest -> size() > maxFuzzyWordLength)
+        return {};
+
+    auto trigrams = getTrigrams (*longest);
+    auto minShared = juce::jmax (1, static_cast<int> (trigrams.size()) - 3 * getMaxEdits (*longest));
+
+    sharedTrigramCounts.resize (documents.size());
+    std::vector<int> touched;
+
+    for (auto trigram : trigrams)
+    {
+        auto found = trigramDocuments.find (trigram);
+
+        if (found == trigramDocuments.end())
+            continue;
+
+        for (auto documentId : found -> second)
+        {
+            auto& count = sharedTrigramCounts[(size_t) documentId];
+
+            if (count++ == 0)
+                touched.push_back (documentId);
+        }
+    }
+
+    std::sort (touched.begin(), touched.end());
+    std::vector<int> results;
+
+    for (auto documentId : touched)
+    {
+        auto& document = documents[(size_t) documentId];
+
+        if (sharedTrigramCounts[(size_t) documentId] >= minShared && document.isAlive
+             && std::all_of (words.begin(), words.end(), [&document] (const std::string& word)
+                             { return matchesWord (document.text, word, true); }))
+            results.push_back (documentId);
+
+        sharedTrigramCounts[(size_t) documentId] = 0;
+    }
+
+    return results;
+}
+
+
+// Drops the ids of removed documents from the trigram lists
+void SearchIndex::purgeRemovedDocuments()
+{
+    for (auto it = trigramDocuments.begin(); it != trigramDocuments.end();)
+    {
+        auto& list = it -> second;
+        list.erase (std::remove_if (list.begin(), list.end(), [this] (int documentId)
+                                    { return ! documents[(size_t) documentId].isAlive; }),
+                    list.end());
+
+        if (list.empty())
+            it = trigramDocuments.erase (it);
+        else
+            ++it;
+    }
+
+    numRemovedInLists = 0;
+}
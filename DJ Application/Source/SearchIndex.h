@@ -0,0 +1,84 @@
+/*
+  ==============================================================================
+
+    SearchIndex.h
+    Created: 20 Oct 2026 2:26:48pm
+    Author:  Justin  Lim
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/**
+    In-memory full text index over the title, artist and album of every song.
+
+    Text is normalised to lower case words, and every three byte window of it is
+    recorded in a trigram index. A query matches a song when each of its words is
+    a substring of the song's text: the trigram lists of the words are intersected
+    to find candidates, which are then verified. When nothing matches exactly,
+    words of five or more characters are matched within one or two edits instead.
+
+    Songs are identified by the caller's key, such as a track id. Internally each
+    version of a song's text is a document: removing or updating a song leaves a
+    tombstone, and tombstoned documents are purged from the trigram lists once
+    they make up most of the index.
+*/
+class SearchIndex
+{
+public:
+    SearchIndex() = default;
+
+    /** Adds a song under a key that is not in the index yet */
+    void add (juce::uint32 key, const juce::String& title, const juce::String& artist, const juce::String& album);
+
+    /** Replaces the text of a song, or adds it if the key is not in the index */
+    void update (juce::uint32 key, const juce::String& title, const juce::String& artist, const juce::String& album);
+
+    /** Removes a song from the results of future searches */
+    void remove (juce::uint32 key);
+
+    /** Removes every song */
+    void clear();
+
+    /** Returns the keys of the songs matching every word of the query, in ascending order */
+    std::vector<juce::uint32> search (const juce::String& query);
+
+    /** Lower cases text and turns everything but letters and digits into single spaces */
+    static std::string normalise (const juce::String& text);
+
+private:
+    struct Document
+    {
+        std::string text;
+        juce::uint32 key = 0;
+        bool isAlive = true;
+    };
+
+    // Returns the documents containing every trigram of the words that have any
+    std::vector<int> findExactCandidates (const std::vector<std::string>& words) const;
+
+    // Returns the documents matching every word, allowing edits in the longer ones
+    std::vector<int> findFuzzyMatches (const std::vector<std::string>& words);
+
+    // Drops the ids of removed documents from the trigram lists
+    void purgeRemovedDocuments();
+
+    std::vector<Document> documents;
+    std::unordered_map<juce::uint32, int> documentOfKey;
+    std::unordered_map<juce::uint32, std::vector<int>> trigramDocuments;
+    int numRemovedInLists = 0;
+    int numAlive = 0;
+
+    // The previous query and its results, which a longer query typed after it only has to narrow down
+    std::string lastQuery;
+    std::vector<int> lastResults;
+    bool lastResultsAreValid = false;
+
+    // Per document count of shared trigrams, reused between fuzzy searches
+    std::vector<juce::uint8> sharedTrigramCounts;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SearchIndex)
+};
@@ -0,0 +1,109 @@
+/*
+  ==============================================================================
+
+    SimilarTracksPanel.cpp
+    Created: 21 Oct 2026 7:41:09pm
+    Author:  Justin  Lim
+
+  ==============================================================================
+*/
+
+#include "SimilarTracksPanel.h"
+
+SimilarTracksPanel::SimilarTracksPanel()
+{
+    addAndMakeVisible (headingLabel);
+    addAndMakeVisible (listBox);
+
+    // Heading label properties
+    headingLabel.setFont              (juce::Font (13.0f, juce::Font::bold));
+    headingLabel.setJustificationType (juce::Justification::centredLeft);
+    headingLabel.setColour            (juce::Label::textColourId, juce::Colours::white);
+
+    listBox.setRowHeight (24);
+
+    clearResults ("Select a song to see similar songs");
+}
+
+SimilarTracksPanel::~SimilarTracksPanel() {}
+
+
+void SimilarTracksPanel::paint (juce::Graphics& g)
+{
+    g.fillAll (getLookAndFeel().findColour (juce::ResizableWindow::backgroundColourId));
+}
+
+
+// Heading on top, list below
+void SimilarTracksPanel::resized()
+{
+    auto bounds = getLocalBounds();
+
+    headingLabel.setBounds (bounds.removeFromTop (24));
+    listBox.setBounds (bounds);
+}
+
+
+// Shows the songs similar to a song, most similar first
+void SimilarTracksPanel::setResults (const juce::String& sourceTitle, std::vector<Item> newItems)
+{
+    items = std::move (newItems);
+
+    headingLabel.setText (items.empty() ? "Nothing similar to " + sourceTitle : "Like " + sourceTitle, juce::dontSendNotification);
+    listBox.updateContent();
+    listBox.repaint();
+}
+
+
+// Empties the list and shows a message in its place
+void SimilarTracksPanel::clearResults (const juce::String& message)
+{
+    items.clear();
+
+    headingLabel.setText (message, juce::dontSendNotification);
+    listBox.updateContent();
+    listBox.repaint();
+}
+
+
+// Returns the number of rows in the list
+int SimilarTracksPanel::getNumRows()
+{
+    return static_cast<int> (items.size());
+}
+
+
+// Draws a song's title between its load actions
+void SimilarTracksPanel::paintListBoxItem (int rowNumber, juce::Graphics& g, int width, int height, bool rowIsSelected)
+{
+    if (! juce::isPositiveAndBelow (rowNumber, getNumRows()))
+        return;
+
+    g.fillAll (rowIsSelected ? juce::Colours::darkblue : (rowNumber % 2 == 0 ? juce::Colours::grey : juce::Colours::darkgrey));
+
+    auto actionColour = rowNumber % 2 == 0 ? lightGrey : darkGrey;
+    juce::Rectangle<float> row (0.0f, 0.0f, static_cast<float> (width), static_cast<float> (height));
+
+    customisation.drawTableActionCell (g, row.removeFromLeft ((float) actionCellWidth), "<", actionColour);
+    customisation.drawTableActionCell (g, row.removeFromRight ((float) actionCellWidth), ">", actionColour);
+
+    g.setColour (juce::Colours::white);
+    g.setFont (14.0f);
+    g.drawText (items[(size_t) rowNumber].title, row.reduced (5.0f, 0.0f), juce::Justification::centredLeft, true);
+}
+
+
+// Loads a song onto a deck when one of its action cells is clicked
+void SimilarTracksPanel::listBoxItemClicked (int row, const juce::MouseEvent& e)
+{
+    if (! juce::isPositiveAndBelow (row, getNumRows()) || onLoadToDeck == nullptr)
+        return;
+
+    auto x = e.getEventRelativeTo (&listBox).x;
+    auto rowWidth = listBox.getVisibleRowWidth();
+
+    if (x < actionCellWidth)
+        onLoadToDeck (items[(size_t) row].trackId, true);
+    else if (x >= rowWidth - actionCellWidth)
+        onLoadToDeck (items[(size_t) row].trackId, false);
+}
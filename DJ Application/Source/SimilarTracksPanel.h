@@ -0,0 +1,73 @@
+/*
+  ==============================================================================
+
+    SimilarTracksPanel.h
+    Created: 21 Oct 2026 7:41:09pm
+    Author:  Justin  Lim
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "Customisation.h"
+
+/**
+    Lists the songs that sound most like the song selected in the library.
+
+    Each row has the same load actions as the library table: the left cell loads
+    the song onto the left deck and the right cell onto the right deck.
+*/
+class SimilarTracksPanel : public juce::Component,
+                           public juce::ListBoxModel
+{
+public:
+    /** A song in the list */
+    struct Item
+    {
+        juce::uint32 trackId = 0;
+        juce::String title;
+    };
+
+    SimilarTracksPanel();
+    ~SimilarTracksPanel() override;
+
+    void paint (juce::Graphics&) override;
+    void resized() override;
+
+    /** Shows the songs similar to a song, most similar first */
+    void setResults (const juce::String& sourceTitle, std::vector<Item> newItems);
+
+    /** Empties the list */
+    void clearResults (const juce::String& message);
+
+    /** Returns the number of rows in the list */
+    int getNumRows() override;
+
+    /** Draws a song's title between its load actions */
+    void paintListBoxItem (int rowNumber, juce::Graphics& g, int width, int height, bool rowIsSelected) override;
+
+    /** Loads a song onto a deck when one of its action cells is clicked */
+    void listBoxItemClicked (int row, const juce::MouseEvent& e) override;
+
+    /** Called with a song's track id and true for the left deck or false for the right one */
+    std::function<void (juce::uint32 trackId, bool leftDeck)> onLoadToDeck;
+
+private:
+    // Width of the load action cells at each end of a row
+    static constexpr int actionCellWidth = 30;
+
+    juce::Label headingLabel;
+    juce::ListBox listBox { {}, this };
+
+    std::vector<Item> items;
+
+    // A customLookAndFeel object to draw the action cells the way the library table does
+    Customisation customisation;
+
+    juce::Colour lightGrey = juce::Colour (61, 61, 61);
+    juce::Colour darkGrey  = juce::Colour (39, 39, 39);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SimilarTracksPanel)
+};
@@ -0,0 +1,255 @@
+/*
+  ==============================================================================
+
+    SimilarityIndex.cpp
+    Created: 21 Oct 2026 6:58:30pm
+    Author:  Justin  Lim
+
+  ==============================================================================
+*/
+
+#include "SimilarityIndex.h"
+
+namespace
+{
+    // Smallest slice of the matrix worth handing to another thread
+    constexpr size_t minRowsPerJob = 50000;
+
+    // Orders matches nearest first, ties by key so results are stable
+    bool isNearer (const SimilarityIndex::Match& a, const SimilarityIndex::Match& b)
+    {
+        return a.distance < b.distance || (a.distance == b.distance && a.key < b.key);
+    }
+}
+
+//==============================================================================
+// Adds or replaces the features of a song
+void SimilarityIndex::update (juce::uint32 key, const std::vector<float>& songFeatures)
+{
+    if (songFeatures.size() != (size_t) TimbreAnalyser::numFeatures)
+    {
+        remove (key);
+        return;
+    }
+
+    auto existing = rowOfKey.find (key);
+    size_t row;
+
+    if (existing != rowOfKey.end())
+    {
+        row = existing -> second;
+    }
+    else
+    {
+        row = keys.size();
+        keys.push_back (key);
+        rowOfKey[key] = row;
+        features.resize (features.size() + (size_t) TimbreAnalyser::numFeatures);
+    }
+
+    std::copy (songFeatures.begin(), songFeatures.end(), features.begin() + (std::ptrdiff_t) (row * TimbreAnalyser::numFeatures));
+    matrixIsStale = true;
+}
+
+
+// Removes a song by moving the last row into its place
+void SimilarityIndex::remove (juce::uint32 key)
+{
+    auto existing = rowOfKey.find (key);
+
+    if (existing == rowOfKey.end())
+        return;
+
+    auto row = existing -> second;
+    auto last = keys.size() - 1;
+    auto rowLength = (size_t) TimbreAnalyser::numFeatures;
+
+    if (row != last)
+    {
+        std::copy (features.begin() + (std::ptrdiff_t) (last * rowLength), features.end(), features.begin() + (std::ptrdiff_t) (row * rowLength));
+        keys[row] = keys[last];
+        rowOfKey[keys[row]] = row;
+    }
+
+    keys.pop_back();
+    features.resize (keys.size() * rowLength);
+    rowOfKey.erase (existing);
+
+    matrixIsStale = true;
+}
+
+
+// Removes every song
+void SimilarityIndex::clear()
+{
+    features.clear();
+    matrix.clear();
+    keys.clear();
+    rowOfKey.clear();
+    matrixIsStale = false;
+}
+
+
+// Returns the number of songs with features
+int SimilarityIndex::size() const
+{
+    return static_cast<int> (keys.size());
+}
+
+
+/*
+    Finds the songs whose timbre is nearest to a song's.
+
+    Distances are squared Euclidean distances between standardised feature
+    vectors. The matrix is scanned in one pass, keeping the best matches in a
+    bounded heap. With a pool and a library large enough for two slices, each thread
+    scans its own slice and the slices' best matches are merged.
+
+    @param key           The song to find similar songs for.
+    @param numResults    Most matches to return.
+    @param pool          Optional pool to search large libraries on.
+
+    @return              The nearest songs, not including the song itself, nearest first.
+*/
+std::vector<SimilarityIndex::Match> SimilarityIndex::findSimilar (juce::uint32 key, int numResults, juce::ThreadPool* pool)
+{
+    auto existing = rowOfKey.find (key);
+
+    if (existing == rowOfKey.end() || numResults <= 0)
+        return {};
+
+    if (matrixIsStale)
+        standardise();
+
+    auto queryRow = existing -> second;
+    auto* query = matrix.data() + queryRow * registersPerRow;
+    auto numRows = keys.size();
+
+    auto numJobs = pool != nullptr ? juce::jmin ((size_t) pool -> getNumThreads(), numRows / minRowsPerJob) : 0;
+
+    if (numJobs < 2)
+        return searchRows (query, 0, numRows, queryRow, numResults);
+
+    std::vector<std::vector<Match>> slices (numJobs);
+    std::atomic<size_t> numJobsRunning { numJobs };
+    juce::WaitableEvent finished;
+
+    for (size_t job = 0; job < numJobs; ++job)
+    {
+        pool -> addJob ([&, job]
+        {
+            slices[job] = searchRows (query, numRows * job / numJobs, numRows * (job + 1) / numJobs, queryRow, numResults);
+
+            if (--numJobsRunning == 0)
+                finished.signal();
+        });
+    }
+
+    finished.wait();
+
+    std::vector<Match> results;
+
+    for (auto& slice : slices)
+        results.insert (results.end(), slice.begin(), slice.end());
+
+    auto numToKeep = juce::jmin (results.size(), (size_t) numResults);
+    std::partial_sort (results.begin(), results.begin() + (std::ptrdiff_t) numToKeep, results.end(), isNearer);
+    results.resize (numToKeep);
+
+    return results;
+}
+
+
+// Rebuilds the matrix with every dimension scaled to zero mean and unit variance over the library
+void SimilarityIndex::standardise()
+{
+    constexpr auto rowLength = (size_t) TimbreAnalyser::numFeatures;
+    auto numRows = keys.size();
+
+    std::array<double, rowLength> means {}, variances {};
+
+    if (numRows > 0)
+    {
+        for (size_t row = 0; row < numRows; ++row)
+            for (size_t i = 0; i < rowLength; ++i)
+                means[i] += features[row * rowLength + i];
+
+        for (auto& mean : means)
+            mean /= (double) numRows;
+
+        for (size_t row = 0; row < numRows; ++row)
+        {
+            for (size_t i = 0; i < rowLength; ++i)
+            {
+                auto difference = features[row * rowLength + i] - means[i];
+                variances[i] += difference * difference / (double) numRows;
+            }
+        }
+    }
+
+    // A dimension that is the same for every song says nothing about similarity
+    std::array<float, rowLength> offsets, scales;
+
+    for (size_t i = 0; i < rowLength; ++i)
+    {
+        auto deviation = std::sqrt (variances[i]);
+        offsets[i] = static_cast<float> (means[i]);
+        scales[i] = deviation > 1.0e-9 ? static_cast<float> (1.0 / deviation) : 0.0f;
+    }
+
+    matrix.resize (numRows * registersPerRow);
+
+    alignas (32) float standardised[rowLength];
+
+    for (size_t row = 0; row < numRows; ++row)
+    {
+        for (size_t i = 0; i < rowLength; ++i)
+            standardised[i] = (features[row * rowLength + i] - offsets[i]) * scales[i];
+
+        for (size_t r = 0; r < registersPerRow; ++r)
+            matrix[row * registersPerRow + r] = Register::fromRawArray (standardised + r * Register::SIMDNumElements);
+    }
+
+    matrixIsStale = false;
+}
+
+
+// Scans a slice of the matrix, keeping the nearest matches in a max-heap whose top is the worst one kept
+std::vector<SimilarityIndex::Match> SimilarityIndex::searchRows (const Register* query, size_t begin, size_t end,
+                                                                 size_t skippedRow, int numResults) const
+{
+    std::vector<Match> heap;
+    heap.reserve ((size_t) numResults + 1);
+
+    for (size_t row = begin; row < end; ++row)
+    {
+        if (row == skippedRow)
+            continue;
+
+        auto* values = matrix.data() + row * registersPerRow;
+        auto sum = Register::expand (0.0f);
+
+        for (size_t r = 0; r < registersPerRow; ++r)
+        {
+            auto difference = values[r] - query[r];
+            sum += difference * difference;
+        }
+
+        Match match { keys[row], sum.sum() };
+
+        if (heap.size() < (size_t) numResults)
+        {
+            heap.push_back (match);
+            std::push_heap (heap.begin(), heap.end(), isNearer);
+        }
+        else if (isNearer (match, heap.front()))
+        {
+            std::pop_heap (heap.begin(), heap.end(), isNearer);
+            heap.back() = match;
+            std::push_heap (heap.begin(), heap.end(), isNearer);
+        }
+    }
+
+    std::sort_heap (heap.begin(), heap.end(), isNearer);
+    return heap;
+}
@@ -0,0 +1,77 @@
+/*
+  ==============================================================================
+
+    SimilarityIndex.h
+    Created: 21 Oct 2026 6:58:30pm
+    Author:  Justin  Lim
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "TimbreAnalyser.h"
+
+/**
+    Nearest-neighbour index over the timbre features of every song.
+
+    The features are kept in one flat matrix, a row of SIMD registers per song, so
+    a query is a single linear pass over contiguous memory. Each dimension is
+    standardised over the library, so no single coefficient dominates the
+    distance; the matrix is restandardised lazily before the first query after a
+    change. Large libraries can be searched in slices on a thread pool.
+
+    Songs are identified by the caller's key, such as a track id.
+*/
+class SimilarityIndex
+{
+public:
+    /** A song found by a query, nearer songs having smaller distances */
+    struct Match
+    {
+        juce::uint32 key = 0;
+        float distance = 0.0f;
+    };
+
+    SimilarityIndex() = default;
+
+    /** Adds or replaces the features of a song, a song without features is removed */
+    void update (juce::uint32 key, const std::vector<float>& features);
+
+    /** Removes a song */
+    void remove (juce::uint32 key);
+
+    /** Removes every song */
+    void clear();
+
+    /** Returns the number of songs with features */
+    int size() const;
+
+    /** Returns the songs nearest to a song, nearest first, searching in parallel on the pool if one is given and the library is large */
+    std::vector<Match> findSimilar (juce::uint32 key, int numResults, juce::ThreadPool* pool = nullptr);
+
+private:
+    using Register = juce::dsp::SIMDRegister<float>;
+
+    static constexpr size_t registersPerRow = (size_t) TimbreAnalyser::numFeatures / Register::SIMDNumElements;
+    static_assert (TimbreAnalyser::numFeatures % Register::SIMDNumElements == 0, "Rows must fill whole registers");
+
+    // Rebuilds the standardised matrix from the raw features
+    void standardise();
+
+    // Returns the nearest songs among rows begin to end, skipping one row
+    std::vector<Match> searchRows (const Register* query, size_t begin, size_t end, size_t skippedRow, int numResults) const;
+
+    // Raw features, numFeatures per song, in the same order as the matrix rows
+    std::vector<float> features;
+
+    // Standardised features, registersPerRow per song
+    std::vector<Register> matrix;
+    bool matrixIsStale = false;
+
+    std::vector<juce::uint32> keys;
+    std::unordered_map<juce::uint32, size_t> rowOfKey;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SimilarityIndex)
+};
@@ -0,0 +1,277 @@
+/*
+  ==============================================================================
+
+    TempoAnalyser.cpp
+    Created: 21 Oct 2026 9:48:20am
+    Author:  Justin  Lim
+
+  ==============================================================================
+*/
+
+#include "TempoAnalyser.h"
+
+namespace
+{
+    // Tempo range searched, and the tempo the search leans towards
+    constexpr double minBpm = 60.0;
+    constexpr double maxBpm = 200.0;
+    constexpr double preferredBpm = 120.0;
+
+    // Width in octaves of the preference for tempos near preferredBpm
+    constexpr double tempoPriorWidth = 0.9;
+
+    // Shortest track, in seconds, that a tempo is estimated for
+    constexpr double minAnalysedSeconds = 10.0;
+
+    // Reads the envelope at a fractional frame position
+    float interpolate (const std::vector<float>& envelope, double position)
+    {
+        auto index = static_cast<size_t> (position);
+        auto fraction = static_cast<float> (position - static_cast<double> (index));
+
+        if (index + 1 >= envelope.size())
+            return index < envelope.size() ? envelope[index] : 0.0f;
+
+        return envelope[index] + fraction * (envelope[index + 1] - envelope[index]);
+    }
+
+    // Returns the offset of the vertex of the parabola through three equally spaced points
+    double parabolicPeakOffset (double left, double centre, double right)
+    {
+        auto denominator = left - 2.0 * centre + right;
+        return std::abs (denominator) > 1.0e-12 ? juce::jlimit (-0.5, 0.5, 0.5 * (left - right) / denominator) : 0.0;
+    }
+
+    // Keeps only the rise of the onset envelope above its local mean, so sustained loudness does not count as onsets
+    std::vector<float> getOnsetStrengths (const std::vector<float>& flux, double frameRate)
+    {
+        auto radius = juce::jmax (1, juce::roundToInt (frameRate * 0.25));
+        std::vector<float> strengths (flux.size());
+
+        double windowSum = 0.0;
+        int windowStart = 0, windowEnd = 0;
+
+        for (int i = 0; i < static_cast<int> (flux.size()); ++i)
+        {
+            while (windowEnd < juce::jmin (static_cast<int> (flux.size()), i + radius + 1))
+                windowSum += flux[(size_t) windowEnd++];
+
+            while (windowStart < i - radius)
+                windowSum -= flux[(size_t) windowStart++];
+
+            auto mean = windowSum / (windowEnd - windowStart);
+            strengths[(size_t) i] = juce::jmax (0.0f, static_cast<float> (flux[(size_t) i] - mean));
+        }
+
+        return strengths;
+    }
+
+    struct CombFit
+    {
+        double score = 0.0;
+        double phase = 0.0;   // frames
+    };
+
+    // Finds the phase at which a comb with a given period collects the most onset strength
+    CombFit fitComb (const std::vector<float>& strengths, double period)
+    {
+        auto numPhases = static_cast<int> (std::ceil (period));
+        std::vector<double> scores ((size_t) numPhases, 0.0);
+
+        for (int phase = 0; phase < numPhases; ++phase)
+        {
+            double sum = 0.0;
+
+            for (double position = phase; position < static_cast<double> (strengths.size()); position += period)
+                sum += interpolate (strengths, position);
+
+            scores[(size_t) phase] = sum;
+        }
+
+        auto best = static_cast<int> (std::max_element (scores.begin(), scores.end()) - scores.begin());
+        auto left = scores[(size_t) ((best + numPhases - 1) % numPhases)];
+        auto right = scores[(size_t) ((best + 1) % numPhases)];
+
+        CombFit fit;
+        fit.score = scores[(size_t) best];
+        fit.phase = best + parabolicPeakOffset (left, fit.score, right);
+        return fit;
+    }
+}
+
+//==============================================================================
+// Returns true if a tempo was found
+bool BeatGrid::isValid() const
+{
+    return bpm > 0.0;
+}
+
+
+// Returns the length of one beat in seconds
+double BeatGrid::getBeatLengthInSeconds() const
+{
+    return isValid() ? 60.0 / bpm : 0.0;
+}
+
+
+// Returns the beat number at a position in the track
+double BeatGrid::getBeatAt (double seconds) const
+{
+    return isValid() ? (seconds - firstBeatSeconds) / getBeatLengthInSeconds() : 0.0;
+}
+
+
+// Returns the position in the track of a beat number
+double BeatGrid::getTimeOfBeat (double beat) const
+{
+    return firstBeatSeconds + beat * getBeatLengthInSeconds();
+}
+
+
+//==============================================================================
+TempoAnalyser::TempoAnalyser (double analysisRateToUse)
+    : analysisRate (analysisRateToUse),
+      fftData (2 * fftSize, 0.0f),
+      previousSpectrum (fftSize / 2 + 1, 0.0f)
+{
+    pendingSamples.reserve (fftSize + hopSize);
+}
+
+
+// Adds a block of decimated samples to the frame buffer
+void TempoAnalyser::process (const float* samples, int numSamples)
+{
+    for (int i = 0; i < numSamples; ++i)
+    {
+        pendingSamples.push_back (samples[i]);
+
+        if (static_cast<int> (pendingSamples.size()) >= fftSize)
+            processFrame();
+    }
+}
+
+
+// Adds the positive spectral flux of the oldest frame to the onset envelope
+void TempoAnalyser::processFrame()
+{
+    std::fill (fftData.begin(), fftData.end(), 0.0f);
+    std::copy (pendingSamples.begin(), pendingSamples.begin() + fftSize, fftData.begin());
+
+    window.multiplyWithWindowingTable (fftData.data(), fftSize);
+    fft.performFrequencyOnlyForwardTransform (fftData.data());
+
+    float flux = 0.0f;
+
+    for (size_t bin = 1; bin < previousSpectrum.size(); ++bin)
+    {
+        // Log compression makes quiet onsets count as well as loud ones
+        auto magnitude = std::log1p (100.0f * fftData[bin]);
+        flux += juce::jmax (0.0f, magnitude - previousSpectrum[bin]);
+        previousSpectrum[bin] = magnitude;
+    }
+
+    onsetEnvelope.push_back (flux);
+    pendingSamples.erase (pendingSamples.begin(), pendingSamples.begin() + hopSize);
+}
+
+
+/*
+    Estimates the tempo and first beat from the onset envelope.
+
+    The autocorrelation of the onset strengths, weighted by a log-normal preference
+    for tempos near 120 BPM, picks the tempo to within a few percent. A comb filter
+    is then swept across that range in steps of 0.01 BPM: the period and phase that
+    collect the most onset strength across the track give the grid. Whole-number
+    tempos are preferred when they fit almost as well, as most dance music uses them.
+
+    @return     The beat grid, invalid if the track is too short or has no clear pulse.
+*/
+BeatGrid TempoAnalyser::getBeatGrid() const
+{
+    auto frameRate = analysisRate / hopSize;
+
+    if (onsetEnvelope.size() < static_cast<size_t> (minAnalysedSeconds * frameRate))
+        return {};
+
+    auto strengths = getOnsetStrengths (onsetEnvelope, frameRate);
+    auto numFrames = static_cast<int> (strengths.size());
+
+    // Coarse tempo from the autocorrelation
+    auto minLag = juce::jmax (1, static_cast<int> (std::floor (frameRate * 60.0 / maxBpm)));
+    auto maxLag = static_cast<int> (std::ceil (frameRate * 60.0 / minBpm));
+
+    std::vector<double> autocorrelation ((size_t) maxLag + 2, 0.0);
+
+    for (int lag = minLag - 1; lag <= maxLag + 1; ++lag)
+    {
+        double sum = 0.0;
+
+        for (int i = 0; i + lag < numFrames; ++i)
+            sum += strengths[(size_t) i] * strengths[(size_t) (i + lag)];
+
+        autocorrelation[(size_t) lag] = sum / (numFrames - lag);
+    }
+
+    auto bestLag = 0;
+    auto bestScore = 0.0;
+
+    for (int lag = minLag; lag <= maxLag; ++lag)
+    {
+        auto octaves = std::log2 (frameRate * 60.0 / lag / preferredBpm) / tempoPriorWidth;
+        auto score = autocorrelation[(size_t) lag] * std::exp (-0.5 * octaves * octaves);
+
+        if (score > bestScore)
+        {
+            bestScore = score;
+            bestLag = lag;
+        }
+    }
+
+    if (bestLag == 0)
+        return {};
+
+    auto refinedLag = bestLag + parabolicPeakOffset (autocorrelation[(size_t) bestLag - 1],
+                                                     autocorrelation[(size_t) bestLag],
+                                                     autocorrelation[(size_t) bestLag + 1]);
+    auto coarseBpm = frameRate * 60.0 / refinedLag;
+
+    // Fine tempo and phase from the best fitting comb
+    auto bestBpm = 0.0;
+    CombFit bestFit;
+
+    for (auto bpm = coarseBpm * 0.97; bpm <= coarseBpm * 1.03; bpm += 0.01)
+    {
+        auto fit = fitComb (strengths, frameRate * 60.0 / bpm);
+
+        if (fit.score > bestFit.score)
+        {
+            bestFit = fit;
+            bestBpm = bpm;
+        }
+    }
+
+    if (bestBpm <= 0.0)
+        return {};
+
+    auto wholeBpm = std::round (bestBpm);
+
+    if (std::abs (wholeBpm - bestBpm) < 0.1)
+    {
+        auto wholeFit = fitComb (strengths, frameRate * 60.0 / wholeBpm);
+
+        if (wholeFit.score >= 0.995 * bestFit.score)
+        {
+            bestFit = wholeFit;
+            bestBpm = wholeBpm;
+        }
+    }
+
+    BeatGrid grid;
+    grid.bpm = bestBpm;
+
+    // A flux frame is centred half a window after its start
+    auto firstOnsetSeconds = (bestFit.phase * hopSize + fftSize / 2) / analysisRate;
+    grid.firstBeatSeconds = std::fmod (firstOnsetSeconds, grid.getBeatLengthInSeconds());
+
+    return grid;
+}
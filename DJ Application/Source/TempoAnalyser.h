@@ -0,0 +1,79 @@
+/*
+  ==============================================================================
+
+    TempoAnalyser.h
+    Created: 21 Oct 2026 9:48:20am
+    Author:  Justin  Lim
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/**
+    Constant-tempo beat grid of a track: its tempo and where the first beat falls.
+*/
+struct BeatGrid
+{
+    /** Returns true if a tempo was found */
+    bool isValid() const;
+
+    /** Returns the length of one beat in seconds */
+    double getBeatLengthInSeconds() const;
+
+    /** Returns the (fractional) beat number at a position in the track, beat 0 being the first beat */
+    double getBeatAt (double seconds) const;
+
+    /** Returns the position in the track of a (fractional) beat number */
+    double getTimeOfBeat (double beat) const;
+
+    double bpm = 0.0;
+    double firstBeatSeconds = 0.0;
+};
+
+
+/**
+    Estimates the tempo and beat grid of a track from a stream of its audio.
+
+    Works on the track mixed to mono at about 11 kHz. Onsets are found with
+    the positive spectral flux of log-compressed 256 point spectra, a hop being
+    about 12 ms. The tempo is first estimated from the autocorrelation of the onset
+    envelope, weighted towards 120 BPM, then refined together with the beat phase
+    by the comb filter that lines up best with the onsets over the whole track.
+
+    Feed the track in order with process(), then call getBeatGrid().
+*/
+class TempoAnalyser
+{
+public:
+    TempoAnalyser (double analysisRate);
+
+    /** Adds the next block of the track, mixed to mono and decimated by an AnalysisDecimator */
+    void process (const float* samples, int numSamples);
+
+    /** Returns the beat grid of everything processed so far, invalid if no tempo was found */
+    BeatGrid getBeatGrid() const;
+
+private:
+    // Analyses the oldest fftSize decimated samples and drops a hop of them
+    void processFrame();
+
+    static constexpr int fftOrder = 8;
+    static constexpr int fftSize = 1 << fftOrder;
+    static constexpr int hopSize = fftSize / 2;
+
+    double analysisRate = 0.0;
+
+    std::vector<float> pendingSamples;
+    juce::dsp::FFT fft { fftOrder };
+    juce::dsp::WindowingFunction<float> window { fftSize, juce::dsp::WindowingFunction<float>::hann, false };
+    std::vector<float> fftData;
+    std::vector<float> previousSpectrum;
+
+    // Spectral flux, one value per hop
+    std::vector<float> onsetEnvelope;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TempoAnalyser)
+};
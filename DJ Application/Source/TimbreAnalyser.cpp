@@ -0,0 +1,150 @@
+/*
+  ==============================================================================
+
+    TimbreAnalyser.cpp
+    Created: 21 Oct 2026 6:20:14pm
+    Author:  Justin  Lim
+
+  ==============================================================================
+*/
+
+#include "TimbreAnalyser.h"
+
+namespace
+{
+    // Frequency range covered by the mel bands
+    constexpr double minFrequency = 60.0;
+    constexpr double maxFrequency = 5000.0;
+
+    // Frames quieter than this, summed over the bands, are skipped
+    constexpr float silentFrameEnergy = 1.0e-6f;
+
+    // Shortest track, in frames, that features are computed for
+    constexpr int minFrames = 20;
+
+    double hertzToMel (double hertz)    { return 2595.0 * std::log10 (1.0 + hertz / 700.0); }
+    double melToHertz (double mel)      { return 700.0 * (std::pow (10.0, mel / 2595.0) - 1.0); }
+}
+
+//==============================================================================
+// Lays out the triangular mel bands over the spectrum bins and the DCT that turns their log energies into coefficients
+TimbreAnalyser::TimbreAnalyser (double analysisRate)
+    : fftData (2 * fftSize, 0.0f),
+      dctBasis ((size_t) numCoefficients * numBands)
+{
+    frame.reserve (fftSize);
+
+    auto binWidth = analysisRate / fftSize;
+    auto topFrequency = juce::jmin (maxFrequency, analysisRate / 2.0);
+
+    // Band edges are evenly spaced in mels, each band rising from the previous edge and falling to the next
+    std::array<double, numBands + 2> edges;
+    auto minMel = hertzToMel (minFrequency);
+    auto maxMel = hertzToMel (topFrequency);
+
+    for (size_t i = 0; i < edges.size(); ++i)
+        edges[i] = melToHertz (minMel + (maxMel - minMel) * (double) i / (double) (edges.size() - 1));
+
+    for (size_t band = 0; band < (size_t) numBands; ++band)
+    {
+        MelBand melBand;
+        melBand.firstBin = juce::jmax (1, static_cast<int> (std::ceil (edges[band] / binWidth)));
+        auto lastBin = juce::jmin (fftSize / 2, static_cast<int> (std::floor (edges[band + 2] / binWidth)));
+
+        for (int bin = melBand.firstBin; bin <= lastBin; ++bin)
+        {
+            auto frequency = bin * binWidth;
+            auto weight = frequency < edges[band + 1] ? (frequency - edges[band]) / (edges[band + 1] - edges[band])
+                                                      : (edges[band + 2] - frequency) / (edges[band + 2] - edges[band + 1]);
+
+            melBand.weights.push_back (static_cast<float> (juce::jmax (0.0, weight)));
+        }
+
+        bands.push_back (std::move (melBand));
+    }
+
+    for (int coefficient = 0; coefficient < numCoefficients; ++coefficient)
+        for (int band = 0; band < numBands; ++band)
+            dctBasis[(size_t) (coefficient * numBands + band)]
+                = static_cast<float> (std::cos (juce::MathConstants<double>::pi * (coefficient + 1) * (band + 0.5) / numBands));
+}
+
+
+// Adds a block of decimated samples to the frame buffer
+void TimbreAnalyser::process (const float* samples, int numSamples)
+{
+    for (int i = 0; i < numSamples; ++i)
+    {
+        frame.push_back (samples[i]);
+
+        if (static_cast<int> (frame.size()) == fftSize)
+            processFrame();
+    }
+}
+
+
+// Adds the cepstral coefficients of the frame, frames do not overlap as only their statistics are kept
+void TimbreAnalyser::processFrame()
+{
+    std::fill (fftData.begin(), fftData.end(), 0.0f);
+    std::copy (frame.begin(), frame.end(), fftData.begin());
+    frame.clear();
+
+    window.multiplyWithWindowingTable (fftData.data(), fftSize);
+    fft.performFrequencyOnlyForwardTransform (fftData.data());
+
+    std::array<float, numBands> logEnergies;
+    float totalEnergy = 0.0f;
+
+    for (size_t band = 0; band < bands.size(); ++band)
+    {
+        float energy = 0.0f;
+        auto* magnitudes = fftData.data() + bands[band].firstBin;
+
+        for (size_t i = 0; i < bands[band].weights.size(); ++i)
+            energy += bands[band].weights[i] * magnitudes[i] * magnitudes[i];
+
+        totalEnergy += energy;
+        logEnergies[band] = std::log (energy + 1.0e-10f);
+    }
+
+    if (totalEnergy < silentFrameEnergy)
+        return;
+
+    for (size_t coefficient = 0; coefficient < (size_t) numCoefficients; ++coefficient)
+    {
+        auto* basis = dctBasis.data() + coefficient * numBands;
+        float value = 0.0f;
+
+        for (size_t band = 0; band < (size_t) numBands; ++band)
+            value += basis[band] * logEnergies[band];
+
+        sums[coefficient] += value;
+        squareSums[coefficient] += (double) value * value;
+    }
+
+    ++numFrames;
+}
+
+
+// Returns the mean of each coefficient followed by its standard deviation
+std::vector<float> TimbreAnalyser::getFeatures() const
+{
+    std::vector<float> features;
+
+    if (numFrames < minFrames)
+        return features;
+
+    features.resize ((size_t) numFeatures);
+
+    for (size_t coefficient = 0; coefficient < (size_t) numCoefficients; ++coefficient)
+    {
+        auto mean = sums[coefficient] / numFrames;
+        auto variance = juce::jmax (0.0, squareSums[coefficient] / numFrames - mean * mean);
+
+        features[coefficient] = static_cast<float> (mean);
+        features[coefficient + numCoefficients] = static_cast<float> (std::sqrt (variance));
+    }
+
+    return features;
+}
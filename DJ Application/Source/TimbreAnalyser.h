@@ -0,0 +1,71 @@
+/*
+  ==============================================================================
+
+    TimbreAnalyser.h
+    Created: 21 Oct 2026 6:20:14pm
+    Author:  Justin  Lim
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/**
+    Summarises the timbre of a track as a short feature vector for similarity search.
+
+    Works on the track mixed to mono at about 11 kHz. Every 512 samples,
+    about 46 ms, the power spectrum is reduced to 26 mel bands between 60 Hz and
+    5 kHz and turned into mel-frequency cepstral coefficients. The features are the
+    mean and standard deviation over the track of coefficients 1 to 12, so the
+    overall level (coefficient 0) does not count.
+
+    Feed the track in order with process(), then call getFeatures().
+*/
+class TimbreAnalyser
+{
+public:
+    /** Length of the feature vector */
+    static constexpr int numFeatures = 24;
+
+    TimbreAnalyser (double analysisRate);
+
+    /** Adds the next block of the track, mixed to mono and decimated by an AnalysisDecimator */
+    void process (const float* samples, int numSamples);
+
+    /** Returns the features of everything processed so far, empty if the track was too short or silent */
+    std::vector<float> getFeatures() const;
+
+private:
+    // Adds the coefficients of the frame in the frame buffer
+    void processFrame();
+
+    static constexpr int fftOrder = 9;
+    static constexpr int fftSize = 1 << fftOrder;
+    static constexpr int numBands = 26;
+    static constexpr int numCoefficients = numFeatures / 2;
+
+    struct MelBand
+    {
+        int firstBin = 0;
+        std::vector<float> weights;
+    };
+
+    std::vector<float> frame;
+    juce::dsp::FFT fft { fftOrder };
+    juce::dsp::WindowingFunction<float> window { fftSize, juce::dsp::WindowingFunction<float>::hann, false };
+    std::vector<float> fftData;
+
+    std::vector<MelBand> bands;
+
+    // DCT-II basis, coefficient by band
+    std::vector<float> dctBasis;
+
+    // Sums of each coefficient and its square over the frames
+    std::array<double, numCoefficients> sums {};
+    std::array<double, numCoefficients> squareSums {};
+    int numFrames = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TimbreAnalyser)
+};
@@ -0,0 +1,202 @@
+/*
+  ==============================================================================
+
+    TrackAnalysisPool.cpp
+    Created: 21 Oct 2026 11:20:05am
+    Author:  Justin  Lim
+
+  ==============================================================================
+*/
+
+#include "TrackAnalysisPool.h"
+
+//==============================================================================
+// Returns true if the analysis was made from the file an entry describes
+bool TrackAnalysis::matches (const LibraryEntry& entry) const
+{
+    return entry.file == file && entry.fileSize == fileSize && entry.modificationTime == modificationTime;
+}
+
+
+// Copies the results into a library entry and marks it as analysed
+void TrackAnalysis::applyTo (LibraryEntry& entry) const
+{
+    entry.bpm              = beatGrid.bpm;
+    entry.firstBeatSeconds = beatGrid.firstBeatSeconds;
+    entry.loudness         = loudness.integratedLoudness;
+    entry.truePeak         = loudness.truePeak;
+    entry.key              = key.index;
+    entry.timbre           = timbre;
+    entry.fingerprint      = fingerprint;
+    entry.analysisVersion  = TrackAnalysisPool::currentAnalysisVersion;
+}
+
+
+//==============================================================================
+TrackAnalysisPool::TrackAnalysisPool (juce::AudioFormatManager& formatManagerToUse) : formatManager (formatManagerToUse) {}
+
+TrackAnalysisPool::~TrackAnalysisPool()
+{
+    cancel();
+}
+
+
+// Returns true if an entry has not been analysed by the current version
+bool TrackAnalysisPool::needsAnalysis (const LibraryEntry& entry)
+{
+    return entry.analysisVersion < currentAnalysisVersion;
+}
+
+
+// Queues one job per file, tracks are long enough that each job is worth scheduling on its own
+// Watcher events, rescans and imports can ask for the same file again, it is only queued once
+void TrackAnalysisPool::analyse (const juce::Array<juce::File>& files)
+{
+    auto runId = currentRunId.load();
+
+    for (auto& file : files)
+    {
+        if (! queuedFiles.insert (file.getFullPathName()).second)
+            continue;
+
+        ++numFilesRemaining;
+        pool.addJob ([this, file, runId] { analyseFile (file, runId); });
+    }
+}
+
+
+// Drops every queued file and waits for running analyses to stop
+void TrackAnalysisPool::cancel()
+{
+    ++currentRunId;
+    pool.removeAllJobs (true, 10000);
+    cancelPendingUpdate();
+
+    numFilesRemaining = 0;
+    queuedFiles.clear();
+
+    const juce::ScopedLock sl (lock);
+    pendingResults.clear();
+}
+
+
+// Returns the number of queued files that have not been analysed yet
+int TrackAnalysisPool::getNumFilesRemaining() const
+{
+    return numFilesRemaining.load();
+}
+
+
+/*
+    Decodes a track once and feeds every block to each analyser.
+
+    Loudness is measured on the full-rate channels. The spectral analysers share
+    one mono stream at about 11 kHz, mixed and decimated once per block.
+
+    @param reader        Reader for the track.
+    @param result        Receives the analysis.
+    @param shouldAbort   Polled between blocks, analysis stops early when it returns true.
+
+    @return              False if the analysis was aborted or the track has no audio.
+*/
+bool TrackAnalysisPool::analyseTrack (juce::AudioFormatReader& reader, TrackAnalysis& result, std::function<bool()> shouldAbort)
+{
+    constexpr int blockSize = 1 << 16;
+
+    if (reader.sampleRate <= 0.0 || reader.lengthInSamples <= 0)
+        return false;
+
+    juce::AudioBuffer<float> buffer (reader.numChannels > 1 ? 2 : 1, blockSize);
+
+    AnalysisDecimator decimator (reader.sampleRate);
+    auto analysisRate = decimator.getAnalysisRate();
+
+    LoudnessAnalyser loudnessAnalyser (reader.sampleRate, buffer.getNumChannels());
+    TempoAnalyser tempoAnalyser (analysisRate);
+    KeyAnalyser keyAnalyser (analysisRate);
+    TimbreAnalyser timbreAnalyser (analysisRate);
+    FingerprintAnalyser fingerprintAnalyser (analysisRate);
+
+    for (juce::int64 pos = 0; pos < reader.lengthInSamples; pos += blockSize)
+    {
+        if (shouldAbort())
+            return false;
+
+        auto numToRead = static_cast<int> (juce::jmin<juce::int64> (blockSize, reader.lengthInSamples - pos));
+        reader.read (&buffer, 0, numToRead, pos, true, true);
+
+        loudnessAnalyser.process (buffer, numToRead);
+
+        auto& decimated = decimator.process (buffer, numToRead);
+        auto numDecimated = static_cast<int> (decimated.size());
+
+        tempoAnalyser.process (decimated.data(), numDecimated);
+        keyAnalyser.process (decimated.data(), numDecimated);
+        timbreAnalyser.process (decimated.data(), numDecimated);
+        fingerprintAnalyser.process (decimated.data(), numDecimated);
+    }
+
+    result.beatGrid = tempoAnalyser.getBeatGrid();
+    result.loudness = loudnessAnalyser.getMeasurement();
+    result.key = keyAnalyser.getKey();
+    result.timbre = timbreAnalyser.getFeatures();
+    result.fingerprint = fingerprintAnalyser.getFingerprint();
+    return true;
+}
+
+
+// Analyses one file on a worker thread
+void TrackAnalysisPool::analyseFile (const juce::File& file, int runId)
+{
+    if (runId != currentRunId.load())
+        return;
+
+    TrackAnalysis result;
+    result.file             = file;
+    result.fileSize         = file.getSize();
+    result.modificationTime = file.getLastModificationTime().toMilliseconds();
+
+    std::unique_ptr<juce::AudioFormatReader> reader (formatManager.createReaderFor (file));
+
+    // Unreadable tracks are still delivered, with an invalid beat grid, so they are not queued again
+    if (reader != nullptr)
+        analyseTrack (*reader, result, [this, runId] { return runId != currentRunId.load(); });
+
+    {
+        const juce::ScopedLock sl (lock);
+
+        if (runId != currentRunId.load())
+            return;
+
+        pendingResults.push_back (std::move (result));
+    }
+
+    triggerAsyncUpdate();
+}
+
+
+// Delivers everything that finished since the last update as one batch
+void TrackAnalysisPool::handleAsyncUpdate()
+{
+    std::vector<TrackAnalysis> results;
+
+    {
+        const juce::ScopedLock sl (lock);
+        results.swap (pendingResults);
+    }
+
+    // Several workers can trigger an update for results that were already delivered
+    if (results.empty())
+        return;
+
+    numFilesRemaining -= static_cast<int> (results.size());
+
+    for (auto& result : results)
+        queuedFiles.erase (result.file.getFullPathName());
+
+    if (onResultsReady != nullptr)
+        onResultsReady (results);
+
+    if (numFilesRemaining.load() <= 0 && onAnalysisFinished != nullptr)
+        onAnalysisFinished();
+}
@@ -0,0 +1,100 @@
+/*
+  ==============================================================================
+
+    TrackAnalysisPool.h
+    Created: 21 Oct 2026 11:20:05am
+    Author:  Justin  Lim
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "LibraryIndex.h"
+#include "TempoAnalyser.h"
+#include "LoudnessAnalyser.h"
+#include "KeyAnalyser.h"
+#include "TimbreAnalyser.h"
+#include "FingerprintAnalyser.h"
+#include "AnalysisDecimator.h"
+
+/** Results of analysing one library track */
+struct TrackAnalysis
+{
+    juce::File file;
+    juce::int64 fileSize = 0;           // size and modification time of the file that was analysed,
+    juce::int64 modificationTime = 0;   // so results for a file that has since changed can be dropped
+    BeatGrid beatGrid;
+    LoudnessMeasurement loudness;
+    MusicalKey key;
+    std::vector<float> timbre;
+    std::vector<juce::uint32> fingerprint;
+
+    /** Returns true if the analysis was made from the file an entry describes */
+    bool matches (const LibraryEntry& entry) const;
+
+    /** Copies the results into a library entry and marks it as analysed */
+    void applyTo (LibraryEntry& entry) const;
+};
+
+
+/**
+    Analyses library tracks on a pool of worker threads.
+
+    Each track is decoded once, in blocks that are fed to every analyser, so adding
+    an analysis does not add another decode. The pool leaves one core free for the
+    audio and message threads. Results are handed to onResultsReady on the message
+    thread, coalesced into batches.
+*/
+class TrackAnalysisPool : private juce::AsyncUpdater
+{
+public:
+    TrackAnalysisPool (juce::AudioFormatManager& formatManagerToUse);
+    ~TrackAnalysisPool() override;
+
+    /** Version of the analysis this pool produces, entries analysed by an older version need analysing again */
+    static constexpr int currentAnalysisVersion = 8;
+
+    /** Returns true if an entry has not been analysed by the current version */
+    static bool needsAnalysis (const LibraryEntry& entry);
+
+    /** Queues files for analysis, files that are already queued or being analysed are skipped */
+    void analyse (const juce::Array<juce::File>& files);
+
+    /** Drops every queued file and waits for running analyses to stop */
+    void cancel();
+
+    /** Returns the number of queued files that have not been analysed yet */
+    int getNumFilesRemaining() const;
+
+    /** Analyses a whole track on the calling thread, returns false if it was aborted or unreadable */
+    static bool analyseTrack (juce::AudioFormatReader& reader, TrackAnalysis& result, std::function<bool()> shouldAbort);
+
+    /** Called on the message thread with the tracks analysed since the last call */
+    std::function<void (std::vector<TrackAnalysis>& results)> onResultsReady;
+
+    /** Called on the message thread once the queue has been emptied */
+    std::function<void()> onAnalysisFinished;
+
+private:
+    void handleAsyncUpdate() override;
+
+    /** Analyses one file on a worker thread */
+    void analyseFile (const juce::File& file, int runId);
+
+    juce::AudioFormatManager& formatManager;
+    juce::ThreadPool pool { juce::jmax (1, juce::SystemStats::getNumCpus() - 1) };
+
+    // Results waiting to be delivered, guarded by lock
+    juce::CriticalSection lock;
+    std::vector<TrackAnalysis> pendingResults;
+
+    // Message thread only: files queued or being analysed, so repeated requests do not decode a file twice
+    std::unordered_set<juce::String> queuedFiles;
+
+    std::atomic<int> currentRunId { 0 };
+    std::atomic<int> numFilesRemaining { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TrackAnalysisPool)
+};
@@ -0,0 +1,256 @@
+/*
+  ==============================================================================
+
+    TrackPreloader.cpp
+    Created: 22 Oct 2026 10:04:18am
+    Author:  Justin  Lim
+
+  ==============================================================================
+*/
+
+#include "TrackPreloader.h"
+
+// Allocates the audio and counts it against the preloader's budget
+PreloadedTrack::PreloadedTrack (const juce::File& fileToUse, int numChannels, int numSamples, double rate,
+                                std::shared_ptr<std::atomic<size_t>> bytesInUseToUse)
+    : file (fileToUse),
+      sampleRate (rate),
+      audio (numChannels, numSamples),
+      bytesInUse (std::move (bytesInUseToUse))
+{
+    *bytesInUse += getSizeInBytes();
+}
+
+PreloadedTrack::~PreloadedTrack()
+{
+    *bytesInUse -= getSizeInBytes();
+}
+
+
+// Returns the memory taken by the decoded audio
+size_t PreloadedTrack::getSizeInBytes() const
+{
+    return (size_t) audio.getNumChannels() * (size_t) audio.getNumSamples() * sizeof (float);
+}
+
+
+// Decodes the audio from a reader in blocks, so a decode can be stopped part way through
+bool PreloadedTrack::readFrom (juce::AudioFormatReader& reader, std::function<bool()> shouldAbort)
+{
+    constexpr int blockSize = 1 << 16;
+
+    auto numSamples = audio.getNumSamples();
+
+    for (int pos = 0; pos < numSamples; pos += blockSize)
+    {
+        if (shouldAbort())
+            return false;
+
+        auto numToRead = juce::jmin (blockSize, numSamples - pos);
+        reader.read (&audio, pos, numToRead, pos, true, true);
+
+        // A mono track plays on both sides, as it does when the deck streams it from disk
+        if (reader.numChannels == 1 && audio.getNumChannels() > 1)
+            audio.copyFrom (1, pos, audio, 0, pos, numToRead);
+    }
+
+    return true;
+}
+
+
+//==============================================================================
+TrackPreloader::TrackPreloader (juce::AudioFormatManager& formatManagerToUse, size_t memoryBudgetInBytes)
+    : juce::Thread ("Track preloader"),
+      formatManager (formatManagerToUse),
+      memoryBudget (memoryBudgetInBytes)
+{
+    startThread();
+}
+
+TrackPreloader::~TrackPreloader()
+{
+    signalThreadShouldExit();
+    workAvailable.signal();
+    stopThread (10000);
+}
+
+
+// Set the most memory all decoded audio may take
+void TrackPreloader::setMemoryBudget (size_t newBudgetInBytes)
+{
+    const juce::ScopedLock sl (lock);
+
+    memoryBudget = newBudgetInBytes;
+    makeRoomFor (0);
+}
+
+
+// Returns the memory taken by decoded audio
+size_t TrackPreloader::getMemoryInUse() const
+{
+    return bytesInUse -> load();
+}
+
+
+// Queues a track to be decoded, or marks an already decoded track as the most recently requested
+void TrackPreloader::preload (const juce::File& file)
+{
+    const juce::ScopedLock sl (lock);
+
+    auto ready = std::find_if (readyTracks.begin(), readyTracks.end(), [&file] (auto& track) { return track -> file == file; });
+
+    if (ready != readyTracks.end())
+    {
+        std::rotate (ready, ready + 1, readyTracks.end());
+        return;
+    }
+
+    if (file == fileBeingDecoded)
+    {
+        currentDecodeDiscarded = false;
+        return;
+    }
+
+    queue.erase (std::remove (queue.begin(), queue.end(), file), queue.end());
+    queue.push_front (file);
+    workAvailable.signal();
+}
+
+
+// Returns a decoded track and stops holding it, the caller's reference keeps it counted against the budget
+std::shared_ptr<PreloadedTrack> TrackPreloader::take (const juce::File& file)
+{
+    const juce::ScopedLock sl (lock);
+
+    auto ready = std::find_if (readyTracks.begin(), readyTracks.end(), [&file] (auto& track) { return track -> file == file; });
+
+    if (ready == readyTracks.end())
+        return nullptr;
+
+    auto track = std::move (*ready);
+    readyTracks.erase (ready);
+    return track;
+}
+
+
+// Drops a track whether it is queued or decoded, a track being decoded is dropped once it is done
+void TrackPreloader::discard (const juce::File& file)
+{
+    const juce::ScopedLock sl (lock);
+
+    queue.erase (std::remove (queue.begin(), queue.end(), file), queue.end());
+
+    if (file == fileBeingDecoded)
+        currentDecodeDiscarded = true;
+
+    readyTracks.erase (std::remove_if (readyTracks.begin(), readyTracks.end(), [&file] (auto& track) { return track -> file == file; }),
+                       readyTracks.end());
+}
+
+
+// Decodes queued files, most recently requested first
+void TrackPreloader::run()
+{
+    while (! threadShouldExit())
+    {
+        juce::File file;
+
+        {
+            const juce::ScopedLock sl (lock);
+
+            if (! queue.empty())
+            {
+                file = queue.front();
+                queue.pop_front();
+                fileBeingDecoded = file;
+                currentDecodeDiscarded = false;
+            }
+        }
+
+        if (file == juce::File())
+        {
+            workAvailable.wait (-1);
+            continue;
+        }
+
+        auto shouldAbort = [this] { return threadShouldExit() || currentDecodeDiscarded.load(); };
+        auto track = decode (file, shouldAbort);
+
+        // The waveform is summarised here too, so loading the track does not make the display read or scan it
+        if (track != nullptr)
+        {
+            auto cacheFile = WaveformAnalyser::getCacheFileFor (file);
+            auto waveform = WaveformData::readFromFile (cacheFile);
+
+            if (waveform == nullptr)
+            {
+                waveform = WaveformAnalyser::computeWaveformData (track -> audio, track -> sampleRate, shouldAbort);
+
+                if (waveform != nullptr)
+                    waveform -> writeToFile (cacheFile);
+            }
+
+            track -> waveformData = waveform;
+        }
+
+        const juce::ScopedLock sl (lock);
+        fileBeingDecoded = juce::File();
+
+        // A track discarded while it was decoded is not kept
+        if (track != nullptr && ! currentDecodeDiscarded)
+            readyTracks.push_back (std::move (track));
+    }
+}
+
+
+/*
+    Decodes a whole file into memory.
+
+    Room is made in the budget before the audio is allocated, so the budget holds
+    even while a track is being decoded. Called by the preloader's own thread and
+    by other threads that need a whole track in memory.
+
+    @param file          The file to decode.
+    @param shouldAbort   Polled before the audio is allocated and between blocks.
+
+    @return              The decoded track, or nullptr if it is unreadable, does not fit or was aborted.
+*/
+std::shared_ptr<PreloadedTrack> TrackPreloader::decode (const juce::File& file, std::function<bool()> shouldAbort)
+{
+    std::unique_ptr<juce::AudioFormatReader> reader (formatManager.createReaderFor (file));
+
+    if (reader == nullptr || reader -> lengthInSamples <= 0 || reader -> lengthInSamples > std::numeric_limits<int>::max())
+        return nullptr;
+
+    // Decks play stereo, so mono tracks are decoded into both channels
+    constexpr int numChannels = 2;
+    auto numSamples = static_cast<int> (reader -> lengthInSamples);
+    auto sizeInBytes = (size_t) numChannels * (size_t) numSamples * sizeof (float);
+
+    std::shared_ptr<PreloadedTrack> track;
+
+    {
+        const juce::ScopedLock sl (lock);
+
+        if (shouldAbort() || ! makeRoomFor (sizeInBytes))
+            return nullptr;
+
+        track = std::make_shared<PreloadedTrack> (file, numChannels, numSamples, reader -> sampleRate, bytesInUse);
+    }
+
+    if (! track -> readFrom (*reader, shouldAbort))
+        return nullptr;
+
+    return track;
+}
+
+
+// Drops waiting tracks, least recently requested first, until a track of the given size fits in the budget
+// Tracks held by decks cannot be dropped, so this fails if they alone leave too little room
+bool TrackPreloader::makeRoomFor (size_t sizeInBytes)
+{
+    while (getMemoryInUse() + sizeInBytes > memoryBudget && ! readyTracks.empty())
+        readyTracks.erase (readyTracks.begin());
+
+    return getMemoryInUse() + sizeInBytes <= memoryBudget;
+}
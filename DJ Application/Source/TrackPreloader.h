@@ -0,0 +1,106 @@
+/*
+  ==============================================================================
+
+    TrackPreloader.h
+    Created: 22 Oct 2026 10:04:18am
+    Author:  Justin  Lim
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "WaveformAnalyser.h"
+
+/**
+    A whole track decoded into memory, ready to be swapped onto a deck.
+
+    The decoded audio counts against the budget of the preloader that made it for
+    as long as anything holds on to it, including a deck that is playing it.
+*/
+struct PreloadedTrack
+{
+    PreloadedTrack (const juce::File& file, int numChannels, int numSamples, double sampleRate,
+                    std::shared_ptr<std::atomic<size_t>> bytesInUse);
+    ~PreloadedTrack();
+
+    /** Returns the memory taken by the decoded audio */
+    size_t getSizeInBytes() const;
+
+    /** Decodes the audio from a reader in blocks, returns false if shouldAbort stopped it first */
+    bool readFrom (juce::AudioFormatReader& reader, std::function<bool()> shouldAbort);
+
+    const juce::File file;
+    const double sampleRate;
+    juce::AudioBuffer<float> audio;
+
+    /** Waveform summary for the deck's display, filled in by the preloader's thread and left empty by decode() */
+    std::shared_ptr<const WaveformData> waveformData;
+
+private:
+    std::shared_ptr<std::atomic<size_t>> bytesInUse;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PreloadedTrack)
+};
+
+
+/**
+    Decodes queued tracks into memory on a background thread.
+
+    A deck can then swap a preloaded track in without opening or decoding the
+    file. All decoded audio shares one memory budget: tracks that are waiting are
+    dropped least recently requested first to make room, and a track that would
+    still not fit is left to be loaded from disk as usual. Tracks decoded straight
+    away with decode(), such as the automixer's, count against the same budget.
+*/
+class TrackPreloader : private juce::Thread
+{
+public:
+    TrackPreloader (juce::AudioFormatManager& formatManagerToUse, size_t memoryBudgetInBytes);
+    ~TrackPreloader() override;
+
+    /** Set the most memory all decoded audio may take, dropping waiting tracks if it is now over */
+    void setMemoryBudget (size_t newBudgetInBytes);
+
+    /** Returns the memory taken by decoded audio, including tracks that have been taken by decks */
+    size_t getMemoryInUse() const;
+
+    /** Queues a track to be decoded, a track that is already decoded or queued is moved to the front */
+    void preload (const juce::File& file);
+
+    /** Returns a decoded track and stops holding it, or nullptr if it is not ready */
+    std::shared_ptr<PreloadedTrack> take (const juce::File& file);
+
+    /** Drops a track whether it is queued or decoded */
+    void discard (const juce::File& file);
+
+    /** Decodes a file on the calling thread within the budget, returns nullptr if it is unreadable, does not fit or shouldAbort stopped it */
+    std::shared_ptr<PreloadedTrack> decode (const juce::File& file, std::function<bool()> shouldAbort);
+
+private:
+    void run() override;
+
+    // Drops waiting tracks, least recently requested first, until a track of the given size fits
+    bool makeRoomFor (size_t sizeInBytes);
+
+    juce::AudioFormatManager& formatManager;
+
+    // Guards the queue, the decoded tracks and the budget
+    juce::CriticalSection lock;
+    juce::WaitableEvent workAvailable;
+
+    std::deque<juce::File> queue;
+    juce::File fileBeingDecoded;
+
+    // Set when the track being decoded is discarded, so the decode can stop early
+    std::atomic<bool> currentDecodeDiscarded { false };
+
+    // Decoded tracks waiting to be taken, most recently requested last
+    std::vector<std::shared_ptr<PreloadedTrack>> readyTracks;
+
+    size_t memoryBudget;
+    std::shared_ptr<std::atomic<size_t>> bytesInUse { std::make_shared<std::atomic<size_t>> (0) };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TrackPreloader)
+};
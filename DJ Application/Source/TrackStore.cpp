@@ -0,0 +1,409 @@
+/*
+  ==============================================================================
+
+    TrackStore.cpp
+    Created: 20 Oct 2026 5:41:03pm
+    Author:  Justin  Lim
+
+  ==============================================================================
+*/
+
+#include "TrackStore.h"
+
+//==============================================================================
+// Returns the id of a string, copying it into the arena if it has not been seen before
+TrackStore::StringArena::StringId TrackStore::StringArena::intern (const juce::String& text)
+{
+    auto existing = find (text);
+
+    if (existing != invalidString)
+        return existing;
+
+    auto numBytes = text.getNumBytesAsUTF8();
+
+    // Strings longer than a block get a block of their own
+    if (blocks.empty() || usedInLastBlock + numBytes > blockSize)
+    {
+        blocks.push_back (std::make_unique<char[]> (juce::jmax (blockSize, numBytes)));
+        usedInLastBlock = 0;
+    }
+
+    auto* destination = blocks.back().get() + usedInLastBlock;
+    std::memcpy (destination, text.toRawUTF8(), numBytes);
+    usedInLastBlock += numBytes;
+
+    // An oversized block is full, the next string starts a new one
+    if (numBytes > blockSize)
+        usedInLastBlock = blockSize;
+
+    auto id = static_cast<StringId> (strings.size());
+    strings.emplace_back (destination, numBytes);
+    lookup.emplace (strings.back(), id);
+
+    return id;
+}
+
+
+// Returns the id of a string, or invalidString if it has never been interned
+TrackStore::StringArena::StringId TrackStore::StringArena::find (const juce::String& text) const
+{
+    auto found = lookup.find (std::string_view (text.toRawUTF8(), text.getNumBytesAsUTF8()));
+    return found != lookup.end() ? found -> second : invalidString;
+}
+
+
+// Returns a copy of an interned string
+juce::String TrackStore::StringArena::get (StringId id) const
+{
+    auto text = strings[(size_t) id];
+    return juce::String::fromUTF8 (text.data(), static_cast<int> (text.size()));
+}
+
+
+// Returns the bytes of an interned string without copying them
+std::string_view TrackStore::StringArena::getView (StringId id) const
+{
+    return strings[(size_t) id];
+}
+
+
+void TrackStore::StringArena::clear()
+{
+    blocks.clear();
+    usedInLastBlock = blockSize;
+    strings.clear();
+    lookup.clear();
+}
+
+
+//==============================================================================
+// Adds a song to the end of every column
+TrackStore::TrackId TrackStore::add (const LibraryEntry& entry)
+{
+    auto id = static_cast<TrackId> (slotOfId.size());
+    auto path = strings.intern (entry.file.getFullPathName());
+
+    slotOfId.push_back (static_cast<juce::uint32> (ids.size()));
+    idOfPath[path] = id;
+
+    ids.push_back     (id);
+    paths.push_back   (path);
+    titles.push_back  (strings.intern (entry.title));
+    artists.push_back (strings.intern (entry.artist));
+    albums.push_back  (strings.intern (entry.album));
+    lengths.push_back (static_cast<float> (entry.lengthInSeconds));
+    datesAdded.push_back (entry.dateAdded);
+    bpms.push_back (static_cast<float> (entry.bpm));
+    keys.push_back (static_cast<juce::int8> (entry.key));
+    titleKeys.push_back (strings.intern (makeCollationKey (entry.title)));
+
+    return id;
+}
+
+
+// Replaces the metadata of a song, including its file when it has been moved
+void TrackStore::update (TrackId id, const LibraryEntry& entry)
+{
+    auto slot = getSlot (id);
+    auto path = strings.intern (entry.file.getFullPathName());
+
+    if (path != paths[slot])
+    {
+        idOfPath.erase (paths[slot]);
+        idOfPath[path] = id;
+        paths[slot] = path;
+    }
+
+    titles[slot]  = strings.intern (entry.title);
+    artists[slot] = strings.intern (entry.artist);
+    albums[slot]  = strings.intern (entry.album);
+    lengths[slot] = static_cast<float> (entry.lengthInSeconds);
+    datesAdded[slot] = entry.dateAdded;
+    bpms[slot] = static_cast<float> (entry.bpm);
+    keys[slot] = static_cast<juce::int8> (entry.key);
+    titleKeys[slot] = strings.intern (makeCollationKey (entry.title));
+}
+
+
+// Removes a song by moving the last song into its slot
+void TrackStore::remove (TrackId id)
+{
+    if (! contains (id))
+        return;
+
+    auto slot = getSlot (id);
+    auto last = ids.size() - 1;
+
+    idOfPath.erase (paths[slot]);
+
+    if (slot != last)
+    {
+        ids[slot]     = ids[last];
+        paths[slot]   = paths[last];
+        titles[slot]  = titles[last];
+        artists[slot] = artists[last];
+        albums[slot]  = albums[last];
+        lengths[slot] = lengths[last];
+        datesAdded[slot] = datesAdded[last];
+        bpms[slot] = bpms[last];
+        keys[slot] = keys[last];
+        titleKeys[slot] = titleKeys[last];
+
+        slotOfId[ids[slot]] = static_cast<juce::uint32> (slot);
+    }
+
+    ids.pop_back();
+    paths.pop_back();
+    titles.pop_back();
+    artists.pop_back();
+    albums.pop_back();
+    lengths.pop_back();
+    datesAdded.pop_back();
+    bpms.pop_back();
+    keys.pop_back();
+    titleKeys.pop_back();
+
+    slotOfId[id] = emptySlot;
+}
+
+
+// Removes every song, ids carry on from where they were
+void TrackStore::clear()
+{
+    for (auto id : ids)
+        slotOfId[id] = emptySlot;
+
+    ids.clear();
+    paths.clear();
+    titles.clear();
+    artists.clear();
+    albums.clear();
+    lengths.clear();
+    datesAdded.clear();
+    bpms.clear();
+    keys.clear();
+    titleKeys.clear();
+
+    idOfPath.clear();
+    strings.clear();
+}
+
+
+// Returns true if the id belongs to a song in the store
+bool TrackStore::contains (TrackId id) const
+{
+    return id < slotOfId.size() && slotOfId[id] != emptySlot;
+}
+
+
+// Returns the id of the song with a file, or invalidId
+TrackStore::TrackId TrackStore::find (const juce::File& file) const
+{
+    auto path = strings.find (file.getFullPathName());
+
+    if (path == StringArena::invalidString)
+        return invalidId;
+
+    auto found = idOfPath.find (path);
+    return found != idOfPath.end() ? found -> second : invalidId;
+}
+
+
+// Returns the number of songs
+int TrackStore::size() const
+{
+    return static_cast<int> (ids.size());
+}
+
+
+// Returns one more than the highest id handed out so far
+TrackStore::TrackId TrackStore::getIdLimit() const
+{
+    return static_cast<TrackId> (slotOfId.size());
+}
+
+
+// Returns the ids of every song, in no particular order
+const std::vector<TrackStore::TrackId>& TrackStore::getIds() const
+{
+    return ids;
+}
+
+
+juce::File TrackStore::getFile (TrackId id) const
+{
+    return juce::File (strings.get (paths[getSlot (id)]));
+}
+
+
+juce::String TrackStore::getTitle (TrackId id) const
+{
+    return strings.get (titles[getSlot (id)]);
+}
+
+
+juce::String TrackStore::getArtist (TrackId id) const
+{
+    return strings.get (artists[getSlot (id)]);
+}
+
+
+juce::String TrackStore::getAlbum (TrackId id) const
+{
+    return strings.get (albums[getSlot (id)]);
+}
+
+
+double TrackStore::getLengthInSeconds (TrackId id) const
+{
+    return lengths[getSlot (id)];
+}
+
+
+juce::Time TrackStore::getDateAdded (TrackId id) const
+{
+    return juce::Time (datesAdded[getSlot (id)]);
+}
+
+
+double TrackStore::getBpm (TrackId id) const
+{
+    return bpms[getSlot (id)];
+}
+
+
+MusicalKey TrackStore::getKey (TrackId id) const
+{
+    MusicalKey key;
+    key.index = keys[getSlot (id)];
+    return key;
+}
+
+
+/*
+    Sorts ids by one or more keys.
+
+    The ids are turned into column slots once, so the comparisons read the
+    columns directly. Only the list of ids is permuted, the columns never move.
+
+    @param idsToSort   Ids of songs in the store, sorted in place.
+    @param sortKeys    Sort keys, primary first.
+*/
+void TrackStore::sort (std::vector<TrackId>& idsToSort, const std::vector<SortKey>& sortKeys) const
+{
+    if (sortKeys.empty())
+        return;
+
+    std::vector<juce::uint32> slots;
+    slots.reserve (idsToSort.size());
+
+    for (auto id : idsToSort)
+        slots.push_back (static_cast<juce::uint32> (getSlot (id)));
+
+    std::stable_sort (slots.begin(), slots.end(), [this, &sortKeys] (juce::uint32 first, juce::uint32 second)
+    {
+        return compareSlots (first, second, sortKeys) < 0;
+    });
+
+    for (size_t i = 0; i < slots.size(); ++i)
+        idsToSort[i] = ids[slots[i]];
+}
+
+
+// Returns true if one song sorts before another
+bool TrackStore::isBefore (TrackId first, TrackId second, const std::vector<SortKey>& sortKeys) const
+{
+    return compareSlots (getSlot (first), getSlot (second), sortKeys) < 0;
+}
+
+
+// Lower cases a title, drops leading punctuation and pads runs of digits so "Track 2" sorts before "Track 10"
+juce::String TrackStore::makeCollationKey (const juce::String& title)
+{
+    constexpr int digitRunWidth = 10;
+
+    auto text = title.toLowerCase().trimStart();
+    juce::String key;
+    key.preallocateBytes (text.getNumBytesAsUTF8() + 16);
+
+    auto p = text.getCharPointer();
+
+    while (! p.isEmpty() && ! juce::CharacterFunctions::isLetterOrDigit (*p))
+        ++p;
+
+    while (! p.isEmpty())
+    {
+        if (juce::CharacterFunctions::isDigit (*p))
+        {
+            juce::String digits;
+
+            while (juce::CharacterFunctions::isDigit (*p))
+                digits += *p++;
+
+            key += digits.paddedLeft ('0', digitRunWidth);
+        }
+        else
+        {
+            key += *p++;
+        }
+    }
+
+    return key;
+}
+
+
+// Returns the column index of a song
+size_t TrackStore::getSlot (TrackId id) const
+{
+    jassert (contains (id));
+    return slotOfId[id];
+}
+
+
+// Compares two songs key by key, the first key that differs decides
+int TrackStore::compareSlots (size_t first, size_t second, const std::vector<SortKey>& sortKeys) const
+{
+    for (auto& sortKey : sortKeys)
+    {
+        int result = 0;
+
+        switch (sortKey.column)
+        {
+            case SortColumn::title:
+                result = strings.getView (titleKeys[first]).compare (strings.getView (titleKeys[second]));
+                break;
+
+            case SortColumn::duration:
+                result = (lengths[first] > lengths[second]) - (lengths[first] < lengths[second]);
+                break;
+
+            case SortColumn::dateAdded:
+                result = (datesAdded[first] > datesAdded[second]) - (datesAdded[first] < datesAdded[second]);
+                break;
+
+            case SortColumn::bpm:
+                result = (bpms[first] > bpms[second]) - (bpms[first] < bpms[second]);
+                break;
+
+            case SortColumn::key:
+            {
+                // Round the Camelot wheel, 1A 1B 2A 2B ..., unknown keys first
+                auto wheelPosition = [this] (size_t slot)
+                {
+                    MusicalKey key;
+                    key.index = keys[slot];
+                    return key.isValid() ? key.getCamelotNumber() * 2 + (key.isMinor() ? 0 : 1) : -1;
+                };
+
+                auto a = wheelPosition (first), b = wheelPosition (second);
+                result = (a > b) - (a < b);
+                break;
+            }
+        }
+
+        if (result != 0)
+            return sortKey.ascending ? result : -result;
+    }
+
+    return 0;
+}
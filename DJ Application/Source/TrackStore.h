@@ -0,0 +1,169 @@
+/*
+  ==============================================================================
+
+    TrackStore.h
+    Created: 20 Oct 2026 5:41:03pm
+    Author:  Justin  Lim
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "LibraryIndex.h"
+#include "KeyAnalyser.h"
+
+/**
+    The songs listed in the library, stored column by column.
+
+    Every song gets a 32-bit id that stays valid until the song is removed and is
+    never handed out again, so views, sorting and searching can all hold ids
+    instead of row numbers. Columns are dense arrays and a removal moves the last
+    song into the freed slot, so lookups and removals are O(1).
+
+    Paths, titles, artists and albums are interned into a contiguous arena, so a
+    string shared by many songs (an artist or album) is stored once.
+
+    Sort keys are computed when a song is added or updated, so sorting compares
+    integers and pre-folded strings and only ever permutes a list of ids.
+*/
+class TrackStore
+{
+public:
+    using TrackId = juce::uint32;
+
+    /** Returned by find() when no song has the file */
+    static constexpr TrackId invalidId = 0xffffffff;
+
+    /** Columns the library can be sorted by */
+    enum class SortColumn
+    {
+        title,
+        duration,
+        dateAdded,
+        bpm,
+        key
+    };
+
+    /** One level of a multi-key sort, the first key in a list is the primary one */
+    struct SortKey
+    {
+        SortColumn column = SortColumn::title;
+        bool ascending = true;
+    };
+
+    TrackStore() = default;
+
+    /** Adds a song and returns its id */
+    TrackId add (const LibraryEntry& entry);
+
+    /** Replaces the metadata of a song, including its file when it has been moved */
+    void update (TrackId id, const LibraryEntry& entry);
+
+    /** Removes a song, its id is never reused */
+    void remove (TrackId id);
+
+    /** Removes every song */
+    void clear();
+
+    /** Returns true if the id belongs to a song in the store */
+    bool contains (TrackId id) const;
+
+    /** Returns the id of the song with a file, or invalidId */
+    TrackId find (const juce::File& file) const;
+
+    /** Returns the number of songs */
+    int size() const;
+
+    /** Returns one more than the highest id handed out so far, for arrays indexed by id */
+    TrackId getIdLimit() const;
+
+    /** Returns the ids of every song, in no particular order */
+    const std::vector<TrackId>& getIds() const;
+
+    juce::File   getFile (TrackId id) const;
+    juce::String getTitle (TrackId id) const;
+    juce::String getArtist (TrackId id) const;
+    juce::String getAlbum (TrackId id) const;
+    double       getLengthInSeconds (TrackId id) const;
+    juce::Time   getDateAdded (TrackId id) const;
+    double       getBpm (TrackId id) const;
+    MusicalKey   getKey (TrackId id) const;
+
+    /** Reorders a list of ids by a list of sort keys, keeping the order of songs that compare equal */
+    void sort (std::vector<TrackId>& idsToSort, const std::vector<SortKey>& sortKeys) const;
+
+    /** Returns true if one song sorts before another */
+    bool isBefore (TrackId first, TrackId second, const std::vector<SortKey>& sortKeys) const;
+
+    /** Folds a title into a key that sorts case-insensitively, with numbers in numeric order */
+    static juce::String makeCollationKey (const juce::String& title);
+
+private:
+    /**
+        Append-only storage for interned UTF-8 strings.
+
+        Strings live in fixed-size blocks that are never moved, so the views kept
+        in the lookup table stay valid as the arena grows.
+    */
+    class StringArena
+    {
+    public:
+        using StringId = juce::uint32;
+
+        /** Returns the id of a string, storing it if it has not been seen before */
+        StringId intern (const juce::String& text);
+
+        /** Returns the id of a string, or invalidString if it has never been interned */
+        StringId find (const juce::String& text) const;
+
+        /** Returns a copy of an interned string */
+        juce::String get (StringId id) const;
+
+        /** Returns the bytes of an interned string without copying them */
+        std::string_view getView (StringId id) const;
+
+        void clear();
+
+        static constexpr StringId invalidString = 0xffffffff;
+
+    private:
+        static constexpr size_t blockSize = 64 * 1024;
+
+        std::vector<std::unique_ptr<char[]>> blocks;
+        size_t usedInLastBlock = blockSize;
+        std::vector<std::string_view> strings;
+        std::unordered_map<std::string_view, StringId> lookup;
+    };
+
+    using StringId = StringArena::StringId;
+
+    // Returns the column index of a song
+    size_t getSlot (TrackId id) const;
+
+    // Returns a negative, zero or positive value as the song in one slot sorts before, with or after another
+    int compareSlots (size_t first, size_t second, const std::vector<SortKey>& sortKeys) const;
+
+    StringArena strings;
+
+    // Columns, one element per song
+    std::vector<TrackId> ids;
+    std::vector<StringId> paths;
+    std::vector<StringId> titles;
+    std::vector<StringId> artists;
+    std::vector<StringId> albums;
+    std::vector<float> lengths;
+    std::vector<juce::int64> datesAdded;
+    std::vector<float> bpms;
+    std::vector<juce::int8> keys;
+    std::vector<StringId> titleKeys;
+
+    // Column index of each id ever handed out, emptySlot once removed
+    static constexpr juce::uint32 emptySlot = 0xffffffff;
+    std::vector<juce::uint32> slotOfId;
+
+    std::unordered_map<StringId, TrackId> idOfPath;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TrackStore)
+};
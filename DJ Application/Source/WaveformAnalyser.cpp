@@ -0,0 +1,385 @@
+/*
+  ==============================================================================
+
+    WaveformAnalyser.cpp
+    Created: 19 Oct 2026 4:02:11pm
+    Author:  Justin  Lim
+
+  ==============================================================================
+*/
+
+#include "WaveformAnalyser.h"
+
+namespace
+{
+    // Identifies a waveform cache file and its layout version
+    constexpr int cacheFileMagic = 0x3146574f; // "OWF1"
+
+    // Crossover frequencies between the low/mid and mid/high bands
+    constexpr double lowMidCrossoverHz  = 200.0;
+    constexpr double midHighCrossoverHz = 2500.0;
+
+    static_assert (sizeof (WaveformData::Bin) == 4, "WaveformData::Bin must stay tightly packed");
+
+    // Scales a set of values so the largest maps to 255
+    template <typename Setter>
+    void quantise (const std::vector<float>& values, Setter setter)
+    {
+        auto maxValue = values.empty() ? 0.0f : *std::max_element (values.begin(), values.end());
+        auto scale = maxValue > 0.0f ? 255.0f / maxValue : 0.0f;
+
+        for (size_t i = 0; i < values.size(); ++i)
+            setter (i, static_cast<juce::uint8> (juce::jlimit (0, 255, juce::roundToInt (values[i] * scale))));
+    }
+}
+
+//==============================================================================
+// Returns the number of bins per second of audio
+double WaveformData::getBinsPerSecond() const
+{
+    return sampleRate / samplesPerBin;
+}
+
+
+// Returns the length of the analysed track in seconds
+double WaveformData::getLengthInSeconds() const
+{
+    return sampleRate > 0.0 ? static_cast<double> (lengthInSamples) / sampleRate : 0.0;
+}
+
+
+// Combines a range of bins into one bin holding the maximum of each field
+WaveformData::Bin WaveformData::getMaximum (int firstBin, int lastBin) const
+{
+    Bin result;
+
+    firstBin = juce::jlimit (0, static_cast<int> (bins.size()), firstBin);
+    lastBin  = juce::jlimit (firstBin, static_cast<int> (bins.size()), lastBin);
+
+    for (int i = firstBin; i < lastBin; ++i)
+    {
+        auto& bin = bins[(size_t) i];
+        result.peak = juce::jmax (result.peak, bin.peak);
+        result.low  = juce::jmax (result.low,  bin.low);
+        result.mid  = juce::jmax (result.mid,  bin.mid);
+        result.high = juce::jmax (result.high, bin.high);
+    }
+
+    return result;
+}
+
+
+// Scales the band mix so its strongest component is at full brightness
+juce::Colour WaveformData::getColourFor (const Bin& bin)
+{
+    auto strongest = static_cast<float> (juce::jmax (1, (int) bin.low, (int) bin.mid, (int) bin.high));
+
+    return juce::Colour::fromFloatRGBA (bin.low / strongest, bin.mid / strongest, bin.high / strongest, 1.0f);
+}
+
+
+// Writes the data to a binary cache file
+bool WaveformData::writeToFile (const juce::File& file) const
+{
+    file.getParentDirectory().createDirectory();
+
+    juce::FileOutputStream out (file);
+
+    if (! out.openedOk())
+        return false;
+
+    out.setPosition (0);
+    out.truncate();
+
+    out.writeInt    (cacheFileMagic);
+    out.writeDouble (sampleRate);
+    out.writeInt64  (lengthInSamples);
+    out.writeInt    (static_cast<int> (bins.size()));
+
+    return out.write (bins.data(), bins.size() * sizeof (Bin));
+}
+
+
+// Reads the data back from a binary cache file
+std::shared_ptr<WaveformData> WaveformData::readFromFile (const juce::File& file)
+{
+    juce::FileInputStream in (file);
+
+    if (! in.openedOk() || in.readInt() != cacheFileMagic)
+        return nullptr;
+
+    auto data = std::make_shared<WaveformData>();
+    data->sampleRate      = in.readDouble();
+    data->lengthInSamples = in.readInt64();
+
+    auto numBins = in.readInt();
+    auto expectedBins = (data->lengthInSamples + samplesPerBin - 1) / samplesPerBin;
+
+    if (data->sampleRate <= 0.0 || numBins <= 0 || numBins != expectedBins)
+        return nullptr;
+
+    data->bins.resize (static_cast<size_t> (numBins));
+    auto numBytes = static_cast<int> (data->bins.size() * sizeof (Bin));
+
+    if (in.read (data->bins.data(), numBytes) != numBytes)
+        return nullptr;
+
+    return data;
+}
+
+
+//==============================================================================
+WaveformAnalyser::WaveformAnalyser (juce::AudioFormatManager& formatManagerToUse)
+    : juce::Thread ("Waveform analyser"),
+      formatManager (formatManagerToUse)
+{
+    startThread();
+}
+
+WaveformAnalyser::~WaveformAnalyser()
+{
+    cancel();
+    stopThread (4000);
+}
+
+
+// Queues a file for analysis, replacing any request that has not finished yet
+void WaveformAnalyser::analyse (const juce::File& audioFile, Callback onComplete)
+{
+    {
+        const juce::ScopedLock sl (lock);
+        pendingFile = audioFile;
+        pendingCallback = std::move (onComplete);
+        ++latestRequestId;
+    }
+
+    notify();
+}
+
+
+// Drops any pending or running request without calling its callback
+void WaveformAnalyser::cancel()
+{
+    const juce::ScopedLock sl (lock);
+    pendingFile = juce::File();
+    pendingCallback = nullptr;
+    handledRequestId = ++latestRequestId;
+}
+
+
+// Returns the cache file used to persist the analysis of an audio file
+juce::File WaveformAnalyser::getCacheFileFor (const juce::File& audioFile)
+{
+    // The key changes whenever the file is replaced or edited, so a stale cache is never used
+    auto key = audioFile.getFullPathName()
+             + juce::String (audioFile.getSize())
+             + juce::String (audioFile.getLastModificationTime().toMilliseconds());
+
+    return juce::File::getSpecialLocation (juce::File::userApplicationDataDirectory)
+               .getChildFile ("OtoDecks")
+               .getChildFile ("waveforms")
+               .getChildFile (juce::String::toHexString (key.hashCode64()) + ".wfm");
+}
+
+
+// Returns true if a newer request has been made since the given one was started
+bool WaveformAnalyser::isSuperseded (int requestId)
+{
+    const juce::ScopedLock sl (lock);
+    return requestId != latestRequestId;
+}
+
+
+// Background loop that serves the most recent request
+void WaveformAnalyser::run()
+{
+    while (! threadShouldExit())
+    {
+        juce::File file;
+        Callback callback;
+        int requestId = 0;
+
+        {
+            const juce::ScopedLock sl (lock);
+
+            if (handledRequestId != latestRequestId)
+            {
+                file = pendingFile;
+                callback = pendingCallback;
+                requestId = handledRequestId = latestRequestId;
+            }
+        }
+
+        if (callback == nullptr)
+        {
+            wait (-1);
+            continue;
+        }
+
+        auto cacheFile = getCacheFileFor (file);
+        auto data = WaveformData::readFromFile (cacheFile);
+
+        if (data == nullptr)
+        {
+            std::unique_ptr<juce::AudioFormatReader> reader (formatManager.createReaderFor (file));
+
+            if (reader != nullptr)
+            {
+                data = computeWaveformData (*reader, [this, requestId]
+                {
+                    return threadShouldExit() || isSuperseded (requestId);
+                });
+
+                if (data != nullptr)
+                    data->writeToFile (cacheFile);
+            }
+        }
+
+        if (threadShouldExit() || isSuperseded (requestId))
+            continue;
+
+        std::shared_ptr<const WaveformData> result (data);
+        juce::MessageManager::callAsync ([callback, result] { callback (result); });
+    }
+}
+
+
+// Computes the waveform summary of a track read from a file
+std::shared_ptr<WaveformData> WaveformAnalyser::computeWaveformData (juce::AudioFormatReader& reader,
+                                                                      std::function<bool()> shouldAbort)
+{
+    auto numChannels = reader.numChannels > 1 ? 2 : 1;
+
+    return computeWaveformData (reader.sampleRate, reader.lengthInSamples, numChannels,
+                                [&reader] (juce::AudioBuffer<float>& chunk, juce::int64 startSample, int numSamples)
+                                {
+                                    reader.read (&chunk, 0, numSamples, startSample, true, true);
+                                },
+                                std::move (shouldAbort));
+}
+
+
+// Computes the waveform summary of a decoded track, copying it out in chunks as a reader would
+std::shared_ptr<WaveformData> WaveformAnalyser::computeWaveformData (const juce::AudioBuffer<float>& audio, double sampleRate,
+                                                                      std::function<bool()> shouldAbort)
+{
+    auto numChannels = juce::jmin (2, audio.getNumChannels());
+
+    return computeWaveformData (sampleRate, audio.getNumSamples(), numChannels,
+                                [&audio, numChannels] (juce::AudioBuffer<float>& chunk, juce::int64 startSample, int numSamples)
+                                {
+                                    for (int ch = 0; ch < numChannels; ++ch)
+                                        chunk.copyFrom (ch, 0, audio, ch, static_cast<int> (startSample), numSamples);
+                                },
+                                std::move (shouldAbort));
+}
+
+
+/*
+    Computes the per-bin peak and band energies of a whole track.
+
+    Each bin is transformed with a Hann-windowed 1024 point FFT that spans the bin
+    and the one before it. The squared magnitudes are summed into three bands,
+    which are then normalised against the loudest bin of the track.
+
+    @param sampleRate        Sample rate of the track.
+    @param lengthInSamples   Length of the track.
+    @param numChannels       Channels to mix, one or two.
+    @param readChunk         Fills a chunk with the next part of the track.
+    @param shouldAbort       Polled between chunks, analysis stops early when it returns true.
+
+    @return                  The analysed data, or nullptr if the analysis was aborted.
+*/
+std::shared_ptr<WaveformData> WaveformAnalyser::computeWaveformData (double sampleRate, juce::int64 lengthInSamples, int numChannels,
+                                                                      ChunkReader readChunk, std::function<bool()> shouldAbort)
+{
+    constexpr int fftOrder = 10;
+    constexpr int fftSize = 1 << fftOrder;
+    constexpr int hop = WaveformData::samplesPerBin;
+    constexpr int history = fftSize - hop;
+    constexpr int binsPerChunk = 128;
+    constexpr int chunkSize = hop * binsPerChunk;
+
+    if (sampleRate <= 0.0 || lengthInSamples <= 0)
+        return nullptr;
+
+    auto data = std::make_shared<WaveformData>();
+    data->sampleRate = sampleRate;
+    data->lengthInSamples = lengthInSamples;
+
+    auto numBins = static_cast<int> ((lengthInSamples + hop - 1) / hop);
+    data->bins.resize (static_cast<size_t> (numBins));
+
+    std::vector<float> peaks (data->bins.size()), low (data->bins.size()), mid (data->bins.size()), high (data->bins.size());
+
+    // Band edges expressed as FFT bin indices
+    auto hzPerFftBin = sampleRate / fftSize;
+    auto lowEnd = juce::jlimit (2, fftSize / 2 - 1, juce::roundToInt (lowMidCrossoverHz / hzPerFftBin));
+    auto midEnd = juce::jlimit (lowEnd + 1, fftSize / 2, juce::roundToInt (midHighCrossoverHz / hzPerFftBin));
+
+    juce::dsp::FFT fft (fftOrder);
+    juce::dsp::WindowingFunction<float> window (fftSize, juce::dsp::WindowingFunction<float>::hann, false);
+    std::vector<float> fftData (2 * fftSize);
+
+    auto bandEnergy = [&fftData] (int start, int end)
+    {
+        return std::accumulate (fftData.begin() + start, fftData.begin() + end, 0.0f);
+    };
+
+    juce::AudioBuffer<float> chunk (numChannels, chunkSize);
+
+    // The tail of the previous chunk followed by the current chunk, mixed to mono
+    std::vector<float> mono (history + chunkSize, 0.0f);
+    auto* monoChunk = mono.data() + history;
+
+    int bin = 0;
+
+    for (juce::int64 pos = 0; pos < lengthInSamples && bin < numBins; pos += chunkSize)
+    {
+        if (shouldAbort())
+            return nullptr;
+
+        auto numToRead = static_cast<int> (juce::jmin<juce::int64> (chunkSize, lengthInSamples - pos));
+
+        chunk.clear();
+        readChunk (chunk, pos, numToRead);
+
+        juce::FloatVectorOperations::copyWithMultiply (monoChunk, chunk.getReadPointer (0), 1.0f / numChannels, chunkSize);
+
+        for (int ch = 1; ch < numChannels; ++ch)
+            juce::FloatVectorOperations::addWithMultiply (monoChunk, chunk.getReadPointer (ch), 1.0f / numChannels, chunkSize);
+
+        for (int start = 0; start < numToRead && bin < numBins; start += hop, ++bin)
+        {
+            peaks[(size_t) bin] = chunk.getMagnitude (start, juce::jmin (hop, numToRead - start));
+
+            // The window ends where this bin ends, so it spans this bin and the previous one
+            std::fill (fftData.begin(), fftData.end(), 0.0f);
+            juce::FloatVectorOperations::copy (fftData.data(), mono.data() + start, fftSize);
+
+            window.multiplyWithWindowingTable (fftData.data(), fftSize);
+            fft.performFrequencyOnlyForwardTransform (fftData.data());
+
+            // Turn magnitudes into energies
+            juce::FloatVectorOperations::multiply (fftData.data(), fftData.data(), fftSize / 2 + 1);
+
+            low [(size_t) bin] = std::sqrt (bandEnergy (1, lowEnd));
+            mid [(size_t) bin] = std::sqrt (bandEnergy (lowEnd, midEnd));
+            high[(size_t) bin] = std::sqrt (bandEnergy (midEnd, fftSize / 2 + 1));
+        }
+
+        // Keep the end of this chunk as the history of the next one
+        std::copy (mono.begin() + chunkSize, mono.end(), mono.begin());
+    }
+
+    auto& bins = data->bins;
+
+    for (size_t i = 0; i < bins.size(); ++i)
+        bins[i].peak = static_cast<juce::uint8> (juce::jlimit (0, 255, juce::roundToInt (peaks[i] * 255.0f)));
+
+    quantise (low,  [&bins] (size_t i, juce::uint8 v) { bins[i].low  = v; });
+    quantise (mid,  [&bins] (size_t i, juce::uint8 v) { bins[i].mid  = v; });
+    quantise (high, [&bins] (size_t i, juce::uint8 v) { bins[i].high = v; });
+
+    return data;
+}
@@ -0,0 +1,115 @@
+/*
+  ==============================================================================
+
+    WaveformAnalyser.h
+    Created: 19 Oct 2026 4:02:11pm
+    Author:  Justin  Lim
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/**
+    Frequency-coloured waveform summary of a track.
+
+    Every bin covers a fixed number of source samples and stores the peak level
+    plus the low, mid and high band energy, each quantised to a byte. This is the
+    structure the WaveformDisplay draws from, and it is cached on disk so a track
+    is only ever analysed once.
+*/
+struct WaveformData
+{
+    struct Bin
+    {
+        juce::uint8 peak = 0;
+        juce::uint8 low  = 0;
+        juce::uint8 mid  = 0;
+        juce::uint8 high = 0;
+    };
+
+    /** Number of source samples summarised by a single bin */
+    static constexpr int samplesPerBin = 512;
+
+    /** Returns the number of bins per second of audio */
+    double getBinsPerSecond() const;
+
+    /** Returns the length of the analysed track in seconds */
+    double getLengthInSeconds() const;
+
+    /** Combines the bins in [firstBin, lastBin) into one bin holding the maximum of each field */
+    Bin getMaximum (int firstBin, int lastBin) const;
+
+    /** Returns the display colour of a bin: lows in red, mids in green and highs in blue */
+    static juce::Colour getColourFor (const Bin& bin);
+
+    /** Writes the data to a binary cache file */
+    bool writeToFile (const juce::File& file) const;
+
+    /** Reads the data back from a binary cache file, returns nullptr if the file is missing or invalid */
+    static std::shared_ptr<WaveformData> readFromFile (const juce::File& file);
+
+    double sampleRate = 0.0;
+    juce::int64 lengthInSamples = 0;
+    std::vector<Bin> bins;
+};
+
+
+/**
+    Computes WaveformData on a background thread.
+
+    A load request replaces any analysis still in progress, so quickly loading
+    several tracks onto a deck only ever finishes the last one. Results are handed
+    back on the message thread.
+*/
+class WaveformAnalyser : private juce::Thread
+{
+public:
+    using Callback = std::function<void (std::shared_ptr<const WaveformData>)>;
+
+    WaveformAnalyser (juce::AudioFormatManager& formatManagerToUse);
+    ~WaveformAnalyser() override;
+
+    /** Analyses a file (or reads it from the cache) and calls onComplete on the message thread */
+    void analyse (const juce::File& audioFile, Callback onComplete);
+
+    /** Drops any pending or running request without calling its callback */
+    void cancel();
+
+    /** Returns the cache file used to persist the analysis of an audio file */
+    static juce::File getCacheFileFor (const juce::File& audioFile);
+
+    /** Computes the waveform summary of a whole track, returns nullptr if it was aborted or unreadable */
+    static std::shared_ptr<WaveformData> computeWaveformData (juce::AudioFormatReader& reader,
+                                                              std::function<bool()> shouldAbort);
+
+    /** Computes the waveform summary of a track that is already decoded, returns nullptr if it was aborted */
+    static std::shared_ptr<WaveformData> computeWaveformData (const juce::AudioBuffer<float>& audio, double sampleRate,
+                                                              std::function<bool()> shouldAbort);
+
+private:
+    // Fills a chunk with the samples starting at a position in the track
+    using ChunkReader = std::function<void (juce::AudioBuffer<float>& chunk, juce::int64 startSample, int numSamples)>;
+
+    // Computes the waveform summary from chunks handed over by readChunk, in order
+    static std::shared_ptr<WaveformData> computeWaveformData (double sampleRate, juce::int64 lengthInSamples, int numChannels,
+                                                              ChunkReader readChunk, std::function<bool()> shouldAbort);
+
+    void run() override;
+
+    // Returns true if a newer request has been made since the given one was started
+    bool isSuperseded (int requestId);
+
+    juce::AudioFormatManager& formatManager;
+
+    // Pending request, guarded by lock
+    juce::CriticalSection lock;
+    juce::File pendingFile;
+    Callback pendingCallback;
+    int latestRequestId = 0;
+    int handledRequestId = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (WaveformAnalyser)
+};
@@ -1,170 +1,284 @@
-/*
-  ==============================================================================
-
-    WaveformDisplay.cpp
-    Created: 4 Mar 2024 7:36:51pm
-    Author:  Justin  Lim
-
-  ==============================================================================
-*/
-
-#include <JuceHeader.h>
-#include "WaveformDisplay.h"
-
-WaveformDisplay::WaveformDisplay (DJAudioPlayer*       player,
-                                  juce::AudioFormatManager&  formatManagerToUse,
-                                  juce::AudioThumbnailCache& cacheToUse
-                                  ): fileLoaded(false),
-position(0),
-player(player),
-thumbnail(1000, formatManagerToUse, cacheToUse)
-{
-    // Audio thumbnail
-    thumbnail.addChangeListener(this);
-    
-    // Position marker
-    addAndMakeVisible (currentPositionMarker);
-    currentPositionMarker.setFill (juce::Colours::white.withAlpha (0.85f));
-}
-
-WaveformDisplay::~WaveformDisplay() {}
-
-// Added font on top of the starter code
-void WaveformDisplay::paint(juce::Graphics& g)
-{
-    // Clear the background
-    g.fillAll(getLookAndFeel().findColour(juce::ResizableWindow::backgroundColourId));
-
-    // Draw a grey outline around the component
-    g.setColour(juce::Colours::grey);
-    g.drawRect(getLocalBounds(), 1);
-
-    // Set the font for the waveform display
-    g.setFont(juce::Font("Verdana", 16.0f, juce::Font::bold));
-
-    // Set the colour of the waveform
-    g.setColour(juce::Colours::lightblue);
-
-    if (fileLoaded)
-    {
-        thumbnail.drawChannel(g, getLocalBounds(), 0, thumbnail.getTotalLength(), 0, 1.0f);
-        updateCursorPosition();
-    }
-    else
-    {
-        g.setFont(juce::Font("Verdana", 20.0f, juce::Font::bold));
-
-        g.drawFittedText("No audio file selected", getLocalBounds(), juce::Justification::centred, 2);
-    }
-}
-
-
-void WaveformDisplay::resized() {}
-
-
-// Added this function to change the listener call back
-// Repaints the UI when waveform display changes
-void WaveformDisplay::changeListenerCallback (ChangeBroadcaster* source)
-{
-    std::cout << "wfd: change received!" << std::endl;
-    
-    repaint();
-}
-
-
-// Loads an audio URL and reads the data
-void WaveformDisplay::loadURL(juce::URL audioURL)
-{
-    thumbnail.clear();
-
-    fileLoaded = thumbnail.setSource(new juce::URLInputSource(audioURL));
-
-    if (fileLoaded)
-    {
-        std::cout << "wfd: loaded!" << std::endl;
-
-        juce::Range<double> newRange(0.0, thumbnail.getTotalLength());
-
-        setRange(newRange);
-
-        repaint();
-    }
-    else
-    {
-        std::cout << "wfd: not loaded!" << std::endl;
-    }
-}
-
-
-// Added function on top of the starter code
-// Set the playhead position relative to the waveform
-void WaveformDisplay::setPositionRelative(double relativePosition)
-{
-    if (relativePosition != position && !std::isnan(relativePosition))
-    {
-        position = relativePosition;
-        repaint();
-    }
-}
-
-
-// Added function on top of the starter code
-// Set the visible range for the waveform display
-void WaveformDisplay::setRange(juce::Range<double> newRange)
-{
-    visibleRange = newRange;
-    updateCursorPosition();
-    repaint();
-}
-
-
-// Added function on top of the starter code
-void WaveformDisplay::mouseDown(const juce::MouseEvent& e)
-{
-    mouseDrag(e);
-}
-
-// Added function on top of the starter code
-void WaveformDisplay::mouseDrag(const juce::MouseEvent& e)
-{
-    player->setPosition(fmax(0.0, xToTime(static_cast<float>(e.x))));
-}
-
-// Added function on top of the starter code
-void WaveformDisplay::mouseUp(const juce::MouseEvent&)
-{
-    player->start();
-}
-
-// Added function on top of the starter code
-float WaveformDisplay::timeToX(const double time) const
-{
-    // Ensure a valid visible range to avoid division by zero
-    if (visibleRange.getLength() <= 0)
-        return 0;
-
-    // Calculate and return the X position relative to the visible range
-    return static_cast<float>(getWidth() * ((time - visibleRange.getStart()) / visibleRange.getLength()));
-}
-
-// Added function on top of the starter code
-double WaveformDisplay::xToTime(const float x) const
-{
-    // Calculate and return the time based on the X position and visible range
-    return (x / static_cast<float>(getWidth())) * visibleRange.getLength() + visibleRange.getStart();
-}
-
-// Added function on top of the starter code
-void WaveformDisplay::updateCursorPosition()
-{
-    // Calculate the X position based on the current playback position
-    float x = timeToX(player->getCurrentPosition());
-    float y = 0;
-    float width = 1.5f;
-    float height = static_cast<float>(getHeight());
-
-    // Set the visibility and position of the cursor marker
-    currentPositionMarker.setVisible(player->songIsPlaying || isMouseButtonDown());
-    currentPositionMarker.setRectangle(juce::Rectangle<float>(x, y, width, height));
-}
-
+/*
+  ==============================================================================
+
+    WaveformDisplay.cpp
+    Created: 4 Mar 2024 7:36:51pm
+    Author:  Justin  Lim
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "WaveformDisplay.h"
+#include "FrameProfiler.h"
+
+WaveformDisplay::WaveformDisplay (DJAudioPlayer*       player,
+                                  juce::AudioFormatManager&  formatManagerToUse,
+                                  juce::AudioThumbnailCache& cacheToUse
+                                  ): fileLoaded(false),
+position(0),
+player(player),
+thumbnail(1000, formatManagerToUse, cacheToUse),
+analyser(formatManagerToUse)
+{
+    // Audio thumbnail
+    thumbnail.addChangeListener(this);
+    
+    // Position marker
+    addAndMakeVisible (currentPositionMarker);
+    currentPositionMarker.setFill (juce::Colours::white.withAlpha (0.85f));
+}
+
+WaveformDisplay::~WaveformDisplay() {}
+
+// Added font on top of the starter code
+void WaveformDisplay::paint(juce::Graphics& g)
+{
+    FrameProfiler::ScopedSection section("WaveformDisplay::paint");
+
+    // Clear the background
+    g.fillAll(getLookAndFeel().findColour(juce::ResizableWindow::backgroundColourId));
+
+    // Draw a grey outline around the component
+    g.setColour(juce::Colours::grey);
+    g.drawRect(getLocalBounds(), 1);
+
+    // Set the colour of the waveform
+    g.setColour(juce::Colours::lightblue);
+
+    if (fileLoaded && waveformData != nullptr)
+    {
+        drawColouredWaveform(g, getLocalBounds());
+    }
+    else if (fileLoaded)
+    {
+        thumbnail.drawChannel(g, getLocalBounds(), 0, thumbnail.getTotalLength(), 0, 1.0f);
+    }
+    else
+    {
+        g.setFont(customisation.getFont(20.0f, true));
+
+        g.drawFittedText("No audio file selected", getLocalBounds(), juce::Justification::centred, 2);
+    }
+}
+
+
+// Keep the cursor on the playhead when the display changes size
+void WaveformDisplay::resized()
+{
+    updateCursorPosition();
+}
+
+
+/*
+    Draws one vertical line per pixel column, coloured by the band energy of the bins under it.
+    Low energy maps to red, mid to green and high to blue, so kicks show up red and hats blue.
+    Only the columns inside the clip region are drawn, so moving the cursor redraws just the strips it left and entered.
+
+    @param g       The graphics context for drawing.
+    @param area    The area to draw the waveform into.
+*/
+void WaveformDisplay::drawColouredWaveform(juce::Graphics& g, juce::Rectangle<int> area)
+{
+    auto binsPerSecond = waveformData->getBinsPerSecond();
+    auto centreY = static_cast<float>(area.getCentreY());
+    auto halfHeight = area.getHeight() * 0.5f;
+
+    auto columns = area.getIntersection(g.getClipBounds());
+
+    for (int x = columns.getX(); x < columns.getRight(); ++x)
+    {
+        auto firstBin = static_cast<int>(xToTime(static_cast<float>(x)) * binsPerSecond);
+        auto lastBin  = static_cast<int>(xToTime(static_cast<float>(x + 1)) * binsPerSecond);
+
+        // Combine the bins that fall into this pixel column
+        auto column = waveformData->getMaximum(firstBin, juce::jmax(lastBin, firstBin + 1));
+
+        g.setColour(WaveformData::getColourFor(column));
+
+        auto lineHeight = halfHeight * column.peak / 255.0f;
+        g.drawVerticalLine(x, centreY - lineHeight, centreY + lineHeight);
+    }
+}
+
+
+// Added this function to change the listener call back
+// Repaints the UI when waveform display changes
+void WaveformDisplay::changeListenerCallback (ChangeBroadcaster* source)
+{
+    // Counted by the profiler rather than logged, the thumbnail changes many times while it loads
+    if (FrameProfiler::isEnabled())
+        FrameProfiler::getInstance()->addEvent("WaveformDisplay::changeListenerCallback");
+    
+    repaint();
+}
+
+
+// Loads an audio URL and reads the data
+void WaveformDisplay::loadURL(juce::URL audioURL)
+{
+    thumbnail.clear();
+    waveformData = nullptr;
+    loadedFile = audioURL.isLocalFile() ? audioURL.getLocalFile() : juce::File();
+    sendChangeMessage();
+
+    fileLoaded = thumbnail.setSource(new juce::URLInputSource(audioURL));
+
+    analyseLoadedFile();
+
+    if (fileLoaded)
+    {
+        DBG("WaveformDisplay::loadURL loaded " << audioURL.toString(false));
+
+        juce::Range<double> newRange(0.0, thumbnail.getTotalLength());
+
+        setRange(newRange);
+
+        repaint();
+    }
+    else
+    {
+        DBG("WaveformDisplay::loadURL could not load " << audioURL.toString(false));
+    }
+}
+
+
+// Draws a preloaded track from the waveform the preloader summarised with it, without reading or scanning the audio here
+void WaveformDisplay::loadPreloaded(const PreloadedTrack& track)
+{
+    if (track.waveformData == nullptr)
+    {
+        loadURL(juce::URL(track.file));
+        return;
+    }
+
+    thumbnail.clear();
+    analyser.cancel();
+    waveformData = track.waveformData;
+    loadedFile = track.file;
+    fileLoaded = true;
+
+    setRange(juce::Range<double>(0.0, waveformData->getLengthInSeconds()));
+    repaint();
+
+    // Let views that share this data (such as the zoomed strip) pick it up
+    sendChangeMessage();
+}
+
+
+// Compute (or read back from the cache) the frequency-coloured waveform of the loaded file in the background
+void WaveformDisplay::analyseLoadedFile()
+{
+    if (fileLoaded && loadedFile.existsAsFile())
+    {
+        juce::Component::SafePointer<WaveformDisplay> safeThis (this);
+        auto file = loadedFile;
+
+        analyser.analyse(file, [safeThis, file] (std::shared_ptr<const WaveformData> data)
+        {
+            if (safeThis != nullptr)
+                safeThis->waveformDataReady(file, data);
+        });
+    }
+    else
+    {
+        analyser.cancel();
+    }
+}
+
+
+// Receives the background analysis result, ignoring results for a file that is no longer loaded
+void WaveformDisplay::waveformDataReady(const juce::File& file, std::shared_ptr<const WaveformData> data)
+{
+    if (file != loadedFile || data == nullptr)
+        return;
+
+    waveformData = data;
+    repaint();
+
+    // Let views that share this data (such as the zoomed strip) pick it up
+    sendChangeMessage();
+}
+
+
+// Returns the frequency-coloured summary of the loaded track
+std::shared_ptr<const WaveformData> WaveformDisplay::getWaveformData() const
+{
+    return waveformData;
+}
+
+
+// Added function on top of the starter code
+// Set the playhead position relative to the waveform
+// Only the cursor moves, which repaints the strips it leaves and enters rather than the whole overview
+void WaveformDisplay::setPositionRelative(double relativePosition)
+{
+    position = relativePosition;
+    updateCursorPosition();
+}
+
+
+// Added function on top of the starter code
+// Set the visible range for the waveform display
+void WaveformDisplay::setRange(juce::Range<double> newRange)
+{
+    visibleRange = newRange;
+    updateCursorPosition();
+    repaint();
+}
+
+
+// Added function on top of the starter code
+void WaveformDisplay::mouseDown(const juce::MouseEvent& e)
+{
+    mouseDrag(e);
+}
+
+// Added function on top of the starter code
+void WaveformDisplay::mouseDrag(const juce::MouseEvent& e)
+{
+    player->setPosition(fmax(0.0, xToTime(static_cast<float>(e.x))));
+}
+
+// Added function on top of the starter code
+void WaveformDisplay::mouseUp(const juce::MouseEvent&)
+{
+    player->start();
+}
+
+// Added function on top of the starter code
+float WaveformDisplay::timeToX(const double time) const
+{
+    // Ensure a valid visible range to avoid division by zero
+    if (visibleRange.getLength() <= 0)
+        return 0;
+
+    // Calculate and return the X position relative to the visible range
+    return static_cast<float>(getWidth() * ((time - visibleRange.getStart()) / visibleRange.getLength()));
+}
+
+// Added function on top of the starter code
+double WaveformDisplay::xToTime(const float x) const
+{
+    // Calculate and return the time based on the X position and visible range
+    return (x / static_cast<float>(getWidth())) * visibleRange.getLength() + visibleRange.getStart();
+}
+
+// Added function on top of the starter code
+void WaveformDisplay::updateCursorPosition()
+{
+    // Calculate the X position based on the current playback position
+    float x = timeToX(player->getCurrentPosition());
+    float y = 0;
+    float width = 1.5f;
+    float height = static_cast<float>(getHeight());
+
+    // Set the visibility and position of the cursor marker, leaving it alone when nothing changed so it does not repaint
+    juce::Parallelogram<float> rectangle(juce::Rectangle<float>(x, y, width, height));
+
+    currentPositionMarker.setVisible(player->songIsPlaying || isMouseButtonDown());
+
+    if (currentPositionMarker.getRectangle() != rectangle)
+        currentPositionMarker.setRectangle(rectangle);
+}
+
@@ -0,0 +1,184 @@
+/*
+  ==============================================================================
+
+    ZoomedWaveformDisplay.cpp
+    Created: 19 Oct 2026 5:11:40pm
+    Author:  Justin  Lim
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "ZoomedWaveformDisplay.h"
+#include "FrameProfiler.h"
+
+namespace
+{
+    // Integer division that rounds towards negative infinity
+    juce::int64 floorDiv (juce::int64 value, juce::int64 divisor)
+    {
+        auto quotient = value / divisor;
+        return (value % divisor != 0 && (value < 0) != (divisor < 0)) ? quotient - 1 : quotient;
+    }
+}
+
+ZoomedWaveformDisplay::ZoomedWaveformDisplay (DJAudioPlayer* _player, WaveformDisplay& _overview, RefreshScheduler& _refreshScheduler)
+    : player (_player),
+      overview (_overview),
+      refreshScheduler (_refreshScheduler)
+{
+    overview.addChangeListener (this);
+    
+    refreshScheduler.addClient (this);
+}
+
+ZoomedWaveformDisplay::~ZoomedWaveformDisplay()
+{
+    refreshScheduler.removeClient (this);
+    overview.removeChangeListener (this);
+}
+
+
+// Blits the tiles around the playhead and draws the playhead in the centre
+void ZoomedWaveformDisplay::paint (juce::Graphics& g)
+{
+    FrameProfiler::ScopedSection section ("ZoomedWaveformDisplay::paint");
+    
+    g.fillAll (juce::Colours::black);
+    
+    g.setColour (juce::Colours::grey);
+    g.drawRect (getLocalBounds(), 1);
+    
+    if (waveformData == nullptr || tiles.empty())
+        return;
+    
+    auto playheadX = static_cast<juce::int64> (player -> getCurrentPosition() * pixelsPerSecond);
+    auto centreX = getWidth() / 2;
+    auto leftEdge = playheadX - centreX;
+    
+    auto lastTrackTile = static_cast<juce::int64> (waveformData -> getLengthInSeconds() * pixelsPerSecond) / tileWidth;
+    auto firstTile = juce::jmax<juce::int64> (0, floorDiv (leftEdge, tileWidth));
+    auto lastTile  = juce::jmin (lastTrackTile, floorDiv (leftEdge + getWidth() - 1, tileWidth));
+    
+    for (auto index = firstTile; index <= lastTile; ++index)
+        g.drawImageAt (getTile (index).image, static_cast<int> (index * tileWidth - leftEdge), 0);
+    
+    lastPlayheadX = playheadX;
+    
+    // Playhead
+    g.setColour (juce::Colours::white.withAlpha (0.85f));
+    g.fillRect (centreX - 1, 0, 2, getHeight());
+}
+
+
+// Resizes the tile ring so the visible tiles never evict each other
+void ZoomedWaveformDisplay::resized()
+{
+    tiles.clear();
+    
+    if (getWidth() > 0 && getHeight() > 0)
+        tiles.resize (static_cast<size_t> (getWidth() / tileWidth + 3));
+}
+
+
+// Picks up new waveform data from the overview
+void ZoomedWaveformDisplay::changeListenerCallback (juce::ChangeBroadcaster* source)
+{
+    waveformData = overview.getWaveformData();
+    invalidateTiles();
+    repaint();
+}
+
+
+// Only repaint when the playhead has moved by at least one pixel
+bool ZoomedWaveformDisplay::needsRefresh()
+{
+    if (waveformData == nullptr)
+        return false;
+    
+    return static_cast<juce::int64> (player -> getCurrentPosition() * pixelsPerSecond) != lastPlayheadX;
+}
+
+
+// Scrolls the strip to the playhead, paint picks up the new position
+void ZoomedWaveformDisplay::refreshDisplay()
+{
+    repaint();
+}
+
+
+// Zooms in and out with the mouse wheel
+void ZoomedWaveformDisplay::mouseWheelMove (const juce::MouseEvent&, const juce::MouseWheelDetails& wheel)
+{
+    if (wheel.deltaY != 0.0f)
+        setPixelsPerSecond (pixelsPerSecond * (wheel.deltaY > 0.0f ? 1.25 : 0.8));
+}
+
+
+// Set how many pixels a second of audio takes up
+void ZoomedWaveformDisplay::setPixelsPerSecond (double newPixelsPerSecond)
+{
+    newPixelsPerSecond = juce::jlimit (20.0, 1000.0, newPixelsPerSecond);
+    
+    if (newPixelsPerSecond != pixelsPerSecond)
+    {
+        pixelsPerSecond = newPixelsPerSecond;
+        invalidateTiles();
+        repaint();
+    }
+}
+
+
+// Returns the rendered tile for a tile index, rendering it into its ring slot if needed
+const ZoomedWaveformDisplay::Tile& ZoomedWaveformDisplay::getTile (juce::int64 index)
+{
+    auto numTiles = static_cast<juce::int64> (tiles.size());
+    auto& tile = tiles[static_cast<size_t> (((index % numTiles) + numTiles) % numTiles)];
+    
+    if (tile.index != index)
+        renderTile (tile, index);
+    
+    return tile;
+}
+
+
+// Renders one tile's slice of the waveform, one vertical line per pixel column
+void ZoomedWaveformDisplay::renderTile (Tile& tile, juce::int64 index)
+{
+    if (tile.image.getWidth() != tileWidth || tile.image.getHeight() != getHeight())
+        tile.image = juce::Image (juce::Image::ARGB, tileWidth, getHeight(), true);
+    else
+        tile.image.clear (tile.image.getBounds());
+    
+    juce::Graphics g (tile.image);
+    
+    auto binsPerPixel = waveformData -> getBinsPerSecond() / pixelsPerSecond;
+    auto centreY = getHeight() * 0.5f;
+    
+    for (int x = 0; x < tileWidth; ++x)
+    {
+        auto pixel = index * tileWidth + x;
+        auto firstBin = static_cast<int> (pixel * binsPerPixel);
+        auto lastBin  = static_cast<int> ((pixel + 1) * binsPerPixel);
+        
+        auto column = waveformData -> getMaximum (firstBin, juce::jmax (lastBin, firstBin + 1));
+        
+        if (column.peak == 0)
+            continue;
+        
+        auto lineHeight = centreY * column.peak / 255.0f;
+        
+        g.setColour (WaveformData::getColourFor (column));
+        g.drawVerticalLine (x, centreY - lineHeight, centreY + lineHeight);
+    }
+    
+    tile.index = index;
+}
+
+
+// Marks every tile as needing a redraw
+void ZoomedWaveformDisplay::invalidateTiles()
+{
+    for (auto& tile : tiles)
+        tile.index = invalidTile;
+}
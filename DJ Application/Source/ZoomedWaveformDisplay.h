@@ -0,0 +1,87 @@
+/*
+  ==============================================================================
+
+    ZoomedWaveformDisplay.h
+    Created: 19 Oct 2026 5:11:40pm
+    Author:  Justin  Lim
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "DJAudioPlayer.h"
+#include "WaveformDisplay.h"
+#include "RefreshScheduler.h"
+
+/**
+    A zoomed waveform strip that scrolls with the playhead, which stays in the centre.
+
+    The strip is drawn from a ring of pre-rendered image tiles. Only the tiles that
+    scroll into view are rendered, so the per-frame cost is a handful of blits no
+    matter how long the track is or how far it is zoomed in.
+*/
+class ZoomedWaveformDisplay : public juce::Component,
+public juce::ChangeListener,
+public RefreshScheduler::Client
+{
+public:
+    ZoomedWaveformDisplay (DJAudioPlayer* player, WaveformDisplay& overview, RefreshScheduler& refreshScheduler);
+    ~ZoomedWaveformDisplay() override;
+    
+    void paint (juce::Graphics&) override;
+    void resized() override;
+    
+    /** Picks up new waveform data from the overview */
+    void changeListenerCallback (juce::ChangeBroadcaster* source) override;
+    
+    /** Returns true when the playhead has moved by at least one pixel */
+    bool needsRefresh() override;
+    
+    /** Scrolls the strip to the playhead */
+    void refreshDisplay() override;
+    
+    /** Zooms in and out with the mouse wheel */
+    void mouseWheelMove (const juce::MouseEvent&, const juce::MouseWheelDetails& wheel) override;
+    
+    /** Set how many pixels a second of audio takes up */
+    void setPixelsPerSecond (double newPixelsPerSecond);
+    
+private:
+    static constexpr int tileWidth = 256;
+    static constexpr juce::int64 invalidTile = std::numeric_limits<juce::int64>::min();
+    
+    struct Tile
+    {
+        juce::Image image;
+        juce::int64 index = invalidTile;
+    };
+    
+    /** Returns the rendered tile for a tile index, rendering it into its ring slot if needed */
+    const Tile& getTile (juce::int64 index);
+    
+    /** Renders a tile's slice of the waveform */
+    void renderTile (Tile& tile, juce::int64 index);
+    
+    /** Marks every tile as needing a redraw */
+    void invalidateTiles();
+    
+    // Point to DJAudioPlayer
+    DJAudioPlayer* player;
+    
+    // The overview that owns the waveform data
+    WaveformDisplay& overview;
+    std::shared_ptr<const WaveformData> waveformData;
+    
+    // Scrolls the strip once per frame while the playhead moves
+    RefreshScheduler& refreshScheduler;
+    
+    // Ring of pre-rendered tiles, indexed by tile index modulo its size
+    std::vector<Tile> tiles;
+    
+    double pixelsPerSecond = 150.0;
+    juce::int64 lastPlayheadX = invalidTile;
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ZoomedWaveformDisplay)
+};